@@ -10,6 +10,15 @@ double double_integral(double (*func)(double,double),
 
 double intergal(double (*func)(double), double a, double b);
 
+/**
+ * @brief Parallel versions of intergal / double_integral (same dx = dy = 0.0001 grid,
+ * left Riemann sum). Results are bitwise identical at any thread count (0 = default).
+ */
+double intergal_parallel(double (*func)(double), double a, double b, unsigned int threads);
+
+double double_integral_parallel(double (*func)(double,double),
+                                double a, double b, double c, double d, unsigned int threads);
+
 double derivative(int var, double (function)(double,double), double x, double y);
 
 double L(double (*target)(double,double), double (*constraint)(double,double),
@@ -1,4 +1,5 @@
 #include "calculus.h"
+#include "reduce.h"
 
 double intergal(double (*func)(double), double a, double b){
     double dx = 0.0001, res = 0.0;
@@ -15,4 +16,46 @@ double double_integral(double (*func)(double,double),
         }
 
         return res;
-   }
\ No newline at end of file
+   }
+
+// --- Parallel, reproducible integrators ---
+
+typedef struct {
+    double (*f1)(double);
+    double (*f2)(double,double);
+    double a, c, dx, dy;
+    size_t ny;
+} IntegralTerms;
+
+static double riemann_term(size_t i, void *ctx){
+    IntegralTerms *t = (IntegralTerms *)ctx;
+    return t->f1(t->a + (double)i * t->dx) * t->dx;
+}
+
+static double riemann_term_2d(size_t i, void *ctx){
+    IntegralTerms *t = (IntegralTerms *)ctx;
+    double x = t->a + (double)(i / t->ny) * t->dx;
+    double y = t->c + (double)(i % t->ny) * t->dy;
+    return t->f2(x, y) * (t->dx * t->dy);
+}
+
+// Number of grid steps in [lo, hi): ceil((hi - lo) / step)
+static size_t grid_steps(double lo, double hi, double step){
+    if (!(hi > lo)) return 0;
+    return (size_t)ceil((hi - lo) / step);
+}
+
+double intergal_parallel(double (*func)(double), double a, double b, unsigned int threads){
+    if (!func) return 0.0;
+    IntegralTerms t = {func, NULL, a, 0.0, 0.0001, 0.0, 0};
+    return reproducible_reduce(grid_steps(a, b, t.dx), riemann_term, &t, threads);
+}
+
+double double_integral_parallel(double (*func)(double,double),
+                                double a, double b, double c, double d, unsigned int threads){
+    if (!func) return 0.0;
+    IntegralTerms t = {NULL, func, a, c, 0.0001, 0.0001, 0};
+    t.ny = grid_steps(c, d, t.dy);
+    if (t.ny == 0) return 0.0;
+    return reproducible_reduce(grid_steps(a, b, t.dx) * t.ny, riemann_term_2d, &t, threads);
+}
@@ -0,0 +1,428 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "csvCache.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#define BYTE_ORDER_MARK 0x01020304u
+
+// The header is exactly 128 bytes on every ABI we build for
+typedef char header_size_check[(sizeof(CsvCacheHeader) == 128) ? 1 : -1];
+typedef char column_size_check[(sizeof(CsvCacheColumn) == 16) ? 1 : -1];
+
+// --- Checksum ---
+
+// Word-at-a-time multiply/xorshift hash; fast enough to verify at memory speed
+typedef struct {
+    uint64_t h;
+    unsigned char tail[8];
+    size_t tail_len;
+    uint64_t total;
+} CacheHash;
+
+static void hash_init(CacheHash *s) {
+    s->h = 0x9E3779B97F4A7C15ull;
+    s->tail_len = 0;
+    s->total = 0;
+}
+
+static uint64_t hash_word(uint64_t h, uint64_t w) {
+    h ^= w;
+    h *= 0xFF51AFD7ED558CCDull;
+    return h ^ (h >> 32);
+}
+
+static void hash_update(CacheHash *s, const void *data, size_t n) {
+    const unsigned char *p = (const unsigned char *)data;
+    s->total += n;
+
+    while (s->tail_len > 0 && n > 0) {
+        s->tail[s->tail_len++] = *p++;
+        n--;
+        if (s->tail_len == 8) {
+            uint64_t w;
+            memcpy(&w, s->tail, 8);
+            s->h = hash_word(s->h, w);
+            s->tail_len = 0;
+        }
+    }
+    for (; n >= 8; p += 8, n -= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        s->h = hash_word(s->h, w);
+    }
+    if (n > 0) {
+        memcpy(s->tail, p, n); // Only reached with an empty tail
+        s->tail_len = n;
+    }
+}
+
+static uint64_t hash_final(CacheHash *s) {
+    uint64_t h = s->h;
+    if (s->tail_len > 0) {
+        uint64_t w = 0;
+        memcpy(&w, s->tail, s->tail_len);
+        h = hash_word(h, w);
+    }
+    return hash_word(h, s->total);
+}
+
+// --- Writing ---
+
+typedef struct {
+    FILE *f;
+    CacheHash hash;
+    uint64_t pos;
+    bool failed;
+} CacheWriter;
+
+static void emit(CacheWriter *w, const void *data, size_t n) {
+    if (w->failed || n == 0) return;
+    if (fwrite(data, 1, n, w->f) != n) { w->failed = true; return; }
+    hash_update(&w->hash, data, n);
+    w->pos += n;
+}
+
+static void pad_to(CacheWriter *w, uint64_t align) {
+    static const char zeros[CSV_CACHE_ALIGN] = {0};
+    uint64_t rem = w->pos % align;
+    if (rem) emit(w, zeros, (size_t)(align - rem));
+}
+
+static uint64_t align_up(uint64_t x, uint64_t a) {
+    return (x + a - 1) / a * a;
+}
+
+char *csv_cache_default_path(const char *csv_path) {
+    if (!csv_path) return NULL;
+    size_t len = strlen(csv_path);
+    char *path = malloc(len + sizeof(CSV_CACHE_SUFFIX));
+    if (!path) return NULL;
+    memcpy(path, csv_path, len);
+    memcpy(path + len, CSV_CACHE_SUFFIX, sizeof(CSV_CACHE_SUFFIX));
+    return path;
+}
+
+static bool write_payload(CacheWriter *w, const CsvTable *t, CsvColumnType type) {
+    size_t elem = (type == CSV_COL_F32) ? sizeof(float) : sizeof(double);
+
+    // Layout: descriptors, names, error lines, then aligned columns
+    uint64_t pos = sizeof(CsvCacheHeader) + t->cols * sizeof(CsvCacheColumn);
+    for (size_t c = 0; t->names && c < t->cols; c++) pos += strlen(t->names[c] ? t->names[c] : "") + 1;
+    pos = align_up(pos, 8) + t->error_count * sizeof(int64_t);
+
+    for (size_t c = 0; c < t->cols; c++) {
+        const char *name = (t->names && t->names[c]) ? t->names[c] : "";
+        CsvCacheColumn d;
+        pos = align_up(pos, CSV_CACHE_ALIGN);
+        d.type = (uint32_t)type;
+        d.name_len = t->names ? (uint32_t)strlen(name) : 0;
+        d.offset = pos;
+        pos += t->rows * elem;
+        emit(w, &d, sizeof(d));
+    }
+    for (size_t c = 0; t->names && c < t->cols; c++) {
+        const char *name = t->names[c] ? t->names[c] : "";
+        emit(w, name, strlen(name) + 1);
+    }
+    pad_to(w, 8);
+    for (size_t e = 0; e < t->error_count; e++) {
+        int64_t line = t->error_lines[e];
+        emit(w, &line, sizeof(line));
+    }
+
+    float block[1024];
+    for (size_t c = 0; c < t->cols; c++) {
+        pad_to(w, CSV_CACHE_ALIGN);
+        if (type == CSV_COL_F64) {
+            emit(w, t->columns[c], t->rows * sizeof(double));
+            continue;
+        }
+        for (size_t r = 0; r < t->rows; r += 1024) {
+            size_t n = (t->rows - r < 1024) ? t->rows - r : 1024;
+            for (size_t i = 0; i < n; i++) block[i] = (float)t->columns[c][r + i];
+            emit(w, block, n * sizeof(float));
+        }
+    }
+    return !w->failed;
+}
+
+bool csv_cache_write(const CsvTable *table, const char *cache_path, CsvColumnType type,
+                     const CsvParseOptions *opts, const struct stat *source) {
+    if (!table || !cache_path || (type != CSV_COL_F64 && type != CSV_COL_F32)) return false;
+    CsvParseOptions o = opts ? *opts : csv_default_options();
+
+    size_t len = strlen(cache_path);
+    char *tmp = malloc(len + 5);
+    if (!tmp) return false;
+    memcpy(tmp, cache_path, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    CacheWriter w;
+    memset(&w, 0, sizeof(w));
+    w.f = fopen(tmp, "wb");
+    if (!w.f) {
+        perror("Error creating cache file");
+        free(tmp);
+        return false;
+    }
+
+    CsvCacheHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CSV_CACHE_MAGIC, sizeof(CSV_CACHE_MAGIC));
+    h.version = CSV_CACHE_VERSION;
+    h.byte_order = BYTE_ORDER_MARK;
+    h.rows = table->rows;
+    h.cols = table->cols;
+    h.error_count = table->error_count;
+    if (source) {
+        h.source_size = (uint64_t)source->st_size;
+        h.source_mtime_sec = (int64_t)source->st_mtim.tv_sec;
+        h.source_mtime_nsec = (uint32_t)source->st_mtim.tv_nsec;
+        h.source_inode = (uint64_t)source->st_ino;
+    }
+    h.max_cols = o.max_cols;
+    h.delimiter = o.delimiter ? o.delimiter : ',';
+    h.has_header = o.has_header;
+    h.projected = (o.columns && o.column_count) ? 1 : 0;
+
+    // Placeholder header, then the payload, then the real header
+    bool ok = fwrite(&h, sizeof(h), 1, w.f) == 1;
+    w.pos = sizeof(h);
+    hash_init(&w.hash);
+    ok = ok && write_payload(&w, table, type);
+    if (ok) {
+        h.payload_size = w.pos - sizeof(h);
+        h.checksum = hash_final(&w.hash);
+        ok = fseek(w.f, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, w.f) == 1;
+    }
+    if (fclose(w.f) != 0) ok = false;
+
+    // Readers only ever see a complete file
+    if (ok && rename(tmp, cache_path) != 0) ok = false;
+    if (!ok) remove(tmp);
+    free(tmp);
+    return ok;
+}
+
+bool csv_cache_convert(const char *csv_path, const char *cache_path,
+                       const CsvParseOptions *opts, CsvColumnType type) {
+    if (!csv_path) return false;
+    struct stat st;
+    if (stat(csv_path, &st) != 0) {
+        perror("Error opening CSV file");
+        return false;
+    }
+
+    CsvTable *t = csv_parse_parallel(csv_path, opts);
+    if (!t) return false;
+
+    char *path = cache_path ? NULL : csv_cache_default_path(csv_path);
+    bool ok = csv_cache_write(t, cache_path ? cache_path : path, type, opts, &st);
+    free(path);
+    csv_table_free(t);
+    return ok;
+}
+
+// --- Loading ---
+
+static bool header_valid(const CsvCacheHeader *h, size_t file_size) {
+    return memcmp(h->magic, CSV_CACHE_MAGIC, sizeof(CSV_CACHE_MAGIC)) == 0
+        && h->version == CSV_CACHE_VERSION
+        && h->byte_order == BYTE_ORDER_MARK
+        && h->payload_size == file_size - sizeof(CsvCacheHeader)
+        && h->cols <= (file_size - sizeof(CsvCacheHeader)) / sizeof(CsvCacheColumn)
+        && h->error_count <= file_size / sizeof(int64_t);
+}
+
+CsvTable *csv_cache_load(const char *cache_path, bool verify) {
+    CsvMap *map = csv_map_open(cache_path);
+    if (!map) return NULL;
+
+    const char *base = map->data;
+    size_t size = map->size;
+    CsvCacheHeader h;
+    if (size < sizeof(h)) { csv_map_close(map); return NULL; }
+    memcpy(&h, base, sizeof(h));
+    if (!header_valid(&h, size)) { csv_map_close(map); return NULL; }
+
+    if (verify) {
+        CacheHash s;
+        hash_init(&s);
+        hash_update(&s, base + sizeof(h), size - sizeof(h));
+        if (hash_final(&s) != h.checksum) {
+            fprintf(stderr, "Warning: Cache file %s is corrupt, ignoring it.\n", cache_path);
+            csv_map_close(map);
+            return NULL;
+        }
+    }
+
+    CsvTable *t = calloc(1, sizeof(CsvTable));
+    if (!t) { csv_map_close(map); return NULL; }
+    t->map = map;
+    t->rows = h.rows;
+    t->cols = h.cols;
+    t->error_count = h.error_count;
+
+    const CsvCacheColumn *desc = (const CsvCacheColumn *)(base + sizeof(h));
+    const char *names = (const char *)(desc + h.cols);
+    const char *end = base + size;
+    size_t widened = 0;
+    bool ok = (t->columns = malloc(sizeof(double *) * (h.cols ? h.cols : 1))) != NULL;
+
+    // Names (only stored when the source had a header)
+    const char *p = names;
+    if (ok && h.has_header) ok = (t->names = calloc(h.cols ? h.cols : 1, sizeof(char *))) != NULL;
+    for (size_t c = 0; ok && h.has_header && c < h.cols; c++) {
+        ok = desc[c].name_len < (size_t)(end - p) && p[desc[c].name_len] == '\0';
+        if (ok) t->names[c] = (char *)p;
+        if (ok) p += desc[c].name_len + 1;
+    }
+
+    // Error lines follow the names, 8-byte aligned
+    if (ok) {
+        size_t at = (size_t)align_up((uint64_t)(p - base), 8);
+        ok = at + h.error_count * sizeof(int64_t) <= size;
+        if (ok && h.error_count) ok = (t->error_lines = malloc(sizeof(long) * h.error_count)) != NULL;
+        for (size_t e = 0; ok && e < h.error_count; e++) {
+            int64_t line;
+            memcpy(&line, base + at + e * sizeof(int64_t), sizeof(line));
+            t->error_lines[e] = (long)line;
+        }
+    }
+
+    // Columns: bounds and alignment, then point into the mapping
+    for (size_t c = 0; ok && c < h.cols; c++) {
+        size_t elem = (desc[c].type == CSV_COL_F32) ? sizeof(float) : sizeof(double);
+        ok = (desc[c].type == CSV_COL_F64 || desc[c].type == CSV_COL_F32)
+          && desc[c].offset % CSV_CACHE_ALIGN == 0 && desc[c].offset <= size
+          && h.rows <= (size - desc[c].offset) / elem;
+        if (desc[c].type == CSV_COL_F32) widened++;
+    }
+    if (ok && widened) ok = (t->storage = malloc(sizeof(double) * widened * (h.rows ? h.rows : 1))) != NULL;
+
+    double *wide = (double *)t->storage;
+    for (size_t c = 0; ok && c < h.cols; c++) {
+        if (desc[c].type == CSV_COL_F64) {
+            t->columns[c] = (double *)(base + desc[c].offset);
+            continue;
+        }
+        const float *src = (const float *)(base + desc[c].offset);
+        for (size_t r = 0; r < h.rows; r++) wide[r] = src[r];
+        t->columns[c] = wide;
+        wide += h.rows;
+    }
+
+    if (!ok) {
+        fprintf(stderr, "Warning: Cache file %s is malformed, ignoring it.\n", cache_path);
+        csv_table_free(t);
+        return NULL;
+    }
+    return t;
+}
+
+static bool same_name(const char *a, const char *b) {
+    for (; *a && *b; a++, b++) {
+        if (tolower((unsigned char)*a) != tolower((unsigned char)*b)) return false;
+    }
+    return *a == *b;
+}
+
+// A cache built with other options is still exact when it read every column
+// without skipping rows: any subset of its columns is then the same parse.
+static bool options_match(const CsvCacheHeader *h, const CsvParseOptions *o, const CsvTable *t) {
+    int delim = o->delimiter ? o->delimiter : ',';
+    if (h->delimiter != delim || (h->has_header != 0) != o->has_header) return false;
+
+    bool cache_all = !h->projected && (h->max_cols == 0 || h->max_cols > h->cols);
+    if (o->columns && o->column_count) {
+        if (!h->projected) return cache_all && h->error_count == 0 && t->names;
+        if (h->cols != o->column_count) return false;
+        for (size_t c = 0; c < h->cols; c++) {
+            if (!same_name(t->names[c], o->columns[c])) return false;
+        }
+        return true;
+    }
+    if (h->projected) return false;
+
+    if (o->max_cols == 0) return cache_all;
+    if (h->max_cols == o->max_cols || (cache_all && h->cols <= o->max_cols)) return true;
+    return h->error_count == 0 && cache_all && h->cols >= o->max_cols;
+}
+
+// Narrows a cache table to the named columns, in the requested order
+static bool select_columns(CsvTable *t, const char *const names[], size_t count) {
+    double **cols = malloc(sizeof(double *) * count);
+    char **picked = malloc(sizeof(char *) * count);
+    bool ok = cols && picked;
+
+    for (size_t i = 0; ok && i < count; i++) {
+        ok = false;
+        for (size_t c = 0; c < t->cols; c++) {
+            if (same_name(t->names[c], names[i])) {
+                cols[i] = t->columns[c];
+                picked[i] = t->names[c];
+                ok = true;
+                break;
+            }
+        }
+    }
+    if (!ok) {
+        free(cols);
+        free(picked);
+        return false;
+    }
+    free(t->columns);
+    free(t->names);
+    t->columns = cols;
+    t->names = picked;
+    t->cols = count;
+    return true;
+}
+
+// An edit that keeps the size still moves the mtime; a replaced file has a new inode
+static bool source_match(const CsvCacheHeader *h, const struct stat *st) {
+    return h->source_size == (uint64_t)st->st_size
+        && h->source_mtime_sec == (int64_t)st->st_mtim.tv_sec
+        && h->source_mtime_nsec == (uint32_t)st->st_mtim.tv_nsec
+        && h->source_inode == (uint64_t)st->st_ino;
+}
+
+static bool has_f32_column(const CsvTable *t) {
+    const CsvCacheColumn *desc = (const CsvCacheColumn *)(t->map->data + sizeof(CsvCacheHeader));
+    for (size_t c = 0; c < t->cols; c++) {
+        if (desc[c].type == CSV_COL_F32) return true;
+    }
+    return false;
+}
+
+CsvTable *csv_cache_load_fresh(const char *csv_path, const CsvParseOptions *opts, bool allow_f32) {
+    CsvParseOptions o = opts ? *opts : csv_default_options();
+    char *path = csv_cache_default_path(csv_path);
+    if (!path) return NULL;
+
+    struct stat csv_st;
+    CsvTable *t = NULL;
+    if (stat(csv_path, &csv_st) == 0) t = csv_cache_load(path, false);
+    free(path);
+    if (!t) return NULL;
+
+    CsvCacheHeader h;
+    memcpy(&h, t->map->data, sizeof(h));
+    bool ok = source_match(&h, &csv_st) && (allow_f32 || !has_f32_column(t)) && options_match(&h, &o, t);
+    if (ok && o.columns && o.column_count && !h.projected) ok = select_columns(t, o.columns, o.column_count);
+    else if (ok && o.max_cols && o.max_cols < t->cols) t->cols = o.max_cols;
+    if (!ok) {
+        csv_table_free(t);
+        return NULL;
+    }
+    return t;
+}
+
+CsvTable *csv_load_table(const char *csv_path, const CsvParseOptions *opts) {
+    CsvTable *t = csv_cache_load_fresh(csv_path, opts, false);
+    return t ? t : csv_parse_parallel(csv_path, opts);
+}
@@ -0,0 +1,100 @@
+#ifndef CSV_CACHE_H
+#define CSV_CACHE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/stat.h>
+#include "csvParallel.h"
+
+// --- Binary Columnar Cache ---
+//
+// File layout (native byte order, every offset from the start of the file):
+//   CsvCacheHeader          fixed 128 bytes
+//   CsvCacheColumn[cols]    type, name length and data offset of every column
+//   names                   NUL-terminated header names, in column order
+//   int64_t[error_count]    record numbers of the rows the parser skipped
+//   column data             one 64-byte aligned block per column
+// The checksum covers everything after the header.
+
+#define CSV_CACHE_MAGIC "CALCCOL"   // 7 chars + NUL
+#define CSV_CACHE_VERSION 2
+#define CSV_CACHE_SUFFIX ".cache"   // Default cache path: <csv path>.cache
+#define CSV_CACHE_ALIGN 64
+
+typedef enum {
+    CSV_COL_F64 = 0,
+    CSV_COL_F32 = 1     // Half the size; widened to double when loaded
+} CsvColumnType;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;    // 0x01020304 as written by the producing machine
+    uint64_t rows;
+    uint64_t cols;
+    uint64_t error_count;
+    uint64_t source_size;   // Size of the CSV the cache was built from (see source_mtime_sec)
+    uint64_t payload_size;  // Bytes after the header
+    uint64_t checksum;
+    uint64_t max_cols;      // Parse options the cache was built with
+    int32_t delimiter;
+    uint32_t has_header;
+    uint32_t projected;     // Built from a by-name column selection
+    uint32_t source_mtime_nsec;
+    int64_t source_mtime_sec;   // Modification time, size and inode identify the source
+    uint64_t source_inode;
+    char reserved[24];
+} CsvCacheHeader;
+
+typedef struct {
+    uint32_t type;          // CsvColumnType
+    uint32_t name_len;      // Excluding the NUL
+    uint64_t offset;
+} CsvCacheColumn;
+
+/**
+ * @brief Returns a malloc'd "<csv_path>.cache" string (caller frees).
+ */
+char *csv_cache_default_path(const char *csv_path);
+
+/**
+ * @brief Writes a parsed table as a binary cache (atomically, via a temporary file).
+ * @param source stat() of the CSV taken before it was parsed (NULL if unknown:
+ *        such a cache is never fresh)
+ * @return true on success
+ */
+bool csv_cache_write(const CsvTable *table, const char *cache_path, CsvColumnType type,
+                     const CsvParseOptions *opts, const struct stat *source);
+
+/**
+ * @brief Parses 'csv_path' with csv_parse_parallel and writes the cache.
+ * @param cache_path NULL = csv_cache_default_path(csv_path)
+ * @return true on success
+ */
+bool csv_cache_convert(const char *csv_path, const char *cache_path,
+                       const CsvParseOptions *opts, CsvColumnType type);
+
+/**
+ * @brief Loads a cache with a single mmap. f64 columns point straight into
+ * the mapping; f32 columns are widened into one owned block.
+ * @param verify Also check the payload checksum (one pass over the file)
+ * @return Table (free with csv_table_free), or NULL if the file is missing or invalid
+ */
+CsvTable *csv_cache_load(const char *cache_path, bool verify);
+
+/**
+ * @brief Loads <csv_path>.cache if it was built from this exact file (same
+ * modification time to the nanosecond, size and inode) with matching parse options.
+ * @param allow_f32 Accept a cache with f32 columns; they are rounded, so a caller
+ *        that needs the parsed doubles passes false
+ * @return Table, or NULL if there is no usable cache
+ */
+CsvTable *csv_cache_load_fresh(const char *csv_path, const CsvParseOptions *opts, bool allow_f32);
+
+/**
+ * @brief Fresh f64 cache if there is one, csv_parse_parallel otherwise.
+ */
+CsvTable *csv_load_table(const char *csv_path, const CsvParseOptions *opts);
+
+#endif // CSV_CACHE_H
@@ -0,0 +1,253 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "csvCompress.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define CSV_HAVE_PIPES 1
+extern char **environ;
+#endif
+
+#ifdef CSV_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+#define DECODE_CHUNK (64u << 10)
+
+struct CsvStream {
+    FILE *file;
+    CsvCompression kind;
+#ifdef CSV_HAVE_PIPES
+    int source_fd;          // Compressed input read by the zlib thread
+    int sink_fd;            // Our end of the channel the decoder writes to
+    pthread_t thread;
+    bool has_thread;
+    pid_t child;            // External decompressor (-1 = none)
+#endif
+    bool failed;            // Decoder saw corrupt or truncated data
+};
+
+// --- Detection ---
+
+CsvCompression csv_detect_compression(const unsigned char *head, size_t len) {
+    if (len >= 2 && head[0] == 0x1F && head[1] == 0x8B) return CSV_COMP_GZIP;
+    if (len >= 4 && head[0] == 0x28 && head[1] == 0xB5 && head[2] == 0x2F && head[3] == 0xFD) return CSV_COMP_ZSTD;
+    return CSV_COMP_NONE;
+}
+
+CsvCompression csv_detect_file(const char *filename) {
+    unsigned char head[4];
+    FILE *f = filename ? fopen(filename, "rb") : NULL;
+    if (!f) return CSV_COMP_NONE;
+    size_t n = fread(head, 1, sizeof(head), f);
+    fclose(f);
+    return csv_detect_compression(head, n);
+}
+
+// --- Decoders ---
+
+#ifdef CSV_HAVE_PIPES
+
+#ifdef CSV_HAVE_ZLIB
+// send() instead of write(): a reader that closes early gives EPIPE, not SIGPIPE
+static bool send_all(int fd, const unsigned char *p, size_t n) {
+    while (n > 0) {
+        ssize_t k = send(fd, p, n, MSG_NOSIGNAL);
+        if (k < 0 && errno == EINTR) continue;
+        if (k <= 0) return false;
+        p += k;
+        n -= (size_t)k;
+    }
+    return true;
+}
+
+// Inflates every gzip member of source_fd into sink_fd
+static void *gunzip_main(void *arg) {
+    CsvStream *s = (CsvStream *)arg;
+    unsigned char *in = malloc(DECODE_CHUNK), *out = malloc(DECODE_CHUNK);
+    z_stream zs;
+    memset(&zs, 0, sizeof(zs));
+    bool ok = in && out && inflateInit2(&zs, 15 + 32) == Z_OK; // 15 + 32: gzip header, max window
+    bool member_done = false, reader_gone = false;
+
+    ssize_t n;
+    while (ok && !reader_gone && (n = read(s->source_fd, in, DECODE_CHUNK)) > 0) {
+        zs.next_in = in;
+        zs.avail_in = (uInt)n;
+        if (member_done) { inflateReset(&zs); member_done = false; } // Concatenated members
+
+        for (;;) {
+            zs.next_out = out;
+            zs.avail_out = DECODE_CHUNK;
+            int ret = inflate(&zs, Z_NO_FLUSH);
+            if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) { ok = false; break; }
+            if (!send_all(s->sink_fd, out, DECODE_CHUNK - zs.avail_out)) { reader_gone = true; break; }
+
+            if (ret == Z_STREAM_END) {
+                member_done = true;
+                if (zs.avail_in == 0) break;
+                inflateReset(&zs);
+                member_done = false;
+                continue;
+            }
+            if (zs.avail_out != 0) break; // All input consumed
+        }
+    }
+    if (!reader_gone && !member_done) ok = false; // Truncated mid-member
+
+    s->failed = !ok && !reader_gone;
+    inflateEnd(&zs);
+    free(in);
+    free(out);
+    shutdown(s->sink_fd, SHUT_WR); // EOF for the reader
+    return NULL;
+}
+
+static bool start_zlib(CsvStream *s, const char *filename) {
+    int fds[2];
+    s->source_fd = open(filename, O_RDONLY);
+    if (s->source_fd < 0) return false;
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) return false;
+
+    s->sink_fd = fds[1];
+    s->file = fdopen(fds[0], "r");
+    if (!s->file) { close(fds[0]); return false; }
+    s->has_thread = pthread_create(&s->thread, NULL, gunzip_main, s) == 0;
+    return s->has_thread;
+}
+#endif // CSV_HAVE_ZLIB
+
+// Runs "<tool> -dcq -- <file>" with its stdout on a pipe
+static bool start_tool(CsvStream *s, const char *tool, const char *filename) {
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+
+    posix_spawn_file_actions_t fa;
+    posix_spawn_file_actions_init(&fa);
+    posix_spawn_file_actions_adddup2(&fa, fds[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addclose(&fa, fds[0]);
+    posix_spawn_file_actions_addclose(&fa, fds[1]);
+
+    char *argv[] = {(char *)tool, "-dcq", "--", (char *)filename, NULL};
+    int rc = posix_spawnp(&s->child, tool, &fa, NULL, argv, environ);
+    posix_spawn_file_actions_destroy(&fa);
+    close(fds[1]);
+    if (rc != 0) {
+        close(fds[0]);
+        s->child = -1;
+        errno = rc;
+        return false;
+    }
+
+    s->file = fdopen(fds[0], "r");
+    if (!s->file) { close(fds[0]); return false; }
+    return true;
+}
+
+#endif // CSV_HAVE_PIPES
+
+// --- Streams ---
+
+CsvStream *csv_stream_open(const char *filename) {
+    if (!filename) return NULL;
+    CsvStream *s = calloc(1, sizeof(CsvStream));
+    if (!s) return NULL;
+    s->kind = csv_detect_file(filename);
+#ifdef CSV_HAVE_PIPES
+    s->source_fd = s->sink_fd = -1;
+    s->child = -1;
+#endif
+
+    bool ok;
+    switch (s->kind) {
+        case CSV_COMP_NONE:
+            ok = (s->file = fopen(filename, "r")) != NULL;
+            break;
+#ifdef CSV_HAVE_PIPES
+        case CSV_COMP_GZIP:
+#ifdef CSV_HAVE_ZLIB
+            ok = start_zlib(s, filename);
+#else
+            ok = start_tool(s, "gzip", filename);
+#endif
+            break;
+        case CSV_COMP_ZSTD:
+            ok = start_tool(s, "zstd", filename);
+            break;
+#endif
+        default:
+            errno = ENOTSUP;
+            ok = false;
+    }
+
+    if (!ok) {
+        int err = errno;
+        csv_stream_close(s);
+        errno = err;
+        return NULL;
+    }
+    return s;
+}
+
+FILE *csv_stream_file(CsvStream *s) {
+    return s ? s->file : NULL;
+}
+
+CsvCompression csv_stream_kind(const CsvStream *s) {
+    return s ? s->kind : CSV_COMP_NONE;
+}
+
+bool csv_stream_close(CsvStream *s) {
+    if (!s) return false;
+    if (s->file) fclose(s->file); // Unblocks a decoder that is still writing
+
+#ifdef CSV_HAVE_PIPES
+    if (s->has_thread) pthread_join(s->thread, NULL);
+    if (s->sink_fd >= 0) close(s->sink_fd);
+    if (s->source_fd >= 0) close(s->source_fd);
+
+    if (s->child > 0) {
+        int status = 0;
+        while (waitpid(s->child, &status, 0) < 0 && errno == EINTR) {}
+        // Killed by SIGPIPE only means we stopped reading early
+        bool clean = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        if (!clean && !(WIFSIGNALED(status) && WTERMSIG(status) == SIGPIPE)) s->failed = true;
+    }
+#endif
+
+    bool ok = !s->failed;
+    free(s);
+    return ok;
+}
+
+char *csv_decompress_file(const char *filename, size_t *size_out) {
+    CsvStream *s = csv_stream_open(filename);
+    if (!s) return NULL;
+
+    size_t cap = DECODE_CHUNK, size = 0;
+    char *buf = malloc(cap);
+    while (buf) {
+        size += fread(buf + size, 1, cap - size, s->file);
+        if (size < cap) break;
+        char *grown = realloc(buf, cap * 2);
+        if (!grown) { free(buf); buf = NULL; break; }
+        buf = grown;
+        cap *= 2;
+    }
+
+    if (!csv_stream_close(s)) {
+        fprintf(stderr, "Warning: %s is corrupt or truncated, using the data before the damage.\n", filename);
+    }
+    if (buf && size_out) *size_out = size;
+    return buf;
+}
@@ -0,0 +1,61 @@
+#ifndef CSV_COMPRESS_H
+#define CSV_COMPRESS_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// --- Transparent Decompression ---
+
+typedef enum {
+    CSV_COMP_NONE = 0,
+    CSV_COMP_GZIP,      // 1F 8B
+    CSV_COMP_ZSTD       // 28 B5 2F FD
+} CsvCompression;
+
+/**
+ * @brief An input stream that is either the plain file or the output of a
+ * decompressor running concurrently with the reader.
+ * gzip is inflated by zlib on a background thread when the library is built
+ * with CSV_HAVE_ZLIB; otherwise, and for zstd, the external gzip / zstd tool
+ * runs as a child process. Either way the reader gets an ordinary FILE*.
+ */
+typedef struct CsvStream CsvStream;
+
+/**
+ * @brief Detects the compression format from the first bytes of a file.
+ */
+CsvCompression csv_detect_compression(const unsigned char *head, size_t len);
+
+/**
+ * @brief Reads the magic bytes of 'filename'.
+ * @return CSV_COMP_NONE for plain (or unreadable) files
+ */
+CsvCompression csv_detect_file(const char *filename);
+
+/**
+ * @brief Opens 'filename' for reading, decompressing if needed.
+ * @return Stream, or NULL on failure (errno describes the error)
+ */
+CsvStream *csv_stream_open(const char *filename);
+
+/** @brief The stream's readable FILE* (owned by the stream). */
+FILE *csv_stream_file(CsvStream *s);
+
+/** @brief Compression of the underlying file. */
+CsvCompression csv_stream_kind(const CsvStream *s);
+
+/**
+ * @brief Closes the stream and stops the decompressor.
+ * @return false if the compressed data was corrupt or truncated
+ * (and the reader therefore saw less than the whole file)
+ */
+bool csv_stream_close(CsvStream *s);
+
+/**
+ * @brief Decompresses a whole file into memory (for the buffer-based parsers).
+ * @return malloc'd buffer (caller frees), or NULL on failure
+ */
+char *csv_decompress_file(const char *filename, size_t *size_out);
+
+#endif // CSV_COMPRESS_H
@@ -1,33 +1,32 @@
 #include "csvHandler.h"
+#include "csvMap.h"
+#include "csvParallel.h"
+#include "csvCache.h"
+#include "csvSchema.h"
+
+// Vector columns by header name, in order of preference; otherwise the first three
+static const char *const XYZ_COLUMNS[] = {"X", "Y", "Z"};
+static const char *const V1_COLUMNS[] = {"V1_X", "V1_Y", "V1_Z"};
+static const char *const *const VECTOR_SCHEMAS[] = {XYZ_COLUMNS, V1_COLUMNS};
+#define VECTOR_SCHEMA_COUNT (sizeof(VECTOR_SCHEMAS) / sizeof(VECTOR_SCHEMAS[0]))
+
+// Picks the X,Y,Z columns of a file from its header record
+static const char *const *vector_schema(const char *header, size_t len) {
+    for (size_t i = 0; i < VECTOR_SCHEMA_COUNT; i++) {
+        CsvProjection proj;
+        if (csv_projection_from_header(&proj, header, len, ',', VECTOR_SCHEMAS[i], 3)) {
+            csv_projection_free(&proj);
+            return VECTOR_SCHEMAS[i];
+        }
+    }
+    return NULL;
+}
 
-// Helper function to read a single vector from the current line's tokens
-// Note: Expects 'v_out' to be already allocated with dimension 3
-static bool read_single_vector(CsvFile *csv, vector v_out) {
-    char *field_str;
-
-    if (!csv || !v_out || v_out->dim < 3) return false;
-
-    // 1. Read X component
-    field_str = csv_get_field(csv);
-    if (field_str == NULL) return false;
-    v_out->val[0] = atof(field_str);
-
-    // 2. Read Y component
-    field_str = csv_get_field(csv);
-    if (field_str == NULL) return false;
-    v_out->val[1] = atof(field_str);
-
-    // 3. Read Z component
-    field_str = csv_get_field(csv);
-    if (field_str == NULL) return false;
-    v_out->val[2] = atof(field_str);
-
-    // 4. Read Magnitude (Ignored in new struct, but must be consumed from CSV)
-    field_str = csv_get_field(csv);
-    if (field_str == NULL) return false;
-    // We do nothing with magnitude as it is calculated on demand in the new ADT
-
-    return true;
+static bool vector_projection(const char *header, size_t len, CsvProjection *proj) {
+    static const size_t positions[3] = {0, 1, 2};
+    const char *const *names = vector_schema(header, len);
+    if (names) return csv_projection_from_header(proj, header, len, ',', names, 3);
+    return csv_projection_from_indices(proj, positions, 3, ',');
 }
 
 // --- Core CSV Function Implementations ---
@@ -39,20 +38,52 @@ CsvFile* csv_open(const char *filename) {
         return NULL;
     }
 
-    csv->file_ptr = fopen(filename, "r");
-    if (csv->file_ptr == NULL) {
+    csv->stream = csv_stream_open(filename);
+    if (csv->stream == NULL) {
         perror("Error opening CSV file");
         free(csv); 
         return NULL;
     }
+    csv->file_ptr = csv_stream_file(csv->stream);
 
+    csv->path = malloc(strlen(filename) + 1);
+    if (csv->path) strcpy(csv->path, filename);
     csv->current_line_number = 0;
+    csv->field_line_number = -1;
+    csv->field_next = NULL;
 
     return csv;
 }
 
+// Reports a decoder failure: the reader saw only part of the data
+static void close_stream(CsvFile *csv) {
+    if (csv->stream && !csv_stream_close(csv->stream)) {
+        fprintf(stderr, "Warning: %s is corrupt or truncated.\n", csv->path ? csv->path : "CSV input");
+    }
+    csv->stream = NULL;
+    csv->file_ptr = NULL;
+}
+
+bool csv_rewind(CsvFile *csv) {
+    if (!csv) return false;
+    csv->current_line_number = 0;
+    csv->field_line_number = -1;
+    csv->field_next = NULL;
+
+    if (csv_stream_kind(csv->stream) == CSV_COMP_NONE && csv->file_ptr) {
+        rewind(csv->file_ptr);
+        return true;
+    }
+
+    // A decompressor's output cannot seek: start it again
+    close_stream(csv);
+    csv->stream = csv->path ? csv_stream_open(csv->path) : NULL;
+    csv->file_ptr = csv_stream_file(csv->stream);
+    return csv->file_ptr != NULL;
+}
+
 bool csv_read_line(CsvFile *csv) {
-    if (fgets(csv->line_buffer, MAX_LINE_LENGTH, csv->file_ptr) != NULL) {
+    if (csv->file_ptr && fgets(csv->line_buffer, MAX_LINE_LENGTH, csv->file_ptr) != NULL) {
         csv->line_buffer[strcspn(csv->line_buffer, "\n")] = 0; 
         csv->current_line_number++;
         return true;
@@ -61,65 +92,117 @@ bool csv_read_line(CsvFile *csv) {
 }
 
 char* csv_get_field(CsvFile *csv) {
-    static int last_line_number = -1;
-    
-    // If we're on a new line, reinitialize strtok
-    if (last_line_number != csv->current_line_number) {
-        last_line_number = csv->current_line_number;
-        return strtok(csv->line_buffer, ",");
+    // If we're on a new line, restart at the beginning of the buffer
+    if (csv->field_line_number != csv->current_line_number) {
+        csv->field_line_number = csv->current_line_number;
+        csv->field_next = csv->line_buffer;
     }
-    
-    // Continue tokenizing the current line
-    return strtok(NULL, ",");
+    if (csv->field_next == NULL) return NULL;
+
+    // Same rules as strtok(..., ","): empty fields are skipped
+    char *start = csv->field_next + strspn(csv->field_next, ",");
+    if (*start == '\0') {
+        csv->field_next = NULL;
+        return NULL;
+    }
+
+    char *end = start + strcspn(start, ",");
+    if (*end == ',') {
+        *end = '\0';
+        csv->field_next = end + 1;
+    } else {
+        csv->field_next = NULL;
+    }
+    return start;
 }
 
 void csv_close(CsvFile *csv) {
     if (csv == NULL) return;
-    if (csv->file_ptr != NULL) {
-        fclose(csv->file_ptr);
-    }
+    close_stream(csv);
+    free(csv->path);
     free(csv);
 }
 
 // --- Vector Set Functionality Implementation ---
 
+// Moves the X,Y,Z columns of a parsed table into the set
+static void table_to_vector_set(CsvTable *table, vectorSet set) {
+    for (size_t e = 0; e < table->error_count; e++) {
+        fprintf(stderr, "Warning: Skipping badly formatted line %ld.\n", table->error_lines[e]);
+    }
+
+    for (size_t r = 0; r < table->rows && table->cols >= 3; r++) {
+        vector v = cnstVector(3);
+        if (!v) break;
+        for (int i = 0; i < 3; i++) v->val[i] = table->columns[i][r];
+        addToSet(set, v); // Same (reversed) order as the line-by-line reader
+    }
+}
+
+// A fresh binary cache (any size), large files parsed on worker threads, or any
+// file csv_map_open already had to read into memory (gzip / zstd are inflated
+// there): streaming it again through csv_open would decompress it twice.
+static bool read_vector_set_fast(const char *filename, vectorSet set) {
+    CsvMap *map = csv_map_open(filename);
+    if (!map) return false;
+
+    CsvCursor cur;
+    CsvParseOptions opts = csv_default_options();
+    csv_cursor_init(&cur, map->data, map->size, ',');
+    if (csv_cursor_next_line(&cur)) opts.columns = vector_schema(cur.line, (size_t)(cur.line_end - cur.line));
+    if (opts.columns) opts.column_count = 3;
+    else opts.max_cols = 3;
+
+    CsvTable *table = csv_cache_load_fresh(filename, &opts, false);
+    if (!table && (map->size >= CSV_PARALLEL_THRESHOLD || !map->mapped)) {
+        table = csv_parse_buffer_parallel(map->data, map->size, &opts);
+    }
+    csv_map_close(map);
+    if (!table) return false;
+
+    table_to_vector_set(table, set);
+    csv_table_free(table);
+    return true;
+}
+
 vectorSet csv_read_vector_set(const char *filename) {
     // 1. Create the Set
     vectorSet set = cnstVectorSet();
     if (!set) return NULL;
 
+    if (read_vector_set_fast(filename, set)) return set;
+
     CsvFile *file = csv_open(filename);
     if (file == NULL) {
         // Return empty set if file fails, or NULL depending on preference
         return set; 
     }
 
-    csv_read_line(file); // Skip header 
+    // Header decides which columns hold X, Y, Z; the others are never converted
+    CsvProjection proj;
+    bool have_header = csv_read_line(file);
+    if (!vector_projection(have_header ? file->line_buffer : "", have_header ? strlen(file->line_buffer) : 0, &proj)) {
+        csv_close(file);
+        return set;
+    }
 
     while (csv_read_line(file)) {
+        double xyz[3];
+        if (!csv_projection_read_record(&proj, file->line_buffer, strlen(file->line_buffer), xyz)) {
+            fprintf(stderr, "Warning: Skipping badly formatted line %d.\n", file->current_line_number);
+            continue;
+        }
+
         // 2. Construct a new vector for this line
         vector current_vector = cnstVector(3); // 3D vector
         if (!current_vector) break; // Memory fail
+        for (int i = 0; i < 3; i++) current_vector->val[i] = xyz[i];
 
-        // Attempt to read the FIRST vector (4 fields: x, y, z, mag)
-        if (read_single_vector(file, current_vector)) {
-            
-            // Skip the remaining 9 fields (V2, V3, and EXPECTED_VOLUME) if they exist
-            // (Based on legacy logic)
-            for (int i = 0; i < 9; i++) {
-                if (csv_get_field(file) == NULL) break;
-            }
-            
-            // 3. Add to Set
-            addToSet(set, current_vector);
-
-        } else {
-            // If reading failed, free the unused vector
-            dcnstVector(current_vector);
-            fprintf(stderr, "Warning: Skipping badly formatted line %d.\n", file->current_line_number);
-        }
+        // 3. Add to Set
+        addToSet(set, current_vector);
     }
 
+    csv_projection_free(&proj);
     csv_close(file);
     return set;
 }
\ No newline at end of file
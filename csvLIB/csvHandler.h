@@ -6,25 +6,39 @@
 #include <string.h>
 #include <stdbool.h>
 #include "vectorOps.h" // Includes vector, vectorSet definitions
+#include "csvCompress.h"
 
 #define MAX_LINE_LENGTH 1024
 
 // --- CSV File Structure ---
 typedef struct {
     FILE *file_ptr;
+    CsvStream *stream;      // Owns file_ptr (gzip / zstd input is decompressed on the fly)
+    char *path;             // For reopening non-seekable streams in csv_rewind
     char line_buffer[MAX_LINE_LENGTH];
     int current_line_number;
+    int field_line_number;  // Line the field cursor belongs to (-1 = none)
+    char *field_next;       // Where csv_get_field continues tokenising
 } CsvFile;
 
 // --- Core CSV Function Prototypes ---
 
 /**
  * @brief Opens a CSV file for reading
+ * gzip and zstd files are recognised by their magic bytes and decompressed
+ * while they are being read.
  * @param filename Path to the CSV file
  * @return Pointer to CsvFile structure, or NULL on failure
  */
 CsvFile* csv_open(const char *filename);
 
+/**
+ * @brief Goes back to the first line (reopens compressed streams).
+ * @param csv Pointer to CsvFile structure
+ * @return true if successful
+ */
+bool csv_rewind(CsvFile *csv);
+
 /**
  * @brief Reads the next line from the CSV file
  * @param csv Pointer to CsvFile structure
@@ -34,6 +48,7 @@ bool csv_read_line(CsvFile *csv);
 
 /**
  * @brief Retrieves the next field from the current line
+ * Tokenising state lives in the CsvFile, so several files can be read at once.
  * @param csv Pointer to CsvFile structure
  * @return Pointer to field string, or NULL if no more fields
  */
@@ -47,7 +62,9 @@ void csv_close(CsvFile *csv);
 
 /**
  * @brief Reads a set of vectors from CSV file.
- * Assumes the first 3 columns are X, Y, Z and the 4th is Magnitude (ignored).
+ * X, Y, Z are taken from the header columns named X,Y,Z (or V1_X,V1_Y,V1_Z),
+ * otherwise from the first 3 columns. Other columns are not converted.
+ * A fresh binary cache (<filename>.cache, see csvCache.h) is loaded instead of parsing.
  * @param filename Path to the CSV file
  * @return vectorSet structure containing the vectors
  */
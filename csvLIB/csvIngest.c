@@ -0,0 +1,617 @@
+#define _GNU_SOURCE // syscall() and MAP_POPULATE for the io_uring rings
+
+#include "csvIngest.h"
+#include "csvCompress.h"
+#include "parallel.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#ifdef __NR_io_uring_setup
+#define CSV_HAVE_IO_URING 1
+#endif
+#endif
+
+// --- Shared State ---
+
+typedef struct {
+    int fd;
+    char *buf;              // Whole file once every read has completed
+    uint64_t issued;        // Bytes requested so far
+    uint64_t done;          // Bytes read so far
+    unsigned int inflight;
+    size_t counted;         // Bytes this file adds to Ingest.buffered
+    bool compressed;        // gzip / zstd: not read here, the parser decompresses it
+} FileIo;
+
+typedef struct {
+    const CsvIngestOptions *opts;
+    CsvParseOptions parse;  // Per-file options (one thread each unless a single file)
+    CsvIngestResult *result;
+    FileIo *io;
+
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    size_t *ready;          // Files read and waiting for a parser (FIFO)
+    size_t ready_head;
+    size_t ready_tail;
+    size_t next_file;       // Next file a pread worker claims
+    bool reading_done;
+    size_t buffered;        // Bytes read but not parsed yet
+    size_t memory_limit;
+} Ingest;
+
+// Parses one file's bytes (or records why there are none) and frees them
+static void parse_file(Ingest *g, size_t i) {
+    CsvIngestFile *f = &g->result->files[i];
+    FileIo *io = &g->io[i];
+
+    if (f->error == 0) {
+        if (io->compressed) {
+            f->table = csv_parse_parallel(f->path, &g->parse); // Decompresses on the way
+        } else {
+            f->table = csv_parse_buffer_parallel(io->buf, (size_t)io->done, &g->parse);
+        }
+        if (!f->table) f->error = EINVAL;
+    }
+    free(io->buf);
+    io->buf = NULL;
+
+    pthread_mutex_lock(&g->lock);
+    g->buffered -= io->counted;
+    pthread_cond_broadcast(&g->changed);
+    pthread_mutex_unlock(&g->lock);
+}
+
+// Opens a file and allocates its buffer; false records the error on the file
+static bool start_file(Ingest *g, size_t i) {
+    CsvIngestFile *f = &g->result->files[i];
+    FileIo *io = &g->io[i];
+    struct stat st;
+
+    io->fd = open(f->path, O_RDONLY);
+    if (io->fd < 0) { f->error = errno; return false; }
+    int err = (fstat(io->fd, &st) != 0) ? errno : S_ISDIR(st.st_mode) ? EISDIR : !S_ISREG(st.st_mode) ? EINVAL : 0;
+    if (err) {
+        f->error = err;
+        close(io->fd);
+        io->fd = -1;
+        return false;
+    }
+    f->bytes = (uint64_t)st.st_size;
+
+    // Compressed files are only read once, by the decompressor
+    unsigned char head[4];
+    ssize_t n;
+    while ((n = pread(io->fd, head, sizeof(head), 0)) < 0 && errno == EINTR) {}
+    io->compressed = n > 0 && csv_detect_compression(head, (size_t)n) != CSV_COMP_NONE;
+    if (io->compressed) return true;
+
+    io->buf = malloc((size_t)f->bytes + 1);
+    if (!io->buf) {
+        f->error = ENOMEM;
+        close(io->fd);
+        io->fd = -1;
+        return false;
+    }
+
+    pthread_mutex_lock(&g->lock);
+    io->counted = (size_t)f->bytes;
+    g->buffered += io->counted;
+    pthread_mutex_unlock(&g->lock);
+    return true;
+}
+
+static void finish_read(FileIo *io) {
+    if (io->fd >= 0) close(io->fd);
+    io->fd = -1;
+}
+
+// --- Parser Pool (io_uring mode) ---
+
+static void queue_ready(Ingest *g, size_t i) {
+    pthread_mutex_lock(&g->lock);
+    g->ready[g->ready_tail++] = i;
+    pthread_cond_broadcast(&g->changed);
+    pthread_mutex_unlock(&g->lock);
+}
+
+static void parser_loop(Ingest *g) {
+    for (;;) {
+        pthread_mutex_lock(&g->lock);
+        while (g->ready_head == g->ready_tail && !g->reading_done) pthread_cond_wait(&g->changed, &g->lock);
+        if (g->ready_head == g->ready_tail) {
+            pthread_mutex_unlock(&g->lock);
+            return;
+        }
+        size_t i = g->ready[g->ready_head++];
+        pthread_mutex_unlock(&g->lock);
+        parse_file(g, i);
+    }
+}
+
+// --- io_uring Reader ---
+
+#ifdef CSV_HAVE_IO_URING
+
+typedef struct {
+    int fd;
+    unsigned int entries;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ring, *cq_ring;
+    size_t sq_ring_len, cq_ring_len, sqes_len;
+    unsigned int to_submit;
+} Uring;
+
+typedef struct {
+    size_t file;
+    struct iovec iov;       // Must stay valid until the read completes
+    bool busy;
+} ReadSlot;
+
+static void uring_exit(Uring *u) {
+    if (u->sqes && u->sqes != MAP_FAILED) munmap(u->sqes, u->sqes_len);
+    if (u->cq_ring && u->cq_ring != MAP_FAILED && u->cq_ring != u->sq_ring) munmap(u->cq_ring, u->cq_ring_len);
+    if (u->sq_ring && u->sq_ring != MAP_FAILED) munmap(u->sq_ring, u->sq_ring_len);
+    if (u->fd >= 0) close(u->fd);
+}
+
+static bool uring_init(Uring *u, unsigned int entries) {
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    memset(u, 0, sizeof(*u));
+    u->fd = (int)syscall(__NR_io_uring_setup, entries, &p);
+    if (u->fd < 0) return false; // Old kernel, seccomp, or disabled by sysctl
+
+    u->sq_ring_len = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    u->cq_ring_len = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single && u->cq_ring_len > u->sq_ring_len) u->sq_ring_len = u->cq_ring_len;
+
+    u->sq_ring = mmap(NULL, u->sq_ring_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQ_RING);
+    u->cq_ring = single ? u->sq_ring
+                        : mmap(NULL, u->cq_ring_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_CQ_RING);
+    u->sqes_len = p.sq_entries * sizeof(struct io_uring_sqe);
+    u->sqes = mmap(NULL, u->sqes_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, u->fd, IORING_OFF_SQES);
+    if (u->sq_ring == MAP_FAILED || u->cq_ring == MAP_FAILED || u->sqes == MAP_FAILED) {
+        uring_exit(u);
+        return false;
+    }
+
+    char *sq = (char *)u->sq_ring, *cq = (char *)u->cq_ring;
+    u->sq_head = (unsigned *)(sq + p.sq_off.head);
+    u->sq_tail = (unsigned *)(sq + p.sq_off.tail);
+    u->sq_mask = (unsigned *)(sq + p.sq_off.ring_mask);
+    u->sq_array = (unsigned *)(sq + p.sq_off.array);
+    u->cq_head = (unsigned *)(cq + p.cq_off.head);
+    u->cq_tail = (unsigned *)(cq + p.cq_off.tail);
+    u->cq_mask = (unsigned *)(cq + p.cq_off.ring_mask);
+    u->cqes = (struct io_uring_cqe *)(cq + p.cq_off.cqes);
+    u->entries = p.sq_entries;
+    return true;
+}
+
+// Queues one readv; the caller keeps in-flight requests <= entries
+static void uring_readv(Uring *u, int fd, const struct iovec *iov, uint64_t offset, uint64_t user_data) {
+    unsigned tail = *u->sq_tail;
+    unsigned idx = tail & *u->sq_mask;
+    struct io_uring_sqe *sqe = &u->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)(uintptr_t)iov;
+    sqe->len = 1;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    u->sq_array[idx] = idx;
+    __atomic_store_n(u->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    u->to_submit++;
+}
+
+static bool uring_enter(Uring *u, unsigned int wait_for) {
+    unsigned int flags = wait_for ? IORING_ENTER_GETEVENTS : 0;
+    for (;;) {
+        long n = syscall(__NR_io_uring_enter, u->fd, u->to_submit, wait_for, flags, NULL, 0);
+        if (n >= 0) {
+            u->to_submit -= (unsigned int)n;
+            return true;
+        }
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY) return false;
+        if (errno != EINTR) { flags = IORING_ENTER_GETEVENTS; wait_for = 1; } // Reap to make room
+    }
+}
+
+typedef struct {
+    Uring ring;
+    ReadSlot *slots;
+    unsigned int depth;
+    unsigned int inflight;
+    size_t current;         // File whose reads are being issued (count = none)
+    size_t next;            // Next file to start
+    size_t finished;        // Files handed to the parsers
+    bool failed;            // The ring broke: only reap what is still in flight
+} Reader;
+
+static void file_read_complete(Ingest *g, Reader *r, size_t i) {
+    finish_read(&g->io[i]);
+    queue_ready(g, i);
+    r->finished++;
+}
+
+// Issues reads until the queue is full, memory is short, or every file is issued
+static void issue_reads(Ingest *g, Reader *r) {
+    const size_t count = g->result->count;
+    while (r->inflight < r->depth) {
+        if (r->current == count || g->io[r->current].issued == g->result->files[r->current].bytes) {
+            if (r->next == count) return;
+            pthread_mutex_lock(&g->lock);
+            bool room = g->buffered == 0 || g->buffered < g->memory_limit;
+            pthread_mutex_unlock(&g->lock);
+            if (!room) return;
+
+            size_t i = r->next++;
+            r->current = count;
+            if (!start_file(g, i)) { file_read_complete(g, r, i); continue; }
+            if (g->result->files[i].bytes == 0 || g->io[i].compressed) { file_read_complete(g, r, i); continue; }
+            r->current = i;
+        }
+
+        size_t i = r->current;
+        FileIo *io = &g->io[i];
+        uint64_t left = g->result->files[i].bytes - io->issued;
+        size_t len = left < CSV_INGEST_READ_CHUNK ? (size_t)left : CSV_INGEST_READ_CHUNK;
+
+        unsigned int s = 0;
+        while (r->slots[s].busy) s++;
+        r->slots[s].busy = true;
+        r->slots[s].file = i;
+        r->slots[s].iov.iov_base = io->buf + io->issued;
+        r->slots[s].iov.iov_len = len;
+        uring_readv(&r->ring, io->fd, &r->slots[s].iov, io->issued, s);
+        io->issued += len;
+        io->inflight++;
+        r->inflight++;
+    }
+}
+
+static void reap_reads(Ingest *g, Reader *r) {
+    Uring *u = &r->ring;
+    unsigned head = *u->cq_head;
+    unsigned tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+
+    for (; head != tail; head++) {
+        const struct io_uring_cqe *cqe = &u->cqes[head & *u->cq_mask];
+        ReadSlot *slot = &r->slots[cqe->user_data];
+        size_t i = slot->file;
+        FileIo *io = &g->io[i];
+        CsvIngestFile *f = &g->result->files[i];
+        int res = cqe->res;
+
+        if (res > 0 && (size_t)res < slot->iov.iov_len && f->error == 0 && !r->failed) {
+            // Short read: ask for the rest with the same slot
+            slot->iov.iov_base = (char *)slot->iov.iov_base + res;
+            slot->iov.iov_len -= (size_t)res;
+            io->done += (uint64_t)res;
+            uint64_t offset = (uint64_t)((char *)slot->iov.iov_base - io->buf);
+            uring_readv(u, io->fd, &slot->iov, offset, cqe->user_data);
+            continue;
+        }
+
+        if (res < 0 && f->error == 0) f->error = -res;
+        else if (res == 0 && f->error == 0) f->error = EIO; // File shrank while reading
+        else if (res > 0) io->done += (uint64_t)res;
+        if (r->failed && f->error == 0 && (io->issued != f->bytes || io->done != f->bytes)) f->error = EIO;
+        slot->busy = false;
+        io->inflight--;
+        r->inflight--;
+
+        if (f->error != 0 && r->current == i) r->current = g->result->count; // Stop issuing for it
+        bool all_issued = io->issued == f->bytes || f->error != 0;
+        if (io->inflight == 0 && all_issued) file_read_complete(g, r, i);
+    }
+    __atomic_store_n(u->cq_head, head, __ATOMIC_RELEASE);
+}
+
+static bool reader_loop(Ingest *g, Reader *r) {
+    const size_t count = g->result->count;
+    while (r->finished < count) {
+        issue_reads(g, r);
+        if (r->inflight == 0) {
+            if (r->finished == count) break;
+            // Out of memory budget: wait for the parsers to catch up
+            pthread_mutex_lock(&g->lock);
+            while (g->buffered != 0 && g->buffered >= g->memory_limit) pthread_cond_wait(&g->changed, &g->lock);
+            pthread_mutex_unlock(&g->lock);
+            continue;
+        }
+        if (!uring_enter(&r->ring, 1)) return false;
+        reap_reads(g, r);
+    }
+    return true;
+}
+
+// A broken ring: wait for the reads already in flight, since the kernel may
+// still write into their buffers and iovecs. Returns false if that fails too.
+static bool drain_reads(Ingest *g, Reader *r) {
+    r->failed = true;
+    r->ring.to_submit = 0;
+    while (r->inflight > 0) {
+        if (!uring_enter(&r->ring, 1)) return false;
+        reap_reads(g, r);
+    }
+    return true;
+}
+
+// Fails every file the reader had not finished and hands it to the parsers
+static void fail_unfinished(Ingest *g, Reader *r) {
+    for (size_t i = 0; i < g->result->count; i++) {
+        FileIo *io = &g->io[i];
+        if (io->fd < 0 && i < r->next) continue;   // Finished (or failed to open) and queued already
+        if (g->result->files[i].error == 0) g->result->files[i].error = EIO;
+        // Reads still in flight own their buffer: leave it to the kernel
+        if (io->inflight > 0) io->buf = NULL;
+        finish_read(io);
+        queue_ready(g, i);
+    }
+}
+
+static void *parser_main(void *arg) {
+    parser_loop((Ingest *)arg);
+    return NULL;
+}
+
+static bool run_io_uring(Ingest *g, unsigned int parsers) {
+    Reader r;
+    memset(&r, 0, sizeof(r));
+    r.depth = g->opts->queue_depth ? g->opts->queue_depth : CSV_INGEST_QUEUE_DEPTH;
+    if (!uring_init(&r.ring, r.depth)) return false;
+    if (r.depth > r.ring.entries) r.depth = r.ring.entries;
+    r.slots = calloc(r.depth, sizeof(ReadSlot));
+    pthread_t *ids = malloc(sizeof(pthread_t) * (parsers ? parsers : 1));
+
+    // The calling thread reads; parsers must be real threads, or the reader
+    // would wait on its memory budget with nobody to drain it
+    unsigned int started = 0;
+    while (r.slots && ids && started < parsers && pthread_create(&ids[started], NULL, parser_main, g) == 0) started++;
+    if (started == 0) {
+        free(ids);
+        free(r.slots);
+        uring_exit(&r.ring);
+        return false;   // Nothing touched yet: the pread pool takes over
+    }
+    r.current = g->result->count;
+
+    bool ok = reader_loop(g, &r);
+    bool drained = ok || drain_reads(g, &r);
+    if (!ok) fail_unfinished(g, &r);
+
+    pthread_mutex_lock(&g->lock);
+    g->reading_done = true;
+    pthread_cond_broadcast(&g->changed);
+    pthread_mutex_unlock(&g->lock);
+    parser_loop(g); // Help with what is left
+    for (unsigned int w = 0; w < started; w++) pthread_join(ids[w], NULL);
+
+    free(ids);
+    if (drained) free(r.slots); // Otherwise in-flight reads may still use their iovecs
+    uring_exit(&r.ring);
+    return true;
+}
+
+#endif // CSV_HAVE_IO_URING
+
+// --- pread Thread Pool ---
+
+static void pread_file(Ingest *g, size_t i) {
+    FileIo *io = &g->io[i];
+    CsvIngestFile *f = &g->result->files[i];
+    if (!start_file(g, i)) return;
+
+    while (!io->compressed && io->done < f->bytes) {
+        size_t want = (f->bytes - io->done) < CSV_INGEST_READ_CHUNK ? (size_t)(f->bytes - io->done) : CSV_INGEST_READ_CHUNK;
+        ssize_t n = pread(io->fd, io->buf + io->done, want, (off_t)io->done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            f->error = (n < 0) ? errno : EIO;
+            break;
+        }
+        io->done += (uint64_t)n;
+    }
+    finish_read(io);
+}
+
+static void pread_body(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    Ingest *g = (Ingest *)ctx;
+    (void)begin;
+    (void)end;
+    (void)worker;
+    for (;;) {
+        pthread_mutex_lock(&g->lock);
+        while (g->buffered != 0 && g->buffered >= g->memory_limit) pthread_cond_wait(&g->changed, &g->lock);
+        size_t i = g->next_file++;
+        pthread_mutex_unlock(&g->lock);
+        if (i >= g->result->count) return;
+
+        pread_file(g, i);
+        parse_file(g, i);
+    }
+}
+
+// --- Public API ---
+
+CsvIngestOptions csv_ingest_default_options(void) {
+    CsvIngestOptions o;
+    memset(&o, 0, sizeof(o));
+    o.parse = csv_default_options();
+    o.use_io_uring = true;
+    return o;
+}
+
+CsvIngestResult *csv_ingest_files(const char *const paths[], size_t count, const CsvIngestOptions *opts) {
+    CsvIngestOptions o = opts ? *opts : csv_ingest_default_options();
+    CsvIngestResult *result = calloc(1, sizeof(CsvIngestResult));
+    if (!result) return NULL;
+    result->count = count;
+    result->files = calloc(count ? count : 1, sizeof(CsvIngestFile));
+
+    Ingest g;
+    memset(&g, 0, sizeof(g));
+    g.opts = &o;
+    g.result = result;
+    g.io = calloc(count ? count : 1, sizeof(FileIo));
+    g.ready = malloc(sizeof(size_t) * (count ? count : 1));
+    g.memory_limit = o.memory_limit ? o.memory_limit : CSV_INGEST_MEMORY_LIMIT;
+    bool ok = result->files && g.io && g.ready;
+    for (size_t i = 0; ok && i < count; i++) {
+        result->files[i].path = strdup(paths[i]);
+        g.io[i].fd = -1;
+        ok = result->files[i].path != NULL;
+    }
+    if (!ok) {
+        free(g.io);
+        free(g.ready);
+        csv_ingest_free(result);
+        return NULL;
+    }
+
+    // Many files: one thread per file. A single file: the parser's own threads.
+    unsigned int threads = parallel_resolve_threads(o.threads);
+    g.parse = o.parse;
+    if (count > 1) g.parse.threads = 1;
+
+    pthread_mutex_init(&g.lock, NULL);
+    pthread_cond_init(&g.changed, NULL);
+#ifdef CSV_HAVE_IO_URING
+    if (o.use_io_uring && count > 0) result->used_io_uring = run_io_uring(&g, threads);
+#endif
+    if (!result->used_io_uring) parallel_for(threads, threads, pread_body, &g);
+    pthread_cond_destroy(&g.changed);
+    pthread_mutex_destroy(&g.lock);
+    for (size_t i = 0; i < count; i++) free(g.io[i].buf); // Only files a failed ring never finished
+    free(g.io);
+    free(g.ready);
+
+    for (size_t i = 0; i < count; i++) {
+        const CsvIngestFile *f = &result->files[i];
+        if (!f->table) {
+            result->failed++;
+            continue;
+        }
+        result->rows += f->table->rows;
+        result->bad_rows += f->table->error_count;
+        result->bytes += f->bytes;
+    }
+    return result;
+}
+
+static int compare_names(const void *a, const void *b) {
+    return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+CsvIngestResult *csv_ingest_directory(const char *dir, const char *suffix, const CsvIngestOptions *opts) {
+    DIR *d = dir ? opendir(dir) : NULL;
+    if (!d) return NULL;
+
+    char **paths = NULL;
+    size_t count = 0, cap = 0;
+    size_t dir_len = strlen(dir), suffix_len = suffix ? strlen(suffix) : 0;
+    bool ok = true;
+    struct dirent *e;
+    while (ok && (e = readdir(d)) != NULL) {
+        size_t name_len = strlen(e->d_name);
+        if (e->d_name[0] == '.') continue;
+        if (suffix_len && (name_len < suffix_len || strcmp(e->d_name + name_len - suffix_len, suffix) != 0)) continue;
+
+        char *path = malloc(dir_len + name_len + 2);
+        struct stat st;
+        if (!path) { ok = false; break; }
+        sprintf(path, "%s/%s", dir, e->d_name);
+        if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) { free(path); continue; }
+
+        if (count == cap) {
+            cap = cap ? cap * 2 : 64;
+            char **grown = realloc(paths, sizeof(char *) * cap);
+            if (!grown) { free(path); ok = false; break; }
+            paths = grown;
+        }
+        paths[count++] = path;
+    }
+    closedir(d);
+
+    CsvIngestResult *result = NULL;
+    if (ok) {
+        if (count > 1) qsort(paths, count, sizeof(char *), compare_names);
+        result = csv_ingest_files((const char *const *)paths, count, opts);
+    }
+    for (size_t i = 0; i < count; i++) free(paths[i]);
+    free(paths);
+    return result;
+}
+
+CsvTable *csv_ingest_combine(const CsvIngestResult *result) {
+    if (!result) return NULL;
+    const CsvTable *first = NULL;
+    size_t rows = 0;
+    for (size_t i = 0; i < result->count; i++) {
+        const CsvTable *t = result->files[i].table;
+        if (!t) continue;
+        if (!first) first = t;
+        if (t->cols != first->cols) return NULL;
+        rows += t->rows;
+    }
+    if (!first) return NULL;
+
+    CsvTable *out = calloc(1, sizeof(CsvTable));
+    if (!out) return NULL;
+    out->rows = rows;
+    out->cols = first->cols;
+    if (out->cols == 0) return out;
+
+    out->storage = malloc(sizeof(double) * (rows ? rows : 1) * out->cols);
+    out->columns = malloc(sizeof(double *) * out->cols);
+    if (!out->storage || !out->columns) {
+        csv_table_free(out);
+        return NULL;
+    }
+    for (size_t c = 0; c < out->cols; c++) out->columns[c] = (double *)out->storage + c * rows;
+
+    size_t at = 0;
+    for (size_t i = 0; i < result->count; i++) {
+        const CsvTable *t = result->files[i].table;
+        if (!t) continue;
+        for (size_t c = 0; c < out->cols; c++) memcpy(out->columns[c] + at, t->columns[c], sizeof(double) * t->rows);
+        at += t->rows;
+    }
+
+    if (first->names) {
+        out->names = calloc(out->cols, sizeof(char *));
+        for (size_t c = 0; out->names && c < out->cols; c++) {
+            out->names[c] = first->names[c] ? strdup(first->names[c]) : NULL;
+        }
+    }
+    return out;
+}
+
+void csv_ingest_free(CsvIngestResult *result) {
+    if (!result) return;
+    for (size_t i = 0; result->files && i < result->count; i++) {
+        free(result->files[i].path);
+        csv_table_free(result->files[i].table);
+    }
+    free(result->files);
+    free(result);
+}
@@ -0,0 +1,73 @@
+#ifndef CSV_INGEST_H
+#define CSV_INGEST_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "csvParallel.h"
+
+// --- Concurrent Multi-File Ingestion ---
+
+#define CSV_INGEST_READ_CHUNK (1u << 20)        // Bytes per read request
+#define CSV_INGEST_QUEUE_DEPTH 64               // Default reads in flight
+#define CSV_INGEST_MEMORY_LIMIT (256u << 20)    // Default read-but-unparsed bytes
+
+typedef struct {
+    CsvParseOptions parse;      // Applied to every file
+    unsigned int threads;       // Parser threads (0 = default thread count)
+    unsigned int queue_depth;   // Reads in flight (0 = CSV_INGEST_QUEUE_DEPTH)
+    size_t memory_limit;        // Reading pauses above this many unparsed bytes (0 = default)
+    bool use_io_uring;          // false = always use the pread thread pool
+} CsvIngestOptions;
+
+typedef struct {
+    char *path;
+    CsvTable *table;        // NULL if the file could not be read or parsed
+    int error;              // errno value when table is NULL
+    uint64_t bytes;         // File size
+} CsvIngestFile;
+
+typedef struct {
+    size_t count;
+    CsvIngestFile *files;   // Same order as the input paths
+    size_t failed;          // Files without a table
+    size_t rows;            // Totals over the parsed files
+    size_t bad_rows;
+    uint64_t bytes;
+    bool used_io_uring;
+} CsvIngestResult;
+
+/**
+ * @brief Default options: default parse options and thread count, io_uring when available.
+ */
+CsvIngestOptions csv_ingest_default_options(void);
+
+/**
+ * @brief Reads and parses many files concurrently.
+ * On Linux the calling thread keeps up to queue_depth reads in flight through
+ * io_uring (every file split into CSV_INGEST_READ_CHUNK requests) and hands each
+ * completed file to a pool of parser threads. Where io_uring is unavailable
+ * (or no parser thread can be started), the pool reads its own files with pread.
+ * gzip / zstd files are not read up front: their parser streams them through
+ * the decompressor.
+ * A file that fails does not stop the others.
+ * @return Per-file tables and totals (free with csv_ingest_free), or NULL if out of memory
+ */
+CsvIngestResult *csv_ingest_files(const char *const paths[], size_t count, const CsvIngestOptions *opts);
+
+/**
+ * @brief csv_ingest_files over the regular files in 'dir' whose names end in
+ * 'suffix' (NULL = every file), in name order.
+ */
+CsvIngestResult *csv_ingest_directory(const char *dir, const char *suffix, const CsvIngestOptions *opts);
+
+/**
+ * @brief Concatenates the rows of every parsed file into one table.
+ * Names come from the first table; error lines are not carried over.
+ * @return Table, or NULL if no file was parsed or the column counts differ
+ */
+CsvTable *csv_ingest_combine(const CsvIngestResult *result);
+
+void csv_ingest_free(CsvIngestResult *result);
+
+#endif // CSV_INGEST_H
@@ -0,0 +1,180 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "csvMap.h"
+#include "csvNumber.h"
+#include "csvCompress.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CSV_HAVE_MMAP 1
+#endif
+
+// --- Mapping ---
+
+#ifndef CSV_HAVE_MMAP
+// Portable fallback: one read of the whole file
+static bool read_whole_file(const char *filename, CsvMap *map) {
+    FILE *f = fopen(filename, "rb");
+    if (!f) return false;
+
+    size_t cap = 1 << 16, size = 0;
+    char *buf = malloc(cap);
+    while (buf) {
+        size += fread(buf + size, 1, cap - size, f);
+        if (size < cap) break;
+        char *grown = realloc(buf, cap * 2);
+        if (!grown) { free(buf); buf = NULL; break; }
+        buf = grown;
+        cap *= 2;
+    }
+    fclose(f);
+    if (!buf) return false;
+
+    map->data = buf;
+    map->size = size;
+    map->mapped = false;
+    return true;
+}
+#endif
+
+CsvMap *csv_map_open(const char *filename) {
+    if (!filename) return NULL;
+    CsvMap *map = (CsvMap *)malloc(sizeof(CsvMap));
+    if (!map) return NULL;
+    map->data = NULL;
+    map->size = 0;
+    map->mapped = false;
+
+    // Compressed input cannot be mapped: decompress it into memory instead
+    if (csv_detect_file(filename) != CSV_COMP_NONE) {
+        map->data = csv_decompress_file(filename, &map->size);
+        if (!map->data) { free(map); return NULL; }
+        return map;
+    }
+
+#ifdef CSV_HAVE_MMAP
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) { free(map); return NULL; }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) { close(fd); free(map); return NULL; }
+
+    if (st.st_size > 0) {
+        void *p = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) { close(fd); free(map); return NULL; }
+        posix_madvise(p, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+        map->data = (const char *)p;
+        map->size = (size_t)st.st_size;
+        map->mapped = true;
+    }
+    close(fd); // The mapping stays valid after close
+#else
+    if (!read_whole_file(filename, map)) { free(map); return NULL; }
+#endif
+
+    return map;
+}
+
+void csv_map_close(CsvMap *map) {
+    if (!map) return;
+#ifdef CSV_HAVE_MMAP
+    if (map->mapped && map->data) munmap((void *)map->data, map->size);
+#endif
+    if (!map->mapped) free((void *)map->data);
+    free(map);
+}
+
+// --- Cursor ---
+
+void csv_cursor_init(CsvCursor *cur, const char *data, size_t size, char delimiter) {
+    if (!cur) return;
+    cur->pos = data;
+    cur->end = data ? data + size : data;
+    cur->line = cur->line_end = cur->field = NULL;
+    cur->line_number = 0;
+    cur->delimiter = delimiter ? delimiter : ',';
+}
+
+const char *csv_record_end(const char *p, const char *end) {
+    const char *nl = memchr(p, '\n', (size_t)(end - p));
+    if (!nl) nl = end;
+
+    // Fast path: no quote before the newline
+    if (!memchr(p, '"', (size_t)(nl - p))) return nl;
+
+    bool in_quotes = false;
+    for (; p < end; p++) {
+        if (*p == '"') in_quotes = !in_quotes;
+        else if (*p == '\n' && !in_quotes) return p;
+    }
+    return end;
+}
+
+bool csv_cursor_next_line(CsvCursor *cur) {
+    if (!cur || !cur->pos || cur->pos >= cur->end) return false;
+
+    const char *rec_end = csv_record_end(cur->pos, cur->end);
+    cur->line = cur->pos;
+    cur->line_end = rec_end;
+    if (cur->line_end > cur->line && cur->line_end[-1] == '\r') cur->line_end--;
+    cur->field = cur->line;
+    cur->pos = (rec_end < cur->end) ? rec_end + 1 : cur->end;
+    cur->line_number++;
+    return true;
+}
+
+bool csv_cursor_next_field(CsvCursor *cur, CsvField *out) {
+    if (!cur || !cur->field) return false;
+
+    const char *p = cur->field, *end = cur->line_end;
+    CsvField f = {p, 0, false};
+
+    if (p < end && *p == '"') {
+        // Quoted: runs to the closing quote that is not part of a "" pair
+        const char *q = p + 1;
+        while (q < end) {
+            if (*q == '"') {
+                if (q + 1 < end && q[1] == '"') { q += 2; continue; }
+                break;
+            }
+            q++;
+        }
+        f.ptr = p + 1;
+        f.len = (size_t)(q - f.ptr);
+        f.quoted = true;
+        p = (q < end) ? q + 1 : end;
+        // Anything between the closing quote and the delimiter is ignored
+        const char *d = memchr(p, cur->delimiter, (size_t)(end - p));
+        p = d ? d : end;
+    } else {
+        const char *d = memchr(p, cur->delimiter, (size_t)(end - p));
+        p = d ? d : end;
+        f.len = (size_t)(p - f.ptr);
+    }
+
+    cur->field = (p < end) ? p + 1 : NULL;
+    if (out) *out = f;
+    return true;
+}
+
+bool csv_field_to_double(const CsvField *f, double *out) {
+    const char *p = f->ptr, *e = f->ptr + f->len;
+    while (p < e && (*p == ' ' || *p == '\t')) p++;
+    while (e > p && (e[-1] == ' ' || e[-1] == '\t')) e--;
+    if (p == e) return false;
+
+    // The whole (trimmed) slice must be the number
+    return csv_parse_double(p, e, out) == e;
+}
+
+size_t csv_cursor_skip_fields(CsvCursor *cur, size_t count) {
+    size_t skipped = 0;
+    while (skipped < count && csv_cursor_next_field(cur, NULL)) skipped++;
+    return skipped;
+}
@@ -0,0 +1,93 @@
+#ifndef CSV_MAP_H
+#define CSV_MAP_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// --- Memory-Mapped CSV Input ---
+
+/**
+ * @brief A read-only view of a whole file.
+ * On POSIX systems the file is mmap'd; elsewhere it is read into memory once.
+ * gzip / zstd files are decompressed into memory.
+ */
+typedef struct {
+    const char *data;
+    size_t size;
+    bool mapped;    // true: munmap on close, false: free on close
+} CsvMap;
+
+/**
+ * @brief A field slice pointing straight into the buffer (not NUL-terminated).
+ * For a quoted field the slice excludes the surrounding quotes; embedded
+ * quotes are still doubled ("") and 'quoted' is set so callers can unescape.
+ */
+typedef struct {
+    const char *ptr;
+    size_t len;
+    bool quoted;
+} CsvField;
+
+/**
+ * @brief Reentrant parsing state over any buffer. All state lives here,
+ * so any number of cursors can run at once (also over the same buffer).
+ */
+typedef struct {
+    const char *end;        // One past the last byte of the buffer
+    const char *pos;        // Start of the next record
+    const char *line;       // Current record
+    const char *line_end;   // End of the current record (excludes \r\n)
+    const char *field;      // Next field of the current record, NULL when exhausted
+    long line_number;       // 1-based number of the current record
+    char delimiter;
+} CsvCursor;
+
+/**
+ * @brief Maps a file for reading.
+ * @return Pointer to CsvMap, or NULL on failure (errno describes the error)
+ */
+CsvMap *csv_map_open(const char *filename);
+
+/**
+ * @brief Unmaps the file and frees the CsvMap.
+ */
+void csv_map_close(CsvMap *map);
+
+/**
+ * @brief Starts a cursor at the beginning of 'data' (a mapping or any memory buffer).
+ */
+void csv_cursor_init(CsvCursor *cur, const char *data, size_t size, char delimiter);
+
+/**
+ * @brief Advances to the next record. Newlines inside quoted fields do not end
+ * a record, and there is no limit on record length.
+ * @return true if a record is available, false at the end of the buffer
+ */
+bool csv_cursor_next_line(CsvCursor *cur);
+
+/**
+ * @brief Returns the next field of the current record (empty fields included).
+ * @return true if a field was produced, false when the record is exhausted
+ */
+bool csv_cursor_next_field(CsvCursor *cur, CsvField *out);
+
+/**
+ * @brief Skips 'count' fields without producing slices.
+ * @return Number of fields actually skipped
+ */
+size_t csv_cursor_skip_fields(CsvCursor *cur, size_t count);
+
+/**
+ * @brief Converts a field slice to a double. Surrounding blanks are allowed,
+ * anything else that is not part of the number makes the conversion fail.
+ * @return true on success
+ */
+bool csv_field_to_double(const CsvField *f, double *out);
+
+/**
+ * @brief Scans for the end of the record starting at 'p' (quote-aware).
+ * @return Pointer to the terminating '\n', or 'end' if the buffer ends first
+ */
+const char *csv_record_end(const char *p, const char *end);
+
+#endif // CSV_MAP_H
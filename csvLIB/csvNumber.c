@@ -0,0 +1,484 @@
+#include "csvNumber.h"
+#include <locale.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_MANTISSA_DIGITS 19      // Always fits in a uint64_t
+#define EXACT_MANTISSA (1ull << 53) // Largest integer every double holds exactly
+#define MAX_EXACT_POW10 22          // 10^22 is the largest exact power of ten
+
+static const double exact_pow10[MAX_EXACT_POW10 + 1] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// --- Slow Paths ---
+
+// Correctly rounded conversion of a decimal number we already delimited.
+// strtod expects the locale's decimal point, so '.' is swapped for it.
+static double convert_decimal(const char *start, const char *stop) {
+    const char *point = localeconv()->decimal_point;
+    size_t point_len = strlen(point);
+    size_t len = (size_t)(stop - start);
+    char local[128];
+    char *buf = (len * point_len + 1 <= sizeof(local)) ? local : malloc(len * point_len + 1);
+    if (!buf) return 0.0;
+
+    char *w = buf;
+    for (const char *p = start; p < stop; p++) {
+        if (*p == '.') { memcpy(w, point, point_len); w += point_len; }
+        else *w++ = *p;
+    }
+    *w = '\0';
+    double v = strtod(buf, NULL);
+    if (buf != local) free(buf);
+    return v;
+}
+
+// inf, nan, hex floats: rare enough to go through strtod directly
+static const char *convert_special(const char *start, const char *end, double *out) {
+    char buf[64];
+    size_t len = (size_t)(end - start);
+    if (len >= sizeof(buf)) len = sizeof(buf) - 1;
+    memcpy(buf, start, len);
+    buf[len] = '\0';
+
+    char *stop;
+    double v = strtod(buf, &stop);
+    if (stop == buf) return NULL;
+    *out = v;
+    return start + (stop - buf);
+}
+
+// --- Public API ---
+
+const char *csv_parse_double(const char *p, const char *end, double *out) {
+    const char *start = p;
+    bool neg = false;
+    if (p < end && (*p == '+' || *p == '-')) neg = (*p++ == '-');
+
+    uint64_t mant = 0;
+    int digits = 0, exp10 = 0;
+    bool any = false, truncated = false;
+
+    // Integer part: leading zeros are not significant, digits past 19 only scale
+    for (; p < end && (unsigned)(*p - '0') < 10; p++) {
+        unsigned d = (unsigned)(*p - '0');
+        any = true;
+        if (mant == 0 && d == 0) continue;
+        if (digits < MAX_MANTISSA_DIGITS) { mant = mant * 10 + d; digits++; }
+        else { exp10++; truncated |= (d != 0); }
+    }
+    if (p < end && (*p == 'x' || *p == 'X') && any && mant == 0) {
+        return convert_special(start, end, out);
+    }
+
+    // Fraction
+    if (p < end && *p == '.') {
+        const char *q = p + 1;
+        for (; q < end && (unsigned)(*q - '0') < 10; q++) {
+            unsigned d = (unsigned)(*q - '0');
+            any = true;
+            if (mant == 0 && d == 0) { exp10--; continue; }
+            if (digits < MAX_MANTISSA_DIGITS) { mant = mant * 10 + d; digits++; exp10--; }
+            else truncated |= (d != 0);
+        }
+        if (any) p = q;
+    }
+    if (!any) return convert_special(start, end, out);
+
+    // Exponent: only consumed if at least one digit follows
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char *q = p + 1;
+        bool eneg = false;
+        if (q < end && (*q == '+' || *q == '-')) eneg = (*q++ == '-');
+        if (q < end && (unsigned)(*q - '0') < 10) {
+            int e = 0;
+            for (; q < end && (unsigned)(*q - '0') < 10; q++) {
+                if (e < 100000) e = e * 10 + (*q - '0');
+            }
+            exp10 += eneg ? -e : e;
+            p = q;
+        }
+    }
+
+    double v;
+    if (mant == 0) {
+        v = 0.0;
+    } else if (!truncated && mant <= EXACT_MANTISSA && exp10 >= -MAX_EXACT_POW10 && exp10 <= MAX_EXACT_POW10) {
+        // Both operands exact: one correctly rounded operation
+        v = (exp10 < 0) ? (double)mant / exact_pow10[-exp10] : (double)mant * exact_pow10[exp10];
+    } else if (!truncated && exp10 > MAX_EXACT_POW10 && exp10 <= MAX_EXACT_POW10 + 15
+               && mant <= EXACT_MANTISSA / (uint64_t)exact_pow10[exp10 - MAX_EXACT_POW10]) {
+        // e.g. 12e30: move the excess exponent into the (still exact) mantissa
+        v = (double)(mant * (uint64_t)exact_pow10[exp10 - MAX_EXACT_POW10]) * exact_pow10[MAX_EXACT_POW10];
+    } else {
+        *out = convert_decimal(start, p);
+        return p;
+    }
+
+    *out = neg ? -v : v;
+    return p;
+}
+
+// --- Formatting: Grisu3 Shortest Digits ---
+
+typedef struct {
+    uint64_t f;
+    int e;
+} DiyFp;
+
+typedef struct {
+    uint64_t f;
+    int16_t e;
+    int16_t decimal;
+} CachedPower;
+
+#define SIGNIFICAND_MASK 0x000FFFFFFFFFFFFFull
+#define HIDDEN_BIT 0x0010000000000000ull
+#define EXPONENT_BIAS (0x3FF + 52)
+#define DENORMAL_EXPONENT (1 - EXPONENT_BIAS)
+#define MIN_TARGET_EXPONENT (-60)
+#define MAX_TARGET_EXPONENT (-32)
+#define CACHED_POWERS_OFFSET 348
+#define CACHED_POWERS_STEP 8
+#define MAX_DIGITS 17
+
+// Normalized 64-bit significands of 10^-348, 10^-340, ..., 10^340
+static const CachedPower cached_powers[] = {
+    {0xFA8FD5A0081C0288ull, -1220, -348},
+    {0xBAAEE17FA23EBF76ull, -1193, -340},
+    {0x8B16FB203055AC76ull, -1166, -332},
+    {0xCF42894A5DCE35EAull, -1140, -324},
+    {0x9A6BB0AA55653B2Dull, -1113, -316},
+    {0xE61ACF033D1A45DFull, -1087, -308},
+    {0xAB70FE17C79AC6CAull, -1060, -300},
+    {0xFF77B1FCBEBCDC4Full, -1034, -292},
+    {0xBE5691EF416BD60Cull, -1007, -284},
+    {0x8DD01FAD907FFC3Cull, -980, -276},
+    {0xD3515C2831559A83ull, -954, -268},
+    {0x9D71AC8FADA6C9B5ull, -927, -260},
+    {0xEA9C227723EE8BCBull, -901, -252},
+    {0xAECC49914078536Dull, -874, -244},
+    {0x823C12795DB6CE57ull, -847, -236},
+    {0xC21094364DFB5637ull, -821, -228},
+    {0x9096EA6F3848984Full, -794, -220},
+    {0xD77485CB25823AC7ull, -768, -212},
+    {0xA086CFCD97BF97F4ull, -741, -204},
+    {0xEF340A98172AACE5ull, -715, -196},
+    {0xB23867FB2A35B28Eull, -688, -188},
+    {0x84C8D4DFD2C63F3Bull, -661, -180},
+    {0xC5DD44271AD3CDBAull, -635, -172},
+    {0x936B9FCEBB25C996ull, -608, -164},
+    {0xDBAC6C247D62A584ull, -582, -156},
+    {0xA3AB66580D5FDAF6ull, -555, -148},
+    {0xF3E2F893DEC3F126ull, -529, -140},
+    {0xB5B5ADA8AAFF80B8ull, -502, -132},
+    {0x87625F056C7C4A8Bull, -475, -124},
+    {0xC9BCFF6034C13053ull, -449, -116},
+    {0x964E858C91BA2655ull, -422, -108},
+    {0xDFF9772470297EBDull, -396, -100},
+    {0xA6DFBD9FB8E5B88Full, -369, -92},
+    {0xF8A95FCF88747D94ull, -343, -84},
+    {0xB94470938FA89BCFull, -316, -76},
+    {0x8A08F0F8BF0F156Bull, -289, -68},
+    {0xCDB02555653131B6ull, -263, -60},
+    {0x993FE2C6D07B7FACull, -236, -52},
+    {0xE45C10C42A2B3B06ull, -210, -44},
+    {0xAA242499697392D3ull, -183, -36},
+    {0xFD87B5F28300CA0Eull, -157, -28},
+    {0xBCE5086492111AEBull, -130, -20},
+    {0x8CBCCC096F5088CCull, -103, -12},
+    {0xD1B71758E219652Cull, -77, -4},
+    {0x9C40000000000000ull, -50, 4},
+    {0xE8D4A51000000000ull, -24, 12},
+    {0xAD78EBC5AC620000ull, 3, 20},
+    {0x813F3978F8940984ull, 30, 28},
+    {0xC097CE7BC90715B3ull, 56, 36},
+    {0x8F7E32CE7BEA5C70ull, 83, 44},
+    {0xD5D238A4ABE98068ull, 109, 52},
+    {0x9F4F2726179A2245ull, 136, 60},
+    {0xED63A231D4C4FB27ull, 162, 68},
+    {0xB0DE65388CC8ADA8ull, 189, 76},
+    {0x83C7088E1AAB65DBull, 216, 84},
+    {0xC45D1DF942711D9Aull, 242, 92},
+    {0x924D692CA61BE758ull, 269, 100},
+    {0xDA01EE641A708DEAull, 295, 108},
+    {0xA26DA3999AEF774Aull, 322, 116},
+    {0xF209787BB47D6B85ull, 348, 124},
+    {0xB454E4A179DD1877ull, 375, 132},
+    {0x865B86925B9BC5C2ull, 402, 140},
+    {0xC83553C5C8965D3Dull, 428, 148},
+    {0x952AB45CFA97A0B3ull, 455, 156},
+    {0xDE469FBD99A05FE3ull, 481, 164},
+    {0xA59BC234DB398C25ull, 508, 172},
+    {0xF6C69A72A3989F5Cull, 534, 180},
+    {0xB7DCBF5354E9BECEull, 561, 188},
+    {0x88FCF317F22241E2ull, 588, 196},
+    {0xCC20CE9BD35C78A5ull, 614, 204},
+    {0x98165AF37B2153DFull, 641, 212},
+    {0xE2A0B5DC971F303Aull, 667, 220},
+    {0xA8D9D1535CE3B396ull, 694, 228},
+    {0xFB9B7CD9A4A7443Cull, 720, 236},
+    {0xBB764C4CA7A44410ull, 747, 244},
+    {0x8BAB8EEFB6409C1Aull, 774, 252},
+    {0xD01FEF10A657842Cull, 800, 260},
+    {0x9B10A4E5E9913129ull, 827, 268},
+    {0xE7109BFBA19C0C9Dull, 853, 276},
+    {0xAC2820D9623BF429ull, 880, 284},
+    {0x80444B5E7AA7CF85ull, 907, 292},
+    {0xBF21E44003ACDD2Dull, 933, 300},
+    {0x8E679C2F5E44FF8Full, 960, 308},
+    {0xD433179D9C8CB841ull, 986, 316},
+    {0x9E19DB92B4E31BA9ull, 1013, 324},
+    {0xEB96BF6EBADF77D9ull, 1039, 332},
+    {0xAF87023B9BF0EE6Bull, 1066, 340},
+};
+
+static DiyFp diy_sub(DiyFp a, DiyFp b) {
+    DiyFp r = {a.f - b.f, a.e};
+    return r;
+}
+
+// 64x64 -> upper 64 bits, rounded
+static DiyFp diy_mul(DiyFp x, DiyFp y) {
+    const uint64_t M32 = 0xFFFFFFFFu;
+    uint64_t a = x.f >> 32, b = x.f & M32, c = y.f >> 32, d = y.f & M32;
+    uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & M32) + (bc & M32) + (1u << 31);
+    DiyFp r = {ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64};
+    return r;
+}
+
+static DiyFp diy_normalize(DiyFp x) {
+    while (!(x.f & 0xFFC0000000000000ull)) { x.f <<= 10; x.e -= 10; }
+    while (!(x.f & 0x8000000000000000ull)) { x.f <<= 1; x.e--; }
+    return x;
+}
+
+static DiyFp diy_from_double(uint64_t bits) {
+    int biased = (int)((bits >> 52) & 0x7FF);
+    uint64_t sig = bits & SIGNIFICAND_MASK;
+    DiyFp r;
+    if (biased == 0) { r.f = sig; r.e = DENORMAL_EXPONENT; }
+    else { r.f = sig + HIDDEN_BIT; r.e = biased - EXPONENT_BIAS; }
+    return r;
+}
+
+// Largest power of ten <= number, and its exponent + 1 (0, 0 for number 0)
+static void biggest_pow10(uint32_t number, uint32_t *power, int *exponent_plus_one) {
+    uint64_t p = 1;
+    int e = 0;
+    if (number == 0) { *power = 0; *exponent_plus_one = 0; return; }
+    while (p * 10 <= number) { p *= 10; e++; }
+    *power = (uint32_t)p;
+    *exponent_plus_one = e + 1;
+}
+
+// Moves the last digit towards w while that is safe; false if the result is ambiguous
+static bool round_weed(char *buf, int len, uint64_t dist_high_w, uint64_t unsafe,
+                       uint64_t rest, uint64_t ten_kappa, uint64_t unit) {
+    uint64_t small_dist = dist_high_w - unit;
+    uint64_t big_dist = dist_high_w + unit;
+    while (rest < small_dist && unsafe - rest >= ten_kappa &&
+           (rest + ten_kappa < small_dist || small_dist - rest >= rest + ten_kappa - small_dist)) {
+        buf[len - 1]--;
+        rest += ten_kappa;
+    }
+    if (rest < big_dist && unsafe - rest >= ten_kappa &&
+        (rest + ten_kappa < big_dist || big_dist - rest > rest + ten_kappa - big_dist)) {
+        return false;
+    }
+    return 2 * unit <= rest && rest <= unsafe - 4 * unit;
+}
+
+static bool digit_gen(DiyFp low, DiyFp w, DiyFp high, char *buf, int *len, int *kappa) {
+    uint64_t unit = 1;
+    DiyFp too_low = {low.f - unit, low.e};
+    DiyFp too_high = {high.f + unit, high.e};
+    DiyFp unsafe = diy_sub(too_high, too_low);
+    DiyFp one = {1ull << -w.e, w.e};
+    uint32_t integrals = (uint32_t)(too_high.f >> -one.e);
+    uint64_t fractionals = too_high.f & (one.f - 1);
+    uint32_t divisor;
+    biggest_pow10(integrals, &divisor, kappa);
+    *len = 0;
+
+    while (*kappa > 0) {
+        buf[(*len)++] = (char)('0' + integrals / divisor);
+        integrals %= divisor;
+        (*kappa)--;
+        uint64_t rest = ((uint64_t)integrals << -one.e) + fractionals;
+        if (rest < unsafe.f) {
+            return round_weed(buf, *len, diy_sub(too_high, w).f, unsafe.f, rest,
+                              (uint64_t)divisor << -one.e, unit);
+        }
+        divisor /= 10;
+    }
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe.f *= 10;
+        buf[(*len)++] = (char)('0' + (fractionals >> -one.e));
+        fractionals &= one.f - 1;
+        (*kappa)--;
+        if (fractionals < unsafe.f) {
+            return round_weed(buf, *len, diy_sub(too_high, w).f * unit, unsafe.f, fractionals, one.f, unit);
+        }
+        if (*len >= MAX_DIGITS + 1) return false;
+    }
+}
+
+// Shortest digits of v > 0 (value = digits * 10^*K); 0 if Grisu3 cannot decide
+static int grisu3(double v, char *digits, int *K) {
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    DiyFp w = diy_normalize(diy_from_double(bits));
+
+    // Boundaries halfway to the neighbouring doubles
+    DiyFp raw = diy_from_double(bits);
+    DiyFp plus = diy_normalize((DiyFp){(raw.f << 1) + 1, raw.e - 1});
+    DiyFp minus;
+    bool lower_closer = (bits & SIGNIFICAND_MASK) == 0 && ((bits >> 52) & 0x7FF) > 1;
+    if (lower_closer) { minus.f = (raw.f << 2) - 1; minus.e = raw.e - 2; }
+    else { minus.f = (raw.f << 1) - 1; minus.e = raw.e - 1; }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    // Cached 10^k that brings w's exponent into [MIN_TARGET, MAX_TARGET]
+    int min_exp = MIN_TARGET_EXPONENT - (w.e + 64);
+    int k = (int)ceil((min_exp + 63) * 0.30102999566398114);
+    const CachedPower *c = &cached_powers[(CACHED_POWERS_OFFSET + k - 1) / CACHED_POWERS_STEP + 1];
+    DiyFp ten_k = {c->f, c->e};
+
+    int len, kappa;
+    if (!digit_gen(diy_mul(minus, ten_k), diy_mul(w, ten_k), diy_mul(plus, ten_k), digits, &len, &kappa)) {
+        return 0;
+    }
+    *K = kappa - c->decimal;
+    return len;
+}
+
+// --- Formatting: Fallback And Layout ---
+
+// Digits of v > 0 from "%.*e" (exactly rounded by the C library); the
+// locale's decimal point is skipped, not parsed, so any locale works
+static int printf_digits(double v, int precision, char *digits, int *K) {
+    char buf[40];
+    snprintf(buf, sizeof(buf), "%.*e", precision - 1, v);
+    int n = 0;
+    const char *p = buf;
+    for (; *p && *p != 'e'; p++) {
+        if (*p >= '0' && *p <= '9') digits[n++] = *p;
+    }
+    *K = (*p == 'e' ? atoi(p + 1) : 0) - (n - 1);
+    return n;
+}
+
+static int strip_zeros(const char *digits, int n, int *K) {
+    while (n > 1 && digits[n - 1] == '0') { n--; (*K)++; }
+    return n;
+}
+
+static bool digits_round_trip(double v, const char *digits, int n, int K) {
+    char text[MAX_DIGITS + 8];
+    memcpy(text, digits, (size_t)n);
+    int t = n;
+    text[t++] = 'e';
+    t += snprintf(text + t, sizeof(text) - (size_t)t, "%d", K);
+
+    double back;
+    return csv_parse_double(text, text + t, &back) && back == v;
+}
+
+// Shortest round-trip digits the slow way. Correctly rounded p-digit forms
+// that round-trip keep doing so for every larger p, so binary search on p.
+static int shortest_by_search(double v, char *digits, int *K) {
+    int lo = 1, hi = MAX_DIGITS;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int n = printf_digits(v, mid, digits, K);
+        if (digits_round_trip(v, digits, n, *K)) hi = mid;
+        else lo = mid + 1;
+    }
+    return printf_digits(v, lo, digits, K);
+}
+
+// digits * 10^K in %g layout; 'precision' is the %g switch-over point
+static int layout(bool neg, const char *digits, int n, int K, int precision, char *out) {
+    char *w = out;
+    int x = n + K - 1; // Scientific exponent
+    if (neg) *w++ = '-';
+
+    if (x < -4 || x >= precision) {
+        *w++ = digits[0];
+        if (n > 1) {
+            *w++ = '.';
+            memcpy(w, digits + 1, (size_t)(n - 1));
+            w += n - 1;
+        }
+        *w++ = 'e';
+        *w++ = (x < 0) ? '-' : '+';
+        int ax = (x < 0) ? -x : x;
+        if (ax >= 100) *w++ = (char)('0' + ax / 100);
+        *w++ = (char)('0' + ax / 10 % 10);
+        *w++ = (char)('0' + ax % 10);
+    } else if (K >= 0) {
+        memcpy(w, digits, (size_t)n);
+        w += n;
+        for (int i = 0; i < K; i++) *w++ = '0';
+    } else if (n + K > 0) {
+        memcpy(w, digits, (size_t)(n + K));
+        w += n + K;
+        *w++ = '.';
+        memcpy(w, digits + n + K, (size_t)(-K));
+        w += -K;
+    } else {
+        *w++ = '0';
+        *w++ = '.';
+        for (int i = 0; i < -(n + K); i++) *w++ = '0';
+        memcpy(w, digits, (size_t)n);
+        w += n;
+    }
+    *w = '\0';
+    return (int)(w - out);
+}
+
+int csv_format_double(double v, int precision, char *out) {
+    if (precision < 0 || precision > MAX_DIGITS) precision = 0;
+    bool neg = signbit(v) != 0;
+    double a = neg ? -v : v;
+
+    if (isnan(v)) { memcpy(out, "nan", 4); return 3; }
+    if (isinf(v)) { memcpy(out, neg ? "-inf" : "inf", neg ? 5 : 4); return neg ? 4 : 3; }
+    if (a == 0.0) {
+        char zero = '0';
+        return layout(neg, &zero, 1, 0, MAX_DIGITS, out);
+    }
+
+    char digits[MAX_DIGITS + 2];
+    int K;
+    int n = grisu3(a, digits, &K);
+    if (n == 0 || n > MAX_DIGITS) n = shortest_by_search(a, digits, &K);
+    n = strip_zeros(digits, n, &K);
+
+    if (precision > 0 && n > precision) {
+        if (n == precision + 1 && digits[precision] == '5') {
+            // Tie on the shortest digits: the exact binary value decides
+            n = printf_digits(a, precision, digits, &K);
+        } else {
+            bool up = digits[precision] >= '5';
+            K += n - precision;
+            n = precision;
+            int i = n - 1;
+            while (up && i >= 0 && digits[i] == '9') digits[i--] = '0';
+            if (up && i >= 0) digits[i]++;
+            else if (up) { digits[0] = '1'; K += n; n = 1; } // 99.9 -> 100
+        }
+        n = strip_zeros(digits, n, &K);
+    }
+    return layout(neg, digits, n, K, precision ? precision : MAX_DIGITS, out);
+}
@@ -0,0 +1,36 @@
+#ifndef CSV_NUMBER_H
+#define CSV_NUMBER_H
+
+#include <stdbool.h>
+
+// --- Locale-Independent Number Parsing ---
+
+/**
+ * @brief Parses a decimal floating-point number from [p, end) ('.' is always
+ * the decimal point, whatever the current locale). Accepts an optional sign,
+ * digits with an optional fraction and an optional exponent; inf/nan and
+ * hex forms are handed to strtod.
+ * Mantissas up to 2^53 with |exponent| <= 22 (nearly all CSV data) are
+ * converted in one exact multiply or divide (Clinger's fast path); anything
+ * else falls back to strtod, so every result is correctly rounded.
+ * @return Pointer just past the number, or NULL if no number starts at p
+ */
+const char *csv_parse_double(const char *p, const char *end, double *out);
+
+// --- Locale-Independent Number Formatting ---
+
+#define CSV_DOUBLE_MAX_CHARS 32     // Longest output of csv_format_double, NUL included
+
+/**
+ * @brief Formats a double without printf, in the style of %g ('.' decimal
+ * point, scientific notation below 1e-4 and from 10^precision up).
+ * precision 0 gives the shortest digit string that parses back to exactly
+ * the same double (Grisu3; the rare inputs it cannot decide go through a
+ * verified snprintf search). precision 1..17 rounds to at most that many
+ * significant digits, with trailing zeros dropped like %g.
+ * @param out Buffer of at least CSV_DOUBLE_MAX_CHARS bytes
+ * @return Number of characters written (excluding the NUL)
+ */
+int csv_format_double(double v, int precision, char *out);
+
+#endif // CSV_NUMBER_H
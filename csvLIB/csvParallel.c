@@ -0,0 +1,307 @@
+#include "csvParallel.h"
+#include "csvMap.h"
+#include "csvSchema.h"
+#include "parallel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+CsvParseOptions csv_default_options(void) {
+    CsvParseOptions opts = {',', true, 0, 0, NULL, 0};
+    return opts;
+}
+
+static char *copy_text(const char *text, size_t len) {
+    char *s = malloc(len + 1);
+    if (!s) return NULL;
+    memcpy(s, text, len);
+    s[len] = '\0';
+    return s;
+}
+
+// --- Chunk Work ---
+
+typedef struct {
+    const char *start;
+    const char *end;
+    double *vals;           // Row-major, ncols per row
+    size_t rows;
+    size_t cap;
+    long *errors;           // Local record indices (0-based) of bad rows
+    size_t error_count;
+    size_t error_cap;
+    size_t records;
+    bool oom;
+} Chunk;
+
+typedef struct {
+    const char *body;
+    const char *end;
+    Chunk *chunks;
+    size_t nchunks;
+    unsigned char *quote_parity;
+    size_t ncols;
+    const CsvProjection *proj;
+    char delimiter;
+    CsvTable *table;
+    size_t *row_offset;
+} ParseJob;
+
+static const char *nominal_start(const ParseJob *job, size_t i) {
+    size_t len = (size_t)(job->end - job->body);
+    return job->body + len / job->nchunks * i + (len % job->nchunks) * i / job->nchunks;
+}
+
+static void parity_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    (void)worker;
+    ParseJob *job = (ParseJob *)ctx;
+    for (size_t i = begin; i < end; i++) {
+        const char *p = nominal_start(job, i);
+        const char *stop = (i + 1 < job->nchunks) ? nominal_start(job, i + 1) : job->end;
+        unsigned char parity = 0;
+        while ((p = memchr(p, '"', (size_t)(stop - p))) != NULL) { parity ^= 1; p++; }
+        job->quote_parity[i] = parity;
+    }
+}
+
+// Moves a nominal split point to just after the next record boundary
+static void align_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    (void)worker;
+    ParseJob *job = (ParseJob *)ctx;
+    for (size_t i = begin; i < end; i++) {
+        if (i == 0) { job->chunks[0].start = job->body; continue; }
+
+        bool in_quotes = job->quote_parity[i] != 0; // Prefix parity of everything before
+        const char *p = nominal_start(job, i);
+        while (p < job->end) {
+            if (*p == '"') in_quotes = !in_quotes;
+            else if (*p == '\n' && !in_quotes) { p++; break; }
+            p++;
+        }
+        job->chunks[i].start = p;
+    }
+}
+
+static bool push_error(Chunk *c, long record) {
+    if (c->error_count == c->error_cap) {
+        size_t cap = c->error_cap ? c->error_cap * 2 : 16;
+        long *grown = realloc(c->errors, sizeof(long) * cap);
+        if (!grown) return false;
+        c->errors = grown;
+        c->error_cap = cap;
+    }
+    c->errors[c->error_count++] = record;
+    return true;
+}
+
+static void parse_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    (void)worker;
+    ParseJob *job = (ParseJob *)ctx;
+
+    for (size_t i = begin; i < end; i++) {
+        Chunk *c = &job->chunks[i];
+        if (c->end <= c->start) continue;
+
+        CsvCursor cur;
+        csv_cursor_init(&cur, c->start, (size_t)(c->end - c->start), job->delimiter);
+
+        while (csv_cursor_next_line(&cur)) {
+            c->records++;
+            if (c->rows == c->cap) {
+                size_t cap = c->cap ? c->cap * 2 : 1024;
+                double *grown = realloc(c->vals, sizeof(double) * job->ncols * cap);
+                if (!grown) { c->oom = true; return; }
+                c->vals = grown;
+                c->cap = cap;
+            }
+
+            double *row = c->vals + c->rows * job->ncols;
+            if (csv_projection_read(job->proj, &cur, row)) c->rows++;
+            else if (!push_error(c, (long)c->records - 1)) { c->oom = true; return; }
+        }
+    }
+}
+
+static void stitch_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    (void)worker;
+    ParseJob *job = (ParseJob *)ctx;
+    CsvTable *t = job->table;
+
+    for (size_t i = begin; i < end; i++) {
+        Chunk *c = &job->chunks[i];
+        size_t base = job->row_offset[i];
+        for (size_t r = 0; r < c->rows; r++) {
+            const double *row = c->vals + r * job->ncols;
+            for (size_t col = 0; col < job->ncols; col++) t->columns[col][base + r] = row[col];
+        }
+    }
+}
+
+// --- Public API ---
+
+CsvTable *csv_parse_buffer_parallel(const char *data, size_t size, const CsvParseOptions *opts) {
+    CsvParseOptions o = opts ? *opts : csv_default_options();
+    if (!o.delimiter) o.delimiter = ',';
+
+    CsvTable *t = calloc(1, sizeof(CsvTable));
+    if (!t) return NULL;
+
+    // 1. Columns: by name from the header, or the first max_cols by position
+    CsvCursor cur;
+    CsvField f;
+    CsvProjection proj;
+    csv_cursor_init(&cur, data, size, o.delimiter);
+    if (!csv_cursor_next_line(&cur)) return t; // Empty input: empty table
+
+    bool ok;
+    if (o.columns && o.column_count) {
+        ok = o.has_header && csv_projection_from_header(&proj, cur.line, (size_t)(cur.line_end - cur.line),
+                                                        o.delimiter, o.columns, o.column_count);
+        t->cols = o.column_count;
+    } else {
+        size_t header_cols = 0;
+        CsvCursor probe = cur;
+        while (csv_cursor_next_field(&probe, NULL)) header_cols++;
+        t->cols = (o.max_cols && o.max_cols < header_cols) ? o.max_cols : header_cols;
+
+        size_t *indices = malloc(sizeof(size_t) * (t->cols ? t->cols : 1));
+        for (size_t c = 0; indices && c < t->cols; c++) indices[c] = c;
+        ok = t->cols == 0 || (indices && csv_projection_from_indices(&proj, indices, t->cols, o.delimiter));
+        free(indices);
+    }
+    if (!ok) { csv_table_free(t); return NULL; }
+    if (t->cols == 0) return t;
+
+    if (o.has_header) {
+        t->names = calloc(t->cols, sizeof(char *));
+        if (!t->names) { csv_projection_free(&proj); csv_table_free(t); return NULL; }
+        if (o.columns && o.column_count) {
+            for (size_t c = 0; c < t->cols; c++) t->names[c] = copy_text(o.columns[c], strlen(o.columns[c]));
+        } else {
+            for (size_t c = 0; c < t->cols && csv_cursor_next_field(&cur, &f); c++) {
+                t->names[c] = copy_text(f.ptr, f.len);
+            }
+        }
+    } else {
+        csv_cursor_init(&cur, data, size, o.delimiter); // First record is data
+    }
+
+    // 2. Split the body into byte ranges
+    ParseJob job;
+    memset(&job, 0, sizeof(job));
+    job.body = cur.pos;
+    job.end = data + size;
+    job.ncols = t->cols;
+    job.proj = &proj;
+    job.delimiter = o.delimiter;
+    job.table = t;
+
+    size_t body_len = (size_t)(job.end - job.body);
+    unsigned int threads = parallel_resolve_threads(o.threads);
+    job.nchunks = body_len / CSV_MIN_CHUNK_BYTES;
+    if (job.nchunks > threads) job.nchunks = threads;
+    if (job.nchunks < 1) job.nchunks = 1;
+    if (threads > job.nchunks) threads = (unsigned int)job.nchunks;
+
+    job.chunks = calloc(job.nchunks, sizeof(Chunk));
+    job.quote_parity = calloc(job.nchunks, 1);
+    job.row_offset = calloc(job.nchunks, sizeof(size_t));
+    if (!job.chunks || !job.quote_parity || !job.row_offset) {
+        free(job.chunks); free(job.quote_parity); free(job.row_offset);
+        csv_projection_free(&proj);
+        csv_table_free(t);
+        return NULL;
+    }
+
+    // 3. Quote state at every split point: prefix parity of quote counts
+    parallel_for(job.nchunks, threads, parity_range, &job);
+    unsigned char running = 0;
+    for (size_t i = 0; i < job.nchunks; i++) {
+        unsigned char own = job.quote_parity[i];
+        job.quote_parity[i] = running;
+        running ^= own;
+    }
+
+    // 4. Align every range to a record boundary, then parse the ranges
+    parallel_for(job.nchunks, threads, align_range, &job);
+    for (size_t i = 0; i < job.nchunks; i++) {
+        job.chunks[i].end = (i + 1 < job.nchunks) ? job.chunks[i + 1].start : job.end;
+    }
+    parallel_for(job.nchunks, threads, parse_range, &job);
+
+    // 5. Stitch in order: row offsets, record numbers for errors, column copy
+    long record_base = o.has_header ? 1 : 0;
+    for (size_t i = 0; i < job.nchunks; i++) {
+        Chunk *c = &job.chunks[i];
+        if (c->oom) ok = false;
+        job.row_offset[i] = t->rows;
+        t->rows += c->rows;
+        t->error_count += c->error_count;
+    }
+
+    if (ok && t->error_count > 0) {
+        t->error_lines = malloc(sizeof(long) * t->error_count);
+        ok = (t->error_lines != NULL);
+    }
+    if (ok) {
+        t->storage = malloc(sizeof(double) * (t->rows ? t->rows : 1) * t->cols);
+        t->columns = malloc(sizeof(double *) * t->cols);
+        ok = (t->storage && t->columns);
+    }
+
+    if (ok) {
+        for (size_t c = 0; c < t->cols; c++) t->columns[c] = (double *)t->storage + c * t->rows;
+
+        size_t e = 0;
+        for (size_t i = 0; i < job.nchunks; i++) {
+            Chunk *c = &job.chunks[i];
+            for (size_t k = 0; k < c->error_count; k++) {
+                t->error_lines[e++] = record_base + c->errors[k] + 1;
+            }
+            record_base += (long)c->records;
+        }
+        parallel_for(job.nchunks, threads, stitch_range, &job);
+    }
+
+    for (size_t i = 0; i < job.nchunks; i++) {
+        free(job.chunks[i].vals);
+        free(job.chunks[i].errors);
+    }
+    free(job.chunks);
+    free(job.quote_parity);
+    free(job.row_offset);
+    csv_projection_free(&proj);
+
+    if (!ok) {
+        csv_table_free(t);
+        return NULL;
+    }
+    return t;
+}
+
+CsvTable *csv_parse_parallel(const char *filename, const CsvParseOptions *opts) {
+    CsvMap *map = csv_map_open(filename);
+    if (!map) {
+        perror("Error opening CSV file");
+        return NULL;
+    }
+    CsvTable *t = csv_parse_buffer_parallel(map->data, map->size, opts);
+    csv_map_close(map);
+    return t;
+}
+
+void csv_table_free(CsvTable *table) {
+    if (!table) return;
+    if (table->names) {
+        // Names of a cache-loaded table point into the mapping
+        for (size_t c = 0; !table->map && c < table->cols; c++) free(table->names[c]);
+        free(table->names);
+    }
+    free(table->columns);
+    free(table->storage);
+    free(table->error_lines);
+    csv_map_close(table->map);
+    free(table);
+}
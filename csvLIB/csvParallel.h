@@ -0,0 +1,64 @@
+#ifndef CSV_PARALLEL_H
+#define CSV_PARALLEL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "csvMap.h"
+
+// Files at least this large are parsed with csv_parse_parallel by csv_read_vector_set
+#define CSV_PARALLEL_THRESHOLD (4u << 20)
+
+// Smallest byte range worth handing to its own thread
+#define CSV_MIN_CHUNK_BYTES (256u << 10)
+
+// --- Parsed Numeric Table ---
+
+/**
+ * @brief Column-major numeric table produced by the parallel parser.
+ * Rows that could not be parsed are left out and listed in error_lines.
+ */
+typedef struct {
+    size_t rows;
+    size_t cols;
+    double **columns;       // columns[c][r]
+    char **names;           // Header names (NULL when the file has no header)
+    size_t error_count;
+    long *error_lines;      // Record numbers (1-based, header included) of skipped rows
+    void *storage;          // Owned block behind 'columns'
+    CsvMap *map;            // Binary cache mapping behind 'columns' and 'names' (see csvCache.h)
+} CsvTable;
+
+typedef struct {
+    char delimiter;         // 0 = ','
+    bool has_header;
+    size_t max_cols;        // 0 = every column; otherwise only the first max_cols are read
+    unsigned int threads;   // 0 = default thread count
+    const char *const *columns; // Read only these header columns, in this order (overrides max_cols)
+    size_t column_count;
+} CsvParseOptions;
+
+/**
+ * @brief Default options: ',' delimiter, header present, all columns, default threads.
+ */
+CsvParseOptions csv_default_options(void);
+
+/**
+ * @brief Parses a numeric CSV file on worker threads.
+ * The file is split into byte ranges, each aligned to a record boundary
+ * (quote-aware), parsed into per-chunk buffers and stitched back in order.
+ * Columns that are not selected are skipped without being converted.
+ * @return Table, or NULL if the file cannot be read or a named column is missing
+ */
+CsvTable *csv_parse_parallel(const char *filename, const CsvParseOptions *opts);
+
+/**
+ * @brief Same as csv_parse_parallel over an in-memory buffer.
+ */
+CsvTable *csv_parse_buffer_parallel(const char *data, size_t size, const CsvParseOptions *opts);
+
+/**
+ * @brief Frees the table and everything it owns.
+ */
+void csv_table_free(CsvTable *table);
+
+#endif // CSV_PARALLEL_H
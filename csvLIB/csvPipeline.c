@@ -0,0 +1,414 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "csvPipeline.h"
+#include "csvCompress.h"
+#include "csvMap.h"
+#include "csvNumber.h"
+#include "parallel.h"
+#include "ringQueue.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DEFAULT_BATCH_ROWS 1024
+#define DEFAULT_QUEUE_DEPTH 4
+#define MAX_RESULT_CHARS (3 * CSV_DOUBLE_MAX_CHARS) // Worst case for one result row
+
+// --- Batches ---
+
+typedef struct {
+    size_t seq;
+    bool done;              // End-of-stream marker
+    long first_line;        // Input line number of the first row
+    size_t rows;
+    char *text;             // Raw rows, '\n' separated
+    size_t text_len;
+    size_t text_cap;
+    char *result;           // Formatted output rows
+    size_t result_len;
+    size_t result_cap;
+    long *bad_lines;
+    size_t bad_count;
+    bool from_cache;        // Results were read from the result cache
+} PipeBatch;
+
+// Everything besides the input bytes that shapes a batch's results (result cache key)
+typedef struct {
+    int32_t op;
+    int32_t fields_per_vector;
+    int32_t precision;
+    int32_t reserved;
+    double k;
+    double plane_n[3];
+    double plane_p[3];
+} CacheParams;
+
+typedef struct {
+    PipelineOptions opts;
+    double plane_n[3];
+    double plane_p[3];
+    CacheParams cache_params;
+    unsigned int workers;
+    RingQueue free_q;       // writer -> reader
+    RingQueue *in_q;        // reader -> worker w
+    RingQueue *out_q;       // worker w -> writer
+    FILE *out;
+    PipelineStats stats;
+    bool write_failed;
+} Pipeline;
+
+typedef struct {
+    Pipeline *pipe;
+    unsigned int id;
+} WorkerArg;
+
+static bool reserve(char **buf, size_t *cap, size_t need) {
+    if (need <= *cap) return true;
+    size_t cap2 = *cap ? *cap : 4096;
+    while (cap2 < need) cap2 *= 2;
+    char *grown = realloc(*buf, cap2);
+    if (!grown) return false;
+    *buf = grown;
+    *cap = cap2;
+    return true;
+}
+
+static void free_batch(PipeBatch *b) {
+    if (!b) return;
+    free(b->text);
+    free(b->result);
+    free(b->bad_lines);
+    free(b);
+}
+
+// --- Compute Stage ---
+
+static size_t vectors_needed(PipelineOp op) {
+    return (op == PIPE_TRIPLE_PRODUCT) ? 3 : (op == PIPE_CROSS_PRODUCT) ? 2 : 1;
+}
+
+// Reads 'count' vectors (x, y, z [, mag]) from the cursor's current record
+static bool read_row_vectors(Pipeline *p, CsvCursor *cur, double v[3][3], size_t count) {
+    CsvField f;
+    for (size_t i = 0; i < count; i++) {
+        for (int k = 0; k < 3; k++) {
+            if (!csv_cursor_next_field(cur, &f) || !csv_field_to_double(&f, &v[i][k])) return false;
+        }
+        if (p->opts.fields_per_vector == 4 && !csv_cursor_next_field(cur, NULL)) return false;
+    }
+    return true;
+}
+
+static void compute_rows(Pipeline *p, PipeBatch *b) {
+    const int prec = p->opts.precision;
+    const size_t need = vectors_needed(p->opts.op);
+    CsvCursor cur;
+    csv_cursor_init(&cur, b->text, b->text_len, ',');
+
+    b->result_len = 0;
+    b->bad_count = 0;
+    if (!reserve(&b->result, &b->result_cap, b->rows * MAX_RESULT_CHARS + 1)) {
+        b->bad_count = (size_t)-1; // Reported as an allocation failure by the writer
+        return;
+    }
+
+    for (size_t r = 0; csv_cursor_next_line(&cur); r++) {
+        double v[3][3];
+        char *dst = b->result + b->result_len;
+        int n = 0;
+
+        if (!read_row_vectors(p, &cur, v, need)) {
+            b->bad_lines[b->bad_count++] = b->first_line + (long)r;
+            continue;
+        }
+
+        switch (p->opts.op) {
+            case PIPE_TRIPLE_PRODUCT: {
+                // Same formula as volumeParallelepiped, without the heap vectors
+                double cx = v[1][1] * v[2][2] - v[1][2] * v[2][1];
+                double cy = v[1][2] * v[2][0] - v[1][0] * v[2][2];
+                double cz = v[1][0] * v[2][1] - v[1][1] * v[2][0];
+                double vol = v[0][0] * cx + v[0][1] * cy + v[0][2] * cz;
+                double k = p->opts.k;
+                n = csv_format_double(fabs(vol) / (k > EPSILON ? k : 1.0), prec, dst);
+                break;
+            }
+            case PIPE_CROSS_PRODUCT:
+                n = csv_format_double(v[0][1] * v[1][2] - v[0][2] * v[1][1], prec, dst);
+                dst[n++] = ',';
+                n += csv_format_double(v[0][2] * v[1][0] - v[0][0] * v[1][2], prec, dst + n);
+                dst[n++] = ',';
+                n += csv_format_double(v[0][0] * v[1][1] - v[0][1] * v[1][0], prec, dst + n);
+                break;
+            case PIPE_PLANE_DISTANCE: {
+                double d = 0.0;
+                for (int k = 0; k < 3; k++) d += (v[0][k] - p->plane_p[k]) * p->plane_n[k];
+                n = csv_format_double(fabs(d), prec, dst);
+                break;
+            }
+        }
+        dst[n++] = '\n';
+        b->result_len += (size_t)n;
+    }
+}
+
+// Copies a cached result into the batch; false if it does not fit the batch
+static bool restore_batch(PipeBatch *b, const CsvResultEntry *e) {
+    if (e->bad_count > b->rows || !reserve(&b->result, &b->result_cap, e->len + 1)) return false;
+    for (size_t i = 0; i < e->bad_count; i++) {
+        if (e->bad_rows[i] >= b->rows) return false;
+        b->bad_lines[i] = b->first_line + (long)e->bad_rows[i];
+    }
+    memcpy(b->result, e->data, e->len);
+    b->result_len = e->len;
+    b->bad_count = e->bad_count;
+    return true;
+}
+
+static void store_batch(Pipeline *p, const PipeBatch *b, CsvResultKey key) {
+    uint32_t *rel = b->bad_count ? malloc(sizeof(uint32_t) * b->bad_count) : NULL;
+    if (b->bad_count && !rel) return;
+    for (size_t i = 0; i < b->bad_count; i++) rel[i] = (uint32_t)(b->bad_lines[i] - b->first_line);
+    csv_result_cache_put(p->opts.cache, key, b->result, b->result_len, rel, b->bad_count);
+    free(rel);
+}
+
+static void compute_batch(Pipeline *p, PipeBatch *b) {
+    b->from_cache = false;
+    if (!p->opts.cache) {
+        compute_rows(p, b);
+        return;
+    }
+
+    CsvResultKey key = csv_result_key(b->text, b->text_len, &p->cache_params, sizeof(p->cache_params));
+    CsvResultEntry entry;
+    if (csv_result_cache_get(p->opts.cache, key, &entry)) {
+        b->from_cache = restore_batch(b, &entry);
+        csv_result_entry_free(&entry);
+        if (b->from_cache) return;
+    }
+    compute_rows(p, b);
+    if (b->bad_count != (size_t)-1) store_batch(p, b, key);
+}
+
+static void *worker_main(void *arg) {
+    WorkerArg *w = (WorkerArg *)arg;
+    Pipeline *p = w->pipe;
+
+    for (;;) {
+        PipeBatch *b = ring_pop(&p->in_q[w->id]);
+        if (!b->done) compute_batch(p, b);
+        ring_push(&p->out_q[w->id], b);
+        if (b->done) break;
+    }
+    return NULL;
+}
+
+// --- Writer Stage ---
+
+static const char *result_header(PipelineOp op) {
+    return (op == PIPE_TRIPLE_PRODUCT) ? "VOLUME\n" : (op == PIPE_CROSS_PRODUCT) ? "X,Y,Z\n" : "DISTANCE\n";
+}
+
+static void *writer_main(void *arg) {
+    Pipeline *p = (Pipeline *)arg;
+    if (!p->opts.append && fputs(result_header(p->opts.op), p->out) == EOF) p->write_failed = true;
+
+    // Batches were dealt round-robin, so batch 'seq' comes back from worker seq % W
+    for (size_t seq = 0;; seq++) {
+        PipeBatch *b = ring_pop(&p->out_q[seq % p->workers]);
+        if (b->done) break;
+
+        if (b->bad_count == (size_t)-1) {
+            fprintf(stderr, "Warning: Out of memory, skipping lines %ld-%ld.\n",
+                    b->first_line, b->first_line + (long)b->rows - 1);
+            p->stats.rows_bad += b->rows;
+        } else {
+            for (size_t i = 0; i < b->bad_count; i++) {
+                fprintf(stderr, "Warning: Skipping badly formatted line %ld.\n", b->bad_lines[i]);
+            }
+            p->stats.rows_bad += b->bad_count;
+            p->stats.rows_out += b->rows - b->bad_count;
+            if (b->from_cache) p->stats.rows_cached += b->rows;
+            if (b->result_len && fwrite(b->result, 1, b->result_len, p->out) != b->result_len) {
+                p->write_failed = true;
+            }
+        }
+        ring_push(&p->free_q, b);
+    }
+    return NULL;
+}
+
+// --- Reader Stage & Setup ---
+
+// FNV-1a over the line without its ending
+static uint64_t line_fingerprint(const char *line, size_t n) {
+    while (n > 0 && (line[n - 1] == '\n' || line[n - 1] == '\r')) n--;
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < n; i++) h = (h ^ (unsigned char)line[i]) * 0x100000001B3ull;
+    return h >> 16;
+}
+
+PipelineOptions csv_pipeline_default_options(void) {
+    PipelineOptions o;
+    memset(&o, 0, sizeof(o));
+    o.op = PIPE_TRIPLE_PRODUCT;
+    o.k = 1.0;
+    o.fields_per_vector = 4;
+    o.has_header = true;
+    return o;
+}
+
+bool csv_pipeline_run(FILE *in, FILE *out, const PipelineOptions *opts, PipelineStats *stats) {
+    Pipeline p;
+    memset(&p, 0, sizeof(p));
+    p.opts = opts ? *opts : csv_pipeline_default_options();
+    p.out = out;
+    if (!in || !out) return false;
+    if (p.opts.fields_per_vector != 3 && p.opts.fields_per_vector != 4) return false;
+    if (p.opts.op == PIPE_PLANE_DISTANCE) {
+        const plain *pl = p.opts.plane;
+        if (!pl || !pl->normal || !pl->point || pl->normal->dim != 3 || pl->point->dim != 3) return false;
+        double len = sqrt(scalaricProduct(pl->normal, pl->normal));
+        if (len < EPSILON) return false;
+        for (int k = 0; k < 3; k++) {
+            p.plane_n[k] = pl->normal->val[k] / len;
+            p.plane_p[k] = pl->point->val[k];
+        }
+    }
+    if (p.opts.batch_rows == 0) p.opts.batch_rows = DEFAULT_BATCH_ROWS;
+    if (p.opts.queue_depth == 0) p.opts.queue_depth = DEFAULT_QUEUE_DEPTH;
+    if (p.opts.precision < 0 || p.opts.precision > 17) p.opts.precision = 0;
+    p.workers = parallel_resolve_threads(p.opts.workers);
+
+    p.cache_params.op = (int32_t)p.opts.op;
+    p.cache_params.fields_per_vector = (int32_t)p.opts.fields_per_vector;
+    p.cache_params.precision = p.opts.precision;
+    p.cache_params.k = (p.opts.op == PIPE_TRIPLE_PRODUCT) ? p.opts.k : 0.0;
+    memcpy(p.cache_params.plane_n, p.plane_n, sizeof(p.plane_n));
+    memcpy(p.cache_params.plane_p, p.plane_p, sizeof(p.plane_p));
+
+    // Content-defined batch ends: a line whose fingerprint hits 1 in cut_every ends the batch
+    const bool content_cuts = p.opts.cache != NULL;
+    const size_t min_rows = p.opts.batch_rows / 4 + 1;
+    const uint64_t cut_every = p.opts.batch_rows / 2 + 1;
+
+    // Every batch in flight: queued for / held by a worker, plus reader and writer
+    size_t depth = p.opts.queue_depth;
+    size_t total = p.workers * (2 * depth + 1) + 2;
+
+    p.in_q = calloc(p.workers, sizeof(RingQueue));
+    p.out_q = calloc(p.workers, sizeof(RingQueue));
+    PipeBatch **all = calloc(total + p.workers, sizeof(PipeBatch *));
+    WorkerArg *args = calloc(p.workers, sizeof(WorkerArg));
+    pthread_t *ids = calloc(p.workers, sizeof(pthread_t));
+    bool ok = p.in_q && p.out_q && all && args && ids && ring_init(&p.free_q, total);
+
+    for (unsigned int w = 0; ok && w < p.workers; w++) {
+        ok = ring_init(&p.in_q[w], depth + 1) && ring_init(&p.out_q[w], depth + 1);
+    }
+    for (size_t i = 0; ok && i < total + p.workers; i++) {
+        all[i] = calloc(1, sizeof(PipeBatch));
+        ok = all[i] && (all[i]->bad_lines = malloc(sizeof(long) * p.opts.batch_rows)) != NULL;
+        if (ok && i < total) ring_push(&p.free_q, all[i]);
+        else if (ok) all[i]->done = true; // One end marker per worker
+    }
+
+    // Start workers and writer
+    pthread_t writer;
+    unsigned int started = 0;
+    bool writer_started = false;
+    for (; ok && started < p.workers; started++) {
+        args[started].pipe = &p;
+        args[started].id = started;
+        if (pthread_create(&ids[started], NULL, worker_main, &args[started]) != 0) ok = false;
+        if (!ok) break;
+    }
+    if (ok) writer_started = ok = (pthread_create(&writer, NULL, writer_main, &p) == 0);
+
+    // Reader: fill batches with whole lines, deal them round-robin
+    char *line = NULL;
+    size_t line_cap = 0;
+    long line_number = p.opts.line_base;
+    size_t seq = 0;
+    if (ok && p.opts.has_header && getline(&line, &line_cap, in) > 0) line_number++;
+
+    while (ok) {
+        PipeBatch *b = ring_pop(&p.free_q);
+        b->seq = seq;
+        b->rows = 0;
+        b->text_len = 0;
+        b->first_line = line_number + 1;
+
+        ssize_t n = 0;
+        while (b->rows < p.opts.batch_rows && (n = getline(&line, &line_cap, in)) > 0) {
+            line_number++;
+            if (!reserve(&b->text, &b->text_cap, b->text_len + (size_t)n + 1)) { ok = false; break; }
+            memcpy(b->text + b->text_len, line, (size_t)n);
+            b->text_len += (size_t)n;
+            if (line[n - 1] != '\n') b->text[b->text_len++] = '\n';
+            b->rows++;
+            if (content_cuts && b->rows >= min_rows && line_fingerprint(line, (size_t)n) % cut_every == 0) break;
+        }
+
+        if (b->rows == 0) {
+            ring_push(&p.free_q, b); // Nothing left: recycle the empty batch
+            break;
+        }
+        p.stats.rows_in += b->rows;
+        ring_push(&p.in_q[seq % p.workers], b);
+        seq++;
+        if (n <= 0) break;
+    }
+    free(line);
+
+    // Shut down: one end marker per started worker, queued behind its last batch
+    for (unsigned int w = 0; w < started; w++) ring_push(&p.in_q[w], all[total + w]);
+    for (unsigned int w = 0; w < started; w++) pthread_join(ids[w], NULL);
+    if (writer_started) pthread_join(writer, NULL);
+
+    // Cleanup
+    for (size_t i = 0; all && i < total + p.workers; i++) free_batch(all[i]);
+    for (unsigned int w = 0; p.in_q && p.out_q && w < p.workers; w++) {
+        ring_destroy(&p.in_q[w]);
+        ring_destroy(&p.out_q[w]);
+    }
+    ring_destroy(&p.free_q);
+    free(p.in_q);
+    free(p.out_q);
+    free(all);
+    free(args);
+    free(ids);
+
+    if (fflush(out) != 0) p.write_failed = true;
+    if (stats) *stats = p.stats;
+    return ok && !p.write_failed;
+}
+
+bool csv_pipeline_run_file(const char *in_path, const char *out_path,
+                           const PipelineOptions *opts, PipelineStats *stats) {
+    if (!in_path || !out_path) return false;
+
+    bool from_stdin = strcmp(in_path, "-") == 0;
+    CsvStream *stream = from_stdin ? NULL : csv_stream_open(in_path);
+    FILE *in = from_stdin ? stdin : csv_stream_file(stream);
+    if (!in) {
+        perror("Error opening CSV file");
+        return false;
+    }
+    FILE *out = strcmp(out_path, "-") == 0 ? stdout : fopen(out_path, "w");
+    if (!out) {
+        perror("Error opening output file");
+        csv_stream_close(stream);
+        return false;
+    }
+
+    bool ok = csv_pipeline_run(in, out, opts, stats);
+
+    if (stream && !csv_stream_close(stream)) {
+        fprintf(stderr, "Warning: %s is corrupt or truncated.\n", in_path);
+        ok = false;
+    }
+    if (out != stdout && fclose(out) != 0) ok = false;
+    return ok;
+}
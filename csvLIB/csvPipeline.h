@@ -0,0 +1,64 @@
+#ifndef CSV_PIPELINE_H
+#define CSV_PIPELINE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "vectorOps.h"
+#include "csvResultCache.h"
+
+// --- Streaming Read -> Compute -> Write ---
+
+typedef enum {
+    PIPE_TRIPLE_PRODUCT = 0,    // |V1 . (V2 x V3)| / k          -> VOLUME
+    PIPE_CROSS_PRODUCT,         // V1 x V2                       -> X,Y,Z
+    PIPE_PLANE_DISTANCE         // distance of point V1 to plane -> DISTANCE
+} PipelineOp;
+
+typedef struct {
+    PipelineOp op;
+    double k;                       // PIPE_TRIPLE_PRODUCT divisor (1 = parallelepiped, 6 = pyramid)
+    const plain *plane;             // PIPE_PLANE_DISTANCE target (normal need not be unit)
+    unsigned int fields_per_vector; // 4 = X,Y,Z,MAG (test file layout), 3 = X,Y,Z
+    bool has_header;                // Skip the first input line
+    unsigned int workers;           // Compute threads (0 = default thread count)
+    size_t batch_rows;              // Rows per batch (0 = 1024)
+    size_t queue_depth;             // Batches queued per worker (0 = 4)
+    int precision;                  // Significant digits in the output (0 = shortest round-trip)
+    long line_base;                 // Lines before the input (numbers warnings for a file read piecewise)
+    bool append;                    // Output continues earlier results: no result header
+    CsvResultCache *cache;          // Reuse the results of unchanged chunks (NULL = off)
+} PipelineOptions;
+
+typedef struct {
+    size_t rows_in;     // Data rows read
+    size_t rows_out;    // Result rows written
+    size_t rows_bad;    // Rows skipped (reported on stderr with their line number)
+    size_t rows_cached; // Rows whose results came from the result cache
+} PipelineStats;
+
+/**
+ * @brief Default options: triple product with k = 1, 13-column test layout, header present.
+ */
+PipelineOptions csv_pipeline_default_options(void);
+
+/**
+ * @brief Streams every row of 'in' through the chosen operation into 'out'.
+ * A reader stage (calling thread) fills fixed-size batches, compute workers
+ * parse and evaluate them, and a writer stage emits results in input order.
+ * Stages are connected by bounded lock-free queues, so memory stays flat
+ * for unbounded inputs and a slow stage back-pressures the others.
+ * With a result cache, batches end at content-defined line boundaries, so an
+ * edit only changes the keys of the batches around it and every other batch
+ * is answered from the cache.
+ * @return false on bad options or allocation failure
+ */
+bool csv_pipeline_run(FILE *in, FILE *out, const PipelineOptions *opts, PipelineStats *stats);
+
+/**
+ * @brief File wrapper around csv_pipeline_run ("-" means stdin / stdout).
+ */
+bool csv_pipeline_run_file(const char *in_path, const char *out_path,
+                           const PipelineOptions *opts, PipelineStats *stats);
+
+#endif // CSV_PIPELINE_H
@@ -0,0 +1,218 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "csvResultCache.h"
+#include "universal.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t bad_count;
+    uint64_t key_lo;
+    uint64_t key_hi;
+    uint64_t len;           // Result bytes
+    uint64_t check;         // Hash of everything after the header
+} EntryHeader;
+
+typedef char entry_header_size_check[(sizeof(EntryHeader) == 48) ? 1 : -1];
+
+// --- Key Hash ---
+
+// Two independent word-at-a-time lanes (multiply-rotate rounds, murmur finaliser)
+#define LANE_P1 0x9E3779B185EBCA87ull
+#define LANE_P2 0xC2B2AE3D27D4EB4Full
+#define LANE_P3 0x165667B19E3779F9ull
+
+typedef struct {
+    uint64_t a, b;
+    uint64_t total;
+} KeyHash;
+
+static uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+static uint64_t fmix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    return h ^ (h >> 33);
+}
+
+static void key_word(KeyHash *s, uint64_t w) {
+    s->a = rotl64(s->a ^ (w * LANE_P2), 31) * LANE_P1;
+    s->b = rotl64(s->b ^ (w * LANE_P3), 27) * LANE_P2;
+}
+
+static void key_bytes(KeyHash *s, const void *data, size_t n) {
+    const unsigned char *p = (const unsigned char *)data;
+    s->total += n;
+    for (; n >= 8; p += 8, n -= 8) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        key_word(s, w);
+    }
+    if (n > 0) {
+        uint64_t w = 0;
+        memcpy(&w, p, n);
+        key_word(s, w ^ ((uint64_t)n << 56)); // Each part padded separately: boundaries count
+    }
+}
+
+CsvResultKey csv_result_key(const void *data, size_t len, const void *params, size_t params_len) {
+    KeyHash s = {LANE_P1, LANE_P3, 0};
+    key_bytes(&s, data, len);
+    key_word(&s, len);
+    if (params) key_bytes(&s, params, params_len);
+    key_bytes(&s, CALC_LIB_VERSION, sizeof(CALC_LIB_VERSION));
+
+    CsvResultKey k;
+    k.lo = fmix64(s.a ^ s.total);
+    k.hi = fmix64(s.b + s.total * LANE_P1);
+    return k;
+}
+
+// --- Directory ---
+
+// mkdir -p
+static bool make_dirs(const char *path) {
+    char *tmp = strdup(path);
+    bool ok = tmp != NULL;
+    for (char *p = tmp ? strchr(tmp + 1, '/') : NULL; ok && p; p = strchr(p + 1, '/')) {
+        *p = '\0';
+        if (mkdir(tmp, 0777) != 0 && errno != EEXIST) ok = false;
+        *p = '/';
+    }
+    if (ok && mkdir(path, 0777) != 0 && errno != EEXIST) ok = false;
+    free(tmp);
+    return ok;
+}
+
+CsvResultCache *csv_result_cache_open(const char *dir) {
+    if (!dir || !*dir || !make_dirs(dir)) return NULL;
+    CsvResultCache *c = calloc(1, sizeof(CsvResultCache));
+    if (!c) return NULL;
+    c->dir = strdup(dir);
+    if (!c->dir) {
+        free(c);
+        return NULL;
+    }
+    return c;
+}
+
+void csv_result_cache_close(CsvResultCache *cache) {
+    if (!cache) return;
+    free(cache->dir);
+    free(cache);
+}
+
+// <dir>/<2 hex>/<30 hex>; with_sub = false stops after the subdirectory
+static char *entry_path(const CsvResultCache *c, CsvResultKey key, bool with_sub) {
+    char hex[33];
+    snprintf(hex, sizeof(hex), "%016llx%016llx", (unsigned long long)key.hi, (unsigned long long)key.lo);
+    size_t len = strlen(c->dir) + 36;
+    char *path = malloc(len);
+    if (!path) return NULL;
+    if (with_sub) snprintf(path, len, "%s/%.2s/%s", c->dir, hex, hex + 2);
+    else snprintf(path, len, "%s/%.2s", c->dir, hex);
+    return path;
+}
+
+// --- Lookup & Store ---
+
+bool csv_result_cache_get(CsvResultCache *cache, CsvResultKey key, CsvResultEntry *entry) {
+    if (!cache || !entry) return false;
+    memset(entry, 0, sizeof(*entry));
+
+    char *path = entry_path(cache, key, true);
+    FILE *f = path ? fopen(path, "rb") : NULL;
+    free(path);
+
+    EntryHeader h;
+    bool ok = f && fread(&h, sizeof(h), 1, f) == 1 &&
+              memcmp(h.magic, CSV_RESULT_CACHE_MAGIC, 8) == 0 && h.version == CSV_RESULT_CACHE_VERSION &&
+              h.key_lo == key.lo && h.key_hi == key.hi && h.len < ((uint64_t)1 << 40);
+
+    size_t payload = 0;
+    char *block = NULL;
+    if (ok) {
+        payload = sizeof(uint32_t) * h.bad_count + (size_t)h.len;
+        block = malloc(payload + 1);
+        ok = block && fread(block, 1, payload, f) == payload && fgetc(f) == EOF &&
+             csv_result_key(block, payload, NULL, 0).lo == h.check;
+    }
+    if (f) fclose(f);
+
+    if (!ok) {
+        free(block);
+        __atomic_fetch_add(&cache->misses, 1, __ATOMIC_RELAXED);
+        return false;
+    }
+    entry->block = block;
+    entry->bad_rows = (uint32_t *)block;
+    entry->bad_count = h.bad_count;
+    entry->data = block + sizeof(uint32_t) * h.bad_count;
+    entry->len = (size_t)h.len;
+    __atomic_fetch_add(&cache->hits, 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+bool csv_result_cache_put(CsvResultCache *cache, CsvResultKey key, const char *data, size_t len,
+                          const uint32_t *bad_rows, size_t bad_count) {
+    if (!cache || (len && !data) || (bad_count && !bad_rows)) return false;
+
+    char *sub = entry_path(cache, key, false);
+    char *path = entry_path(cache, key, true);
+    bool ok = sub && path && (mkdir(sub, 0777) == 0 || errno == EEXIST);
+
+    // Unique temporary name: several threads or processes may store at once
+    static unsigned long counter;
+    char *tmp = ok ? malloc(strlen(path) + 48) : NULL;
+    if (tmp) {
+        sprintf(tmp, "%s.%ld.%lu.tmp", path, (long)getpid(), __atomic_fetch_add(&counter, 1, __ATOMIC_RELAXED));
+    }
+
+    EntryHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CSV_RESULT_CACHE_MAGIC, 8);
+    h.version = CSV_RESULT_CACHE_VERSION;
+    h.bad_count = (uint32_t)bad_count;
+    h.key_lo = key.lo;
+    h.key_hi = key.hi;
+    h.len = len;
+
+    // The check hash covers bad rows then data, exactly as they sit in the file
+    size_t payload = sizeof(uint32_t) * bad_count + len;
+    char *block = tmp ? malloc(payload + 1) : NULL;
+    if (block) {
+        if (bad_count) memcpy(block, bad_rows, sizeof(uint32_t) * bad_count);
+        if (len) memcpy(block + sizeof(uint32_t) * bad_count, data, len);
+        h.check = csv_result_key(block, payload, NULL, 0).lo;
+    }
+
+    FILE *f = block ? fopen(tmp, "wb") : NULL;
+    ok = f && fwrite(&h, sizeof(h), 1, f) == 1 && fwrite(block, 1, payload, f) == payload;
+    if (f && fclose(f) != 0) ok = false;
+    if (ok && rename(tmp, path) != 0) ok = false;
+    if (!ok && f) remove(tmp);
+    if (ok) __atomic_fetch_add(&cache->stores, 1, __ATOMIC_RELAXED);
+
+    free(block);
+    free(tmp);
+    free(path);
+    free(sub);
+    return ok;
+}
+
+void csv_result_entry_free(CsvResultEntry *entry) {
+    if (!entry) return;
+    free(entry->block);
+    memset(entry, 0, sizeof(*entry));
+}
@@ -0,0 +1,74 @@
+#ifndef CSV_RESULT_CACHE_H
+#define CSV_RESULT_CACHE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// --- Content-Addressed Result Cache ---
+//
+// One file per entry: <dir>/<first 2 hex digits of the key>/<rest of the key>.
+// An entry is a fixed header, the relative indices of the rows that failed
+// to parse, and the formatted result bytes. Entries are written atomically
+// (temporary file + rename), so concurrent runs can share a directory.
+
+#define CSV_RESULT_CACHE_MAGIC "CALCRES"   // 7 chars + NUL
+#define CSV_RESULT_CACHE_VERSION 1
+
+/**
+ * @brief 128-bit key: a fast hash of the input bytes and the parameters that
+ * shaped the result. Two independent 64-bit lanes, so a stale hit needs both
+ * to collide.
+ */
+typedef struct {
+    uint64_t lo;
+    uint64_t hi;
+} CsvResultKey;
+
+typedef struct {
+    char *dir;
+    size_t hits;            // Updated atomically; safe to share between threads
+    size_t misses;
+    size_t stores;
+} CsvResultCache;
+
+/**
+ * @brief Stored result of one input chunk (free with csv_result_entry_free).
+ */
+typedef struct {
+    char *data;             // Result bytes
+    size_t len;
+    uint32_t *bad_rows;     // Indices (within the chunk) of rows that were skipped
+    size_t bad_count;
+    void *block;            // Owned allocation behind data and bad_rows
+} CsvResultEntry;
+
+/**
+ * @brief Opens (creating if needed) a cache directory.
+ * @return Cache, or NULL if the directory cannot be created
+ */
+CsvResultCache *csv_result_cache_open(const char *dir);
+
+void csv_result_cache_close(CsvResultCache *cache);
+
+/**
+ * @brief Key of 'data' computed with 'params' (raw bytes; zero any padding).
+ * The library version is always part of the key.
+ */
+CsvResultKey csv_result_key(const void *data, size_t len, const void *params, size_t params_len);
+
+/**
+ * @brief Looks up a key.
+ * @return true and fills 'entry' on a hit; false if absent or unreadable
+ */
+bool csv_result_cache_get(CsvResultCache *cache, CsvResultKey key, CsvResultEntry *entry);
+
+/**
+ * @brief Stores a result under 'key' (replacing any older entry).
+ */
+bool csv_result_cache_put(CsvResultCache *cache, CsvResultKey key, const char *data, size_t len,
+                          const uint32_t *bad_rows, size_t bad_count);
+
+void csv_result_entry_free(CsvResultEntry *entry);
+
+#endif // CSV_RESULT_CACHE_H
@@ -0,0 +1,116 @@
+#include "csvSchema.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- Helpers ---
+
+static bool build_slots(CsvProjection *proj) {
+    proj->last = 0;
+    for (size_t i = 0; i < proj->count; i++) {
+        if (proj->source[i] > proj->last) proj->last = proj->source[i];
+    }
+
+    proj->slot = malloc(sizeof(int) * (proj->last + 1));
+    if (!proj->slot) return false;
+    for (size_t f = 0; f <= proj->last; f++) proj->slot[f] = -1;
+    for (size_t i = 0; i < proj->count; i++) {
+        if (proj->slot[proj->source[i]] != -1) return false; // Same field twice
+        proj->slot[proj->source[i]] = (int)i;
+    }
+    return true;
+}
+
+// Header field equals 'name', ignoring case and surrounding blanks
+static bool name_matches(const CsvField *f, const char *name) {
+    const char *p = f->ptr, *e = f->ptr + f->len;
+    while (p < e && (*p == ' ' || *p == '\t')) p++;
+    while (e > p && (e[-1] == ' ' || e[-1] == '\t')) e--;
+
+    size_t len = strlen(name);
+    if ((size_t)(e - p) != len) return false;
+    for (size_t i = 0; i < len; i++) {
+        if (tolower((unsigned char)p[i]) != tolower((unsigned char)name[i])) return false;
+    }
+    return true;
+}
+
+// --- Construction ---
+
+bool csv_projection_from_indices(CsvProjection *proj, const size_t indices[], size_t count, char delimiter) {
+    if (!proj) return false;
+    memset(proj, 0, sizeof(*proj));
+    proj->delimiter = delimiter ? delimiter : ',';
+    proj->count = count;
+    if (count == 0) return false;
+
+    proj->source = malloc(sizeof(size_t) * count);
+    if (!proj->source) return false;
+    memcpy(proj->source, indices, sizeof(size_t) * count);
+
+    if (!build_slots(proj)) {
+        csv_projection_free(proj);
+        return false;
+    }
+    return true;
+}
+
+bool csv_projection_from_header(CsvProjection *proj, const char *header, size_t len, char delimiter,
+                                const char *const names[], size_t count) {
+    if (!proj || !header || count == 0) return false;
+    char delim = delimiter ? delimiter : ',';
+
+    size_t *indices = malloc(sizeof(size_t) * count);
+    if (!indices) return false;
+    bool found_all = true;
+
+    for (size_t i = 0; i < count && found_all; i++) {
+        CsvCursor cur;
+        CsvField f;
+        csv_cursor_init(&cur, header, len, delim);
+        csv_cursor_next_line(&cur);
+
+        found_all = false;
+        for (size_t col = 0; csv_cursor_next_field(&cur, &f); col++) {
+            if (name_matches(&f, names[i])) {
+                indices[i] = col;
+                found_all = true;
+                break;
+            }
+        }
+    }
+
+    bool ok = found_all && csv_projection_from_indices(proj, indices, count, delim);
+    free(indices);
+    return ok;
+}
+
+void csv_projection_free(CsvProjection *proj) {
+    if (!proj) return;
+    free(proj->source);
+    free(proj->slot);
+    proj->source = NULL;
+    proj->slot = NULL;
+    proj->count = 0;
+}
+
+// --- Reading ---
+
+bool csv_projection_read(const CsvProjection *proj, CsvCursor *cur, double out[]) {
+    CsvField f;
+    for (size_t field = 0; field <= proj->last; field++) {
+        int s = proj->slot[field];
+        if (s < 0) {
+            if (!csv_cursor_next_field(cur, NULL)) return false; // Unused: no conversion
+            continue;
+        }
+        if (!csv_cursor_next_field(cur, &f) || !csv_field_to_double(&f, &out[s])) return false;
+    }
+    return true;
+}
+
+bool csv_projection_read_record(const CsvProjection *proj, const char *record, size_t len, double out[]) {
+    CsvCursor cur;
+    csv_cursor_init(&cur, record, len, proj->delimiter);
+    return csv_cursor_next_line(&cur) && csv_projection_read(proj, &cur, out);
+}
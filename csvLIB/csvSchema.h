@@ -0,0 +1,50 @@
+#ifndef CSV_SCHEMA_H
+#define CSV_SCHEMA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "csvMap.h"
+
+// --- Header-Driven Column Projection ---
+
+/**
+ * @brief Maps the wanted columns of a record to output slots.
+ * Fields that are not wanted are stepped over without being converted, and
+ * nothing past the last wanted field is tokenised at all.
+ */
+typedef struct {
+    size_t count;           // Number of wanted columns (output slots)
+    size_t *source;         // source[i] = field index feeding slot i
+    int *slot;              // slot[f] = output slot of field f, -1 = skip (f <= last)
+    size_t last;            // Highest field index that is needed
+    char delimiter;
+} CsvProjection;
+
+/**
+ * @brief Looks the wanted names up in a header record (case-insensitive,
+ * surrounding blanks and quotes ignored).
+ * @return false if any name is missing or out of memory
+ */
+bool csv_projection_from_header(CsvProjection *proj, const char *header, size_t len, char delimiter,
+                                const char *const names[], size_t count);
+
+/**
+ * @brief Projection by field position (source[i] = indices[i]).
+ * @return false on a duplicate index or out of memory
+ */
+bool csv_projection_from_indices(CsvProjection *proj, const size_t indices[], size_t count, char delimiter);
+
+/**
+ * @brief Reads the wanted fields of the cursor's current record into out[0..count).
+ * @return false if a wanted field is missing or not a number
+ */
+bool csv_projection_read(const CsvProjection *proj, CsvCursor *cur, double out[]);
+
+/**
+ * @brief Same as csv_projection_read over one record held in a string.
+ */
+bool csv_projection_read_record(const CsvProjection *proj, const char *record, size_t len, double out[]);
+
+void csv_projection_free(CsvProjection *proj);
+
+#endif // CSV_SCHEMA_H
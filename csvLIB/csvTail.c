@@ -0,0 +1,327 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "csvTail.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#define CSV_HAVE_INOTIFY 1
+#endif
+
+#define TAIL_CHUNK (8u << 20)   // Bytes read (and delivered) per step: memory stays flat on big backlogs
+#define TAIL_STATE_MAGIC "CALCTAIL 1"
+
+// --- State File ---
+
+char *csv_tail_default_state_path(const char *csv_path) {
+    if (!csv_path) return NULL;
+    size_t len = strlen(csv_path);
+    char *path = malloc(len + sizeof(CSV_TAIL_SUFFIX));
+    if (!path) return NULL;
+    memcpy(path, csv_path, len);
+    memcpy(path + len, CSV_TAIL_SUFFIX, sizeof(CSV_TAIL_SUFFIX));
+    return path;
+}
+
+bool csv_tail_save(const CsvTail *t) {
+    if (!t) return false;
+    if (!t->state_path) return true;
+
+    size_t len = strlen(t->state_path);
+    char *tmp = malloc(len + 5);
+    if (!tmp) return false;
+    memcpy(tmp, t->state_path, len);
+    memcpy(tmp + len, ".tmp", 5);
+
+    FILE *f = fopen(tmp, "w");
+    bool ok = f != NULL;
+    if (ok) {
+        fprintf(f, "%s\n%llu %ld %llu %llu\n", TAIL_STATE_MAGIC, (unsigned long long)t->offset,
+                t->line_number, (unsigned long long)t->dev, (unsigned long long)t->ino);
+        ok = fclose(f) == 0;
+    }
+    if (ok && rename(tmp, t->state_path) != 0) ok = false;
+    if (!ok) remove(tmp);
+    free(tmp);
+    return ok;
+}
+
+static void load_state(CsvTail *t) {
+    FILE *f = t->state_path ? fopen(t->state_path, "r") : NULL;
+    if (!f) return;
+
+    char magic[16];
+    unsigned long long offset, dev, ino;
+    long line_number;
+    if (fgets(magic, sizeof(magic), f) && strncmp(magic, TAIL_STATE_MAGIC "\n", sizeof(TAIL_STATE_MAGIC)) == 0 &&
+        fscanf(f, "%llu %ld %llu %llu", &offset, &line_number, &dev, &ino) == 4 && line_number >= 0) {
+        t->offset = offset;
+        t->line_number = line_number;
+        t->dev = dev;
+        t->ino = ino;
+    } else {
+        fprintf(stderr, "Warning: Ignoring unreadable tail state %s.\n", t->state_path);
+    }
+    fclose(f);
+}
+
+// --- Construction ---
+
+CsvTail *csv_tail_open(const char *path, const char *state_path, bool has_header) {
+    if (!path) return NULL;
+    CsvTail *t = calloc(1, sizeof(CsvTail));
+    if (!t) return NULL;
+    t->path = strdup(path);
+    t->state_path = state_path ? strdup(state_path) : NULL;
+    t->has_header = has_header;
+    t->notify_fd = t->watch = -1;
+    if (!t->path || (state_path && !t->state_path)) {
+        csv_tail_close(t);
+        return NULL;
+    }
+    load_state(t);
+
+#ifdef CSV_HAVE_INOTIFY
+    t->notify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+    return t;
+}
+
+void csv_tail_close(CsvTail *t) {
+    if (!t) return;
+    if (t->path && !csv_tail_save(t)) fprintf(stderr, "Warning: Could not save tail state %s.\n", t->state_path);
+#ifdef CSV_HAVE_INOTIFY
+    if (t->notify_fd >= 0) close(t->notify_fd);
+#endif
+    free(t->path);
+    free(t->state_path);
+    free(t->header);
+    free(t->buf);
+    free(t);
+}
+
+// --- Reading ---
+
+static void restart(CsvTail *t) {
+    t->offset = 0;
+    t->line_number = 0;
+    t->len = 0;
+    free(t->header);
+    t->header = NULL;
+}
+
+static bool reserve(CsvTail *t, size_t need) {
+    if (need <= t->cap) return true;
+    size_t cap = t->cap ? t->cap : 4096;
+    while (cap < need) cap *= 2;
+    char *grown = realloc(t->buf, cap);
+    if (!grown) return false;
+    t->buf = grown;
+    t->cap = cap;
+    return true;
+}
+
+// Strips the line ending and keeps a copy of the header line
+static bool set_header(CsvTail *t, const char *line, size_t len) {
+    while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) len--;
+    t->header = malloc(len + 1);
+    if (!t->header) return false;
+    memcpy(t->header, line, len);
+    t->header[len] = '\0';
+    return true;
+}
+
+// Resumed past the header: read it again from the start of the file
+static bool reread_header(CsvTail *t, FILE *f) {
+    char *line = NULL;
+    size_t cap = 0;
+    ssize_t n = (fseeko(f, 0, SEEK_SET) == 0) ? getline(&line, &cap, f) : -1;
+    bool ok = n > 0 && set_header(t, line, (size_t)n);
+    free(line);
+    return ok;
+}
+
+static size_t count_lines(const char *p, size_t len) {
+    size_t count = 0;
+    for (const char *end = p + len; (p = memchr(p, '\n', (size_t)(end - p))) != NULL; p++) count++;
+    return count;
+}
+
+// Delivers the complete lines in t->buf and keeps the partial one
+static long deliver(CsvTail *t, CsvTailFn fn, void *ctx) {
+    size_t start = 0;
+    if (t->has_header && t->offset == 0 && !t->header) {
+        const char *nl = memchr(t->buf, '\n', t->len);
+        if (!nl) return 0; // Header still being written
+        start = (size_t)(nl - t->buf) + 1;
+        if (!set_header(t, t->buf, start)) return -1;
+        t->offset = start;
+        t->line_number = 1;
+    }
+
+    size_t end = t->len;
+    while (end > start && t->buf[end - 1] != '\n') end--;
+    size_t count = count_lines(t->buf + start, end - start);
+
+    if (count > 0) {
+        if (fn && !fn(t->buf + start, end - start, count, t->line_number + 1, ctx)) return -1;
+        t->offset += end - start;
+        t->line_number += (long)count;
+    }
+    memmove(t->buf, t->buf + end, t->len - end);
+    t->len -= end;
+    if ((count > 0 || start > 0) && !csv_tail_save(t)) {
+        fprintf(stderr, "Warning: Could not save tail state %s.\n", t->state_path);
+    }
+    return (long)count;
+}
+
+long csv_tail_poll(CsvTail *t, CsvTailFn fn, void *ctx) {
+    if (!t) return -1;
+    FILE *f = fopen(t->path, "rb");
+    if (!f) return (errno == ENOENT) ? 0 : -1; // Not created yet
+
+    struct stat st;
+    if (fstat(fileno(f), &st) != 0) {
+        fclose(f);
+        return -1;
+    }
+    // Replaced (rotated) or truncated: everything in it is new
+    bool same_file = t->ino == 0 || ((uint64_t)st.st_dev == t->dev && (uint64_t)st.st_ino == t->ino);
+    if (!same_file || (uint64_t)st.st_size < t->offset + t->len) {
+        if (t->offset + t->len > 0) fprintf(stderr, "Note: %s was truncated or replaced, reading it from the start.\n", t->path);
+        restart(t);
+    }
+    t->dev = (uint64_t)st.st_dev;
+    t->ino = (uint64_t)st.st_ino;
+
+    if (t->has_header && !t->header && t->offset > 0 && !reread_header(t, f)) {
+        fclose(f);
+        return -1;
+    }
+
+    long total = 0;
+    bool ok = fseeko(f, (off_t)(t->offset + t->len), SEEK_SET) == 0;
+    while (ok) {
+        if (!reserve(t, t->len + TAIL_CHUNK)) { ok = false; break; }
+        size_t n = fread(t->buf + t->len, 1, TAIL_CHUNK, f);
+        t->len += n;
+        long delivered = deliver(t, fn, ctx);
+        if (delivered < 0) ok = false;
+        else total += delivered;
+        if (n < TAIL_CHUNK) break;
+    }
+    if (ferror(f)) ok = false;
+    fclose(f);
+    return ok ? total : -1;
+}
+
+// --- Waiting ---
+
+static void sleep_ms(int ms) {
+    struct timespec ts = {ms / 1000, (long)(ms % 1000) * 1000000L};
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {}
+}
+
+bool csv_tail_wait(CsvTail *t, int timeout_ms) {
+    if (!t) return false;
+    if (timeout_ms < 0) timeout_ms = CSV_TAIL_IDLE_MS;
+
+#ifdef CSV_HAVE_INOTIFY
+    if (t->notify_fd >= 0 && t->watch < 0) {
+        t->watch = inotify_add_watch(t->notify_fd, t->path,
+                                     IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVE_SELF | IN_DELETE_SELF);
+    }
+    if (t->watch >= 0) {
+        struct pollfd pfd = {t->notify_fd, POLLIN, 0};
+        int ready = poll(&pfd, 1, timeout_ms);
+        if (ready <= 0) return false;
+
+        // Drain; after a rename / delete the path is watched again next time
+        union { struct inotify_event ev; char bytes[4096]; } events;
+        ssize_t n;
+        while ((n = read(t->notify_fd, events.bytes, sizeof(events))) > 0) {
+            for (char *p = events.bytes; p < events.bytes + n; ) {
+                const struct inotify_event *ev = (const struct inotify_event *)p;
+                if (ev->mask & (IN_MOVE_SELF | IN_DELETE_SELF | IN_IGNORED)) {
+                    if (!(ev->mask & IN_IGNORED)) inotify_rm_watch(t->notify_fd, t->watch);
+                    t->watch = -1;
+                }
+                p += sizeof(struct inotify_event) + ev->len;
+            }
+        }
+        return true;
+    }
+#endif
+
+    // No change notification (or the file does not exist yet): just sleep
+    sleep_ms(timeout_ms);
+    return true;
+}
+
+// --- Pipeline ---
+
+typedef struct {
+    FILE *out;
+    PipelineOptions opts;
+    PipelineStats stats;
+    long data_first_line;
+} TailRun;
+
+static bool run_rows(const char *rows, size_t len, size_t count, long first_line, void *ctx) {
+    TailRun *run = (TailRun *)ctx;
+    (void)count;
+    FILE *in = fmemopen((void *)rows, len, "r");
+    if (!in) return false;
+
+    PipelineOptions o = run->opts;
+    o.has_header = false;
+    o.line_base = first_line - 1;
+    o.append = run->opts.append || first_line != run->data_first_line;
+
+    PipelineStats s;
+    bool ok = csv_pipeline_run(in, run->out, &o, &s);
+    fclose(in);
+    if (ok) {
+        run->stats.rows_in += s.rows_in;
+        run->stats.rows_out += s.rows_out;
+        run->stats.rows_bad += s.rows_bad;
+        run->stats.rows_cached += s.rows_cached;
+    }
+    return ok;
+}
+
+long csv_tail_pipeline(CsvTail *t, FILE *out, const PipelineOptions *opts, PipelineStats *stats) {
+    if (!t || !out) return -1;
+    TailRun run;
+    memset(&run, 0, sizeof(run));
+    run.out = out;
+    run.opts = opts ? *opts : csv_pipeline_default_options();
+    run.data_first_line = t->has_header ? 2 : 1;
+
+    long rows = csv_tail_poll(t, run_rows, &run);
+    if (stats) {
+        stats->rows_in += run.stats.rows_in;
+        stats->rows_out += run.stats.rows_out;
+        stats->rows_bad += run.stats.rows_bad;
+        stats->rows_cached += run.stats.rows_cached;
+    }
+    return rows;
+}
+
+bool csv_tail_follow(CsvTail *t, FILE *out, const PipelineOptions *opts,
+                     const volatile sig_atomic_t *stop, PipelineStats *stats) {
+    while (!(stop && *stop)) {
+        if (csv_tail_pipeline(t, out, opts, stats) < 0) return false;
+        if (fflush(out) != 0) return false;
+        if (stop && *stop) break;
+        csv_tail_wait(t, CSV_TAIL_IDLE_MS);
+    }
+    return true;
+}
@@ -0,0 +1,100 @@
+#ifndef CSV_TAIL_H
+#define CSV_TAIL_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <signal.h>
+#include "csvPipeline.h"
+
+// --- Incremental Tail / Follow Mode ---
+
+#define CSV_TAIL_SUFFIX ".tail"     // Default state path: <csv path>.tail
+#define CSV_TAIL_IDLE_MS 1000       // Longest sleep between checks in csv_tail_follow
+
+/**
+ * @brief Reader that only ever sees rows appended since the last call.
+ * 'offset' counts the bytes of complete lines already delivered; a trailing
+ * line without its '\n' is held back until the writer finishes it. The offset
+ * (never the held-back bytes) is persisted, so a restart re-reads at most one
+ * partial line. A file that shrinks or is replaced starts over from byte 0.
+ */
+typedef struct {
+    char *path;
+    char *state_path;       // NULL = keep the offset in memory only
+    bool has_header;
+    uint64_t offset;        // File position of the first undelivered line
+    long line_number;       // Lines before 'offset'
+    uint64_t dev;           // Identity of the file 'offset' refers to
+    uint64_t ino;
+    char *header;           // First line of the file (NULL until it has been read)
+    char *buf;              // Complete new lines + held-back partial line
+    size_t len;
+    size_t cap;
+    int notify_fd;          // inotify instance (-1 = poll with sleeps)
+    int watch;
+} CsvTail;
+
+/**
+ * @brief Called with each run of new complete lines ('\n' terminated).
+ * @param first_line Line number of the first of them
+ * @return false to stop; the lines are then delivered again next time
+ */
+typedef bool (*CsvTailFn)(const char *rows, size_t len, size_t count, long first_line, void *ctx);
+
+/**
+ * @brief Starts tailing 'path', resuming from 'state_path' if it describes this file.
+ * The file itself need not exist yet.
+ * @param state_path Where the offset is kept (NULL = not persisted)
+ * @param has_header The first line is a header, never delivered as a row
+ * @return Tail, or NULL on allocation failure
+ */
+CsvTail *csv_tail_open(const char *path, const char *state_path, bool has_header);
+
+/**
+ * @brief Returns a malloc'd "<csv_path>.tail" string (caller frees).
+ */
+char *csv_tail_default_state_path(const char *csv_path);
+
+/**
+ * @brief Reads everything appended since the last call and hands the complete
+ * lines to 'fn'. The new offset is saved after 'fn' accepts them.
+ * @return Number of rows delivered, or -1 on a read error
+ */
+long csv_tail_poll(CsvTail *t, CsvTailFn fn, void *ctx);
+
+/**
+ * @brief Sleeps until the file changes (inotify on Linux) or 'timeout_ms' passes.
+ * @return true if a change was reported (always true when polling with sleeps)
+ */
+bool csv_tail_wait(CsvTail *t, int timeout_ms);
+
+/**
+ * @brief Writes the offset to the state file (atomically, via a temporary file).
+ */
+bool csv_tail_save(const CsvTail *t);
+
+/**
+ * @brief Saves the offset and frees the tail.
+ */
+void csv_tail_close(CsvTail *t);
+
+/**
+ * @brief Runs the rows appended since the last call through csv_pipeline_run,
+ * appending the results to 'out' (the result header only precedes the first row
+ * of the file). Bad-row warnings carry the row's line number in the file.
+ * @param stats Counts are added to it (may be NULL)
+ * @return Rows read, or -1 on error
+ */
+long csv_tail_pipeline(CsvTail *t, FILE *out, const PipelineOptions *opts, PipelineStats *stats);
+
+/**
+ * @brief csv_tail_pipeline after every change until '*stop' becomes non-zero
+ * (e.g. set from a SIGINT handler).
+ * @return false if reading or writing failed
+ */
+bool csv_tail_follow(CsvTail *t, FILE *out, const PipelineOptions *opts,
+                     const volatile sig_atomic_t *stop, PipelineStats *stats);
+
+#endif // CSV_TAIL_H
@@ -0,0 +1,181 @@
+#include "csvWriter.h"
+#include "csvNumber.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Longest single item put in the buffer without a capacity check
+#define MAX_ITEM_CHARS (CSV_DOUBLE_MAX_CHARS + 2)
+
+// --- Buffer ---
+
+static void drain(CsvWriter *w) {
+    if (!w->failed && w->len > 0 && fwrite(w->buf, 1, w->len, w->out) != w->len) w->failed = true;
+    w->len = 0;
+}
+
+static void reserve(CsvWriter *w, size_t n) {
+    if (w->cap - w->len < n) drain(w);
+}
+
+static void put_bytes(CsvWriter *w, const char *s, size_t n) {
+    if (n > w->cap - w->len) {
+        drain(w);
+        if (n > w->cap) { // Larger than the whole buffer: write through
+            if (!w->failed && fwrite(s, 1, n, w->out) != n) w->failed = true;
+            return;
+        }
+    }
+    memcpy(w->buf + w->len, s, n);
+    w->len += n;
+}
+
+static void begin_field(CsvWriter *w) {
+    if (w->row_started) w->buf[w->len++] = w->delimiter;
+    w->row_started = true;
+}
+
+// --- Construction ---
+
+static CsvWriter *writer_new(FILE *out, bool owns_file, char delimiter) {
+    CsvWriter *w = calloc(1, sizeof(CsvWriter));
+    if (!w) return NULL;
+    w->buf = malloc(CSV_WRITER_BUFFER);
+    if (!w->buf) {
+        free(w);
+        return NULL;
+    }
+    w->out = out;
+    w->owns_file = owns_file;
+    w->cap = CSV_WRITER_BUFFER;
+    w->delimiter = delimiter ? delimiter : ',';
+    return w;
+}
+
+CsvWriter *csv_writer_open(const char *path, char delimiter) {
+    if (!path) return NULL;
+    bool is_stdout = strcmp(path, "-") == 0;
+    FILE *out = is_stdout ? stdout : fopen(path, "w");
+    if (!out) {
+        perror("Error opening output file");
+        return NULL;
+    }
+    CsvWriter *w = writer_new(out, !is_stdout, delimiter);
+    if (!w && !is_stdout) fclose(out);
+    return w;
+}
+
+CsvWriter *csv_writer_from_file(FILE *out, char delimiter) {
+    return out ? writer_new(out, false, delimiter) : NULL;
+}
+
+void csv_writer_set_precision(CsvWriter *w, int precision) {
+    if (w) w->precision = (precision >= 0 && precision <= 17) ? precision : 0;
+}
+
+// --- Fields & Rows ---
+
+void csv_writer_field(CsvWriter *w, const char *text) {
+    if (!w || w->failed) return;
+    if (!text) text = "";
+    reserve(w, 1);
+    begin_field(w);
+
+    size_t len = strlen(text);
+    char special[4] = {w->delimiter, '"', '\n', '\0'};
+    if (text[strcspn(text, special)] == '\0' && !strchr(text, '\r')) {
+        put_bytes(w, text, len);
+        return;
+    }
+
+    // RFC 4180 quoting: wrap in quotes, double the embedded ones
+    put_bytes(w, "\"", 1);
+    for (const char *q; (q = strchr(text, '"')) != NULL; text = q + 1) {
+        put_bytes(w, text, (size_t)(q - text) + 1);
+        put_bytes(w, "\"", 1);
+    }
+    put_bytes(w, text, strlen(text));
+    put_bytes(w, "\"", 1);
+}
+
+void csv_writer_double(CsvWriter *w, double value) {
+    if (!w || w->failed) return;
+    reserve(w, MAX_ITEM_CHARS);
+    begin_field(w);
+    w->len += (size_t)csv_format_double(value, w->precision, w->buf + w->len);
+}
+
+void csv_writer_long(CsvWriter *w, long value) {
+    if (!w || w->failed) return;
+    reserve(w, MAX_ITEM_CHARS);
+    begin_field(w);
+
+    char tmp[24];
+    int n = 0;
+    unsigned long u = (value < 0) ? 0ul - (unsigned long)value : (unsigned long)value;
+    do { tmp[n++] = (char)('0' + u % 10); u /= 10; } while (u);
+    if (value < 0) w->buf[w->len++] = '-';
+    while (n > 0) w->buf[w->len++] = tmp[--n];
+}
+
+void csv_writer_text(CsvWriter *w, const char *text, size_t len) {
+    if (!w || w->failed || !text) return;
+    put_bytes(w, text, len);
+}
+
+void csv_writer_end_row(CsvWriter *w) {
+    if (!w || w->failed) return;
+    reserve(w, 1);
+    w->buf[w->len++] = '\n';
+    w->row_started = false;
+}
+
+void csv_writer_header(CsvWriter *w, const char *const names[], size_t count) {
+    for (size_t i = 0; i < count; i++) csv_writer_field(w, names[i]);
+    csv_writer_end_row(w);
+}
+
+void csv_writer_row(CsvWriter *w, const double values[], size_t count) {
+    for (size_t i = 0; i < count; i++) csv_writer_double(w, values[i]);
+    csv_writer_end_row(w);
+}
+
+void csv_writer_columns(CsvWriter *w, const double *const columns[], size_t ncols, size_t rows) {
+    if (!w || w->failed || ncols == 0) return;
+    const size_t row_max = ncols * MAX_ITEM_CHARS + 1;
+
+    for (size_t r = 0; r < rows && !w->failed; r++) {
+        if (row_max > w->cap) { // Rows wider than the buffer: value by value
+            for (size_t c = 0; c < ncols; c++) csv_writer_double(w, columns[c][r]);
+            csv_writer_end_row(w);
+            continue;
+        }
+
+        // One capacity check per row instead of per value
+        reserve(w, row_max);
+        char *p = w->buf + w->len;
+        for (size_t c = 0; c < ncols; c++) {
+            if (c) *p++ = w->delimiter;
+            p += csv_format_double(columns[c][r], w->precision, p);
+        }
+        *p++ = '\n';
+        w->len = (size_t)(p - w->buf);
+    }
+}
+
+// --- Flush & Close ---
+
+bool csv_writer_flush(CsvWriter *w) {
+    if (!w) return false;
+    drain(w);
+    if (!w->failed && fflush(w->out) != 0) w->failed = true;
+    return !w->failed;
+}
+
+bool csv_writer_close(CsvWriter *w) {
+    if (!w) return false;
+    bool ok = csv_writer_flush(w);
+    if (w->owns_file && fclose(w->out) != 0) ok = false;
+    free(w->buf);
+    free(w);
+    return ok;
+}
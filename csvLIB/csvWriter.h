@@ -0,0 +1,93 @@
+#ifndef CSV_WRITER_H
+#define CSV_WRITER_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define CSV_WRITER_BUFFER (1u << 20)    // Bytes collected before each fwrite
+
+// --- Buffered CSV / TSV Output ---
+
+/**
+ * @brief Output stream with its own large buffer. Numbers are formatted by
+ * csv_format_double (no printf). Errors are sticky: once a write fails every
+ * later call is a no-op and csv_writer_close reports it.
+ */
+typedef struct {
+    FILE *out;
+    bool owns_file;         // fclose on close (not for stdout / caller's FILE)
+    char *buf;
+    size_t len;
+    size_t cap;
+    char delimiter;         // ',' for CSV, '\t' for TSV
+    int precision;          // 0 = shortest round-trip, 1..17 = significant digits
+    bool row_started;       // A field was written on the current row
+    bool failed;
+} CsvWriter;
+
+/**
+ * @brief Opens 'path' for writing ("-" means stdout).
+ * @return Writer, or NULL on failure
+ */
+CsvWriter *csv_writer_open(const char *path, char delimiter);
+
+/**
+ * @brief Wraps an open stream. The stream is flushed but not closed on close.
+ */
+CsvWriter *csv_writer_from_file(FILE *out, char delimiter);
+
+/**
+ * @brief Significant digits of every following number (0 = shortest round-trip).
+ */
+void csv_writer_set_precision(CsvWriter *w, int precision);
+
+/**
+ * @brief Writes one field, quoting it if it holds the delimiter, a quote or a newline.
+ */
+void csv_writer_field(CsvWriter *w, const char *text);
+
+void csv_writer_double(CsvWriter *w, double value);
+
+void csv_writer_long(CsvWriter *w, long value);
+
+/**
+ * @brief Writes raw bytes as they are (no delimiter, no quoting), for
+ * reports that are not CSV but want the same buffering.
+ */
+void csv_writer_text(CsvWriter *w, const char *text, size_t len);
+
+/**
+ * @brief Ends the current row.
+ */
+void csv_writer_end_row(CsvWriter *w);
+
+/**
+ * @brief Writes a header row.
+ */
+void csv_writer_header(CsvWriter *w, const char *const names[], size_t count);
+
+/**
+ * @brief Writes one complete row of numbers.
+ */
+void csv_writer_row(CsvWriter *w, const double values[], size_t count);
+
+/**
+ * @brief Writes rows [0, rows) of column-major data in one call
+ * (row r is columns[0][r], columns[1][r], ...).
+ */
+void csv_writer_columns(CsvWriter *w, const double *const columns[], size_t ncols, size_t rows);
+
+/**
+ * @brief Pushes the buffer to the stream.
+ * @return false if any write so far has failed
+ */
+bool csv_writer_flush(CsvWriter *w);
+
+/**
+ * @brief Flushes, closes the file if the writer opened it and frees the writer.
+ * @return false if any write failed
+ */
+bool csv_writer_close(CsvWriter *w);
+
+#endif // CSV_WRITER_H
@@ -1,6 +1,116 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include "matrice.h"
+#include "parallel.h"
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+
+// --- Storage ---
+
+// Values per row, padded so every row starts on a MATRICE_ALIGN boundary
+static size_t padded_stride(size_t values) {
+    const size_t per_line = MATRICE_ALIGN / sizeof(unsigned short);
+    return (values + per_line - 1) / per_line * per_line;
+}
+
+static size_t value_index(const matrice *M, size_t r, size_t c, unsigned int channel) {
+    if (M->layout == MATRICE_PLANAR) return channel * M->plane + r * M->stride + c;
+    return r * M->stride + c * MATRICE_CHANNELS + channel;
+}
+
+matrice *matrice_create(unsigned short rows, unsigned short cols, MatriceLayout layout){
+    matrice *m = (matrice *)malloc(sizeof(matrice));
+    if (m == NULL) return NULL;
+
+    m->rows = rows;
+    m->cols = cols;
+    m->layout = layout;
+    if (layout == MATRICE_PLANAR) {
+        m->stride = padded_stride(cols);
+        m->plane = m->stride * rows;
+    } else {
+        m->stride = padded_stride((size_t)cols * MATRICE_CHANNELS);
+        m->plane = 0;
+    }
+
+    size_t values = layout == MATRICE_PLANAR ? m->plane * MATRICE_CHANNELS : m->stride * rows;
+    size_t bytes = values ? values * sizeof(unsigned short) : MATRICE_ALIGN;
+    void *buf = NULL;
+    if (posix_memalign(&buf, MATRICE_ALIGN, bytes) != 0) {
+        free(m);
+        return NULL;
+    }
+    memset(buf, 0, bytes);
+    m->data = (unsigned short *)buf;
+    m->storage = buf;
+    return m;
+}
+
+matrice *matrice_convert(const matrice *M, MatriceLayout layout){
+    if (M == NULL) return NULL;
+    matrice *m = matrice_create(M->rows, M->cols, layout);
+    if (m == NULL) return NULL;
+
+    for (unsigned int i = 0; i < M->rows; i++){
+        if (layout == M->layout && layout == MATRICE_INTERLEAVED) {
+            memcpy(m->data + i * m->stride, M->data + i * M->stride, sizeof(pix) * M->cols);
+            continue;
+        }
+        for (unsigned int ch = 0; ch < MATRICE_CHANNELS; ch++){
+            for (unsigned int j = 0; j < M->cols; j++){
+                m->data[value_index(m, i, j, ch)] = M->data[value_index(M, i, j, ch)];
+            }
+        }
+    }
+    return m;
+}
+
+void free_matrice(matrice *M){
+    if (M == NULL) return;
+    free(M->storage);   // One buffer for every pixel
+    free(M);
+}
+
+void free_pixel(pix *p){
+    free(p);
+}
+
+// --- Pixel Access ---
+
+pix matrice_get(const matrice *M, unsigned int r, unsigned int c){
+    pix p;
+    p.R = M->data[value_index(M, r, c, 0)];
+    p.G = M->data[value_index(M, r, c, 1)];
+    p.B = M->data[value_index(M, r, c, 2)];
+    return p;
+}
+
+void matrice_set(matrice *M, unsigned int r, unsigned int c, pix p){
+    M->data[value_index(M, r, c, 0)] = p.R;
+    M->data[value_index(M, r, c, 1)] = p.G;
+    M->data[value_index(M, r, c, 2)] = p.B;
+}
+
+pix *matrice_pixel(matrice *M, unsigned int r, unsigned int c){
+    pix *row = matrice_row(M, r);
+    return (row && c < M->cols) ? row + c : NULL;
+}
+
+pix *matrice_row(matrice *M, unsigned int r){
+    if (!M || M->layout != MATRICE_INTERLEAVED || r >= M->rows) return NULL;
+    return (pix *)(M->data + r * M->stride);
+}
+
+unsigned short *matrice_channel_row(matrice *M, unsigned int channel, unsigned int r){
+    if (!M || M->layout != MATRICE_PLANAR || channel >= MATRICE_CHANNELS || r >= M->rows) return NULL;
+    return M->data + channel * M->plane + r * M->stride;
+}
+
+// --- Pixels ---
 
 // Helper to consolidate swapping logic
 void swap_pixels(pix *p1, pix *p2){
@@ -19,109 +129,413 @@ pix *generatePixel(unsigned short r, unsigned short g, unsigned short b){
     return p;
 }
 
+pix *multiply_pixels(pix *p1, pix *p2){
+    pix *res = (pix *)malloc(sizeof(pix));
+    if (res == NULL) return NULL;
+
+    res->R = p1->R * p2->R;
+    res->G = p1->G * p2->G;
+    res->B = p1->B * p2->B;
+    return res;
+}
+
+pix *add_pixels(pix *p1, pix *p2){
+    pix *res = (pix *)malloc(sizeof(pix));
+    if (res == NULL) return NULL;
+
+    res->R = p1->R + p2->R;
+    res->G = p1->G + p2->G;
+    res->B = p1->B + p2->B;
+    return res; 
+}
+
+// --- Matrix Operations ---
+
 matrice *generateMatrice(unsigned short r, unsigned int c, int seed){
-    matrice *m = (matrice *)malloc(sizeof(matrice));
+    matrice *m = matrice_create(r, (unsigned short)c, MATRICE_INTERLEAVED);
     if (m == NULL) return NULL;
-    
-    m->cols = c;
-    m->rows = r;
-    m->Mat = (pix ***)malloc(sizeof(pix **) * r);
-    
-    for (unsigned short i = 0; i < r; i++){
-        m->Mat[i] = (pix **)malloc(sizeof(pix *) * c);
-    }
-    
-    rand_fill_matrice(seed, r, c, m->Mat);
+    rand_fill_matrice(m, seed);
     return m;
 }
 
-void rand_fill_matrice(int seed, unsigned int r, unsigned int c, pix ***mat){
+void rand_fill_matrice(matrice *M, int seed){
     if (seed != 0) srand(seed);
+    if (M == NULL) return;
 
-    for (unsigned short i = 0; i < r; i++){
-        for (unsigned short j = 0; j < c; j++){
-            mat[i][j] = generatePixel((rand()%256), (rand()%256), (rand()%256));
+    for (unsigned int i = 0; i < M->rows; i++){
+        for (unsigned int j = 0; j < M->cols; j++){
+            pix p;
+            p.R = (unsigned short)(rand() % 256);
+            p.G = (unsigned short)(rand() % 256);
+            p.B = (unsigned short)(rand() % 256);
+            matrice_set(M, i, j, p);
         }
     }
 }
 
-// Fixed: Renamed to avoid conflict
-void transposeMatriceInPlace(matrice *M){
-    if (!M) return;
-    unsigned short rows = M->rows, cols = M->cols;
-    for (unsigned short i = 0; i < rows; i++){
-        for (unsigned short j = i + 1; j < cols; j++){
-            swap_pixels(M->Mat[i][j], M->Mat[j][i]);
+// --- Transpose ---
+// Out of place: TRANSPOSE_TILE x TRANSPOSE_TILE pixel tiles, so reads and writes
+// both stay within a few cache lines; bands of tile rows go to worker threads.
+// In place: square matrices swap tiles across the diagonal; other shapes are
+// packed and permuted by cycle following.
+
+#define TRANSPOSE_TILE 32
+#define TRANSPOSE_PARALLEL_PIXELS (1u << 18)    // Smaller images are transposed on one thread
+
+typedef struct {
+    const matrice *src;
+    matrice *dst;
+    bool anti;
+} TransposeJob;
+
+// Destination (r, c) takes source (c, r), or (rows-1-c, cols-1-r) across the anti-diagonal
+static void transpose_tile(const TransposeJob *job, unsigned int r0, unsigned int r1, unsigned int c0, unsigned int c1){
+    const matrice *S = job->src;
+    matrice *D = job->dst;
+    if (S->layout == MATRICE_INTERLEAVED && D->layout == MATRICE_INTERLEAVED) {
+        for (unsigned int r = r0; r < r1; r++){
+            pix *out = (pix *)(D->data + r * D->stride);
+            const unsigned int sc = job->anti ? S->cols - 1u - r : r;
+            for (unsigned int c = c0; c < c1; c++){
+                const unsigned int sr = job->anti ? S->rows - 1u - c : c;
+                out[c] = ((const pix *)(S->data + sr * S->stride))[sc];
+            }
+        }
+        return;
+    }
+    for (unsigned int ch = 0; ch < MATRICE_CHANNELS; ch++){
+        for (unsigned int r = r0; r < r1; r++){
+            for (unsigned int c = c0; c < c1; c++){
+                unsigned int sr = job->anti ? S->rows - 1u - c : c;
+                unsigned int sc = job->anti ? S->cols - 1u - r : r;
+                D->data[value_index(D, r, c, ch)] = S->data[value_index(S, sr, sc, ch)];
+            }
         }
     }
 }
 
-pix *multiply_pixels(pix *p1, pix *p2){
-    pix *res = (pix *)malloc(sizeof(pix));
-    if (res == NULL) return NULL;
+// Bands [begin, end) of destination tile rows
+static void transpose_band(size_t begin, size_t end, unsigned int worker, void *ctx){
+    const TransposeJob *job = (const TransposeJob *)ctx;
+    const matrice *D = job->dst;
+    (void)worker;
+    for (size_t tr = begin; tr < end; tr++){
+        unsigned int r0 = (unsigned int)tr * TRANSPOSE_TILE;
+        unsigned int r1 = r0 + TRANSPOSE_TILE < D->rows ? r0 + TRANSPOSE_TILE : D->rows;
+        for (unsigned int c0 = 0; c0 < D->cols; c0 += TRANSPOSE_TILE){
+            unsigned int c1 = c0 + TRANSPOSE_TILE < D->cols ? c0 + TRANSPOSE_TILE : D->cols;
+            transpose_tile(job, r0, r1, c0, c1);
+        }
+    }
+}
 
-    res->R = p1->R * p2->R;
-    res->G = p1->G * p2->G;
-    res->B = p1->B * p2->B;
-    return res;
+bool matrice_transpose_into(const matrice *M, matrice *Dst, bool anti, unsigned int threads){
+    if (!M || !Dst || M == Dst || Dst->rows != M->cols || Dst->cols != M->rows) return false;
+    TransposeJob job = {M, Dst, anti};
+    size_t bands = ((size_t)Dst->rows + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+    if ((size_t)M->rows * M->cols < TRANSPOSE_PARALLEL_PIXELS) threads = 1;
+    parallel_for(bands, threads, transpose_band, &job);
+    return true;
 }
 
-pix *add_pixels(pix *p1, pix *p2){
-    pix *res = (pix *)malloc(sizeof(pix));
-    if (res == NULL) return NULL;
+static void swap_values(matrice *M, unsigned int r1, unsigned int c1, unsigned int r2, unsigned int c2){
+    for (unsigned int ch = 0; ch < MATRICE_CHANNELS; ch++){
+        size_t a = value_index(M, r1, c1, ch), b = value_index(M, r2, c2, ch);
+        unsigned short tmp = M->data[a];
+        M->data[a] = M->data[b];
+        M->data[b] = tmp;
+    }
+}
 
-    res->R = p1->R + p2->R;
-    res->G = p1->G + p2->G;
-    res->B = p1->B + p2->B;
-    return res; 
+// Square: swap tile (I, J) with tile (J, I) above the diagonal
+static void transpose_square(matrice *M){
+    const unsigned int n = M->rows;
+    for (unsigned int i0 = 0; i0 < n; i0 += TRANSPOSE_TILE){
+        unsigned int i1 = i0 + TRANSPOSE_TILE < n ? i0 + TRANSPOSE_TILE : n;
+        for (unsigned int j0 = i0; j0 < n; j0 += TRANSPOSE_TILE){
+            unsigned int j1 = j0 + TRANSPOSE_TILE < n ? j0 + TRANSPOSE_TILE : n;
+            for (unsigned int i = i0; i < i1; i++){
+                for (unsigned int j = (j0 == i0 ? i + 1 : j0); j < j1; j++){
+                    if (M->layout == MATRICE_INTERLEAVED) {
+                        swap_pixels((pix *)(M->data + i * M->stride) + j, (pix *)(M->data + j * M->stride) + i);
+                    } else {
+                        swap_values(M, i, j, j, i);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Permutes a dense rows x cols array of 'width'-value elements into its transpose.
+// Element p = i * cols + j moves to j * rows + i, i.e. p * rows mod (count - 1).
+// 'seen' holds one bit per element; it is cleared here, so it can be reused.
+static void transpose_cycles(unsigned short *a, size_t rows, size_t cols, size_t width, unsigned char *seen){
+    const size_t count = rows * cols;
+    if (count < 3) return;
+    memset(seen, 0, (count + 7) / 8);
+    unsigned short carry[MATRICE_CHANNELS], next[MATRICE_CHANNELS];
+    for (size_t start = 1; start < count - 1; start++){
+        if (seen[start / 8] & (1u << (start % 8))) continue;
+        memcpy(carry, a + start * width, width * sizeof(unsigned short));
+        size_t p = start;
+        do {
+            size_t q = (size_t)(((unsigned long long)p * rows) % (count - 1));
+            memcpy(next, a + q * width, width * sizeof(unsigned short));
+            memcpy(a + q * width, carry, width * sizeof(unsigned short));
+            memcpy(carry, next, width * sizeof(unsigned short));
+            seen[q / 8] |= (unsigned char)(1u << (q % 8));
+            p = q;
+        } while (p != start);
+    }
+}
+
+// Non-square: pack the rows (and planes) densely, then permute
+static bool transpose_packed(matrice *M){
+    const size_t rows = M->rows, cols = M->cols;
+    const bool planar = M->layout == MATRICE_PLANAR;
+    const size_t row_values = planar ? cols : cols * MATRICE_CHANNELS;
+    // One bitmap for every plane, allocated before anything moves
+    unsigned char *seen = (unsigned char *)malloc((rows * cols + 7) / 8);
+    if (seen == NULL) return false;
+    // Rows only ever move towards the start of the buffer: memmove is safe in order
+    for (unsigned int ch = 0; ch < (planar ? MATRICE_CHANNELS : 1u); ch++){
+        for (size_t i = 0; i < rows; i++){
+            memmove(M->data + (ch * rows + i) * row_values, M->data + value_index(M, i, 0, ch),
+                    row_values * sizeof(unsigned short));
+        }
+    }
+    for (unsigned int ch = 0; ch < (planar ? MATRICE_CHANNELS : 1u); ch++){
+        transpose_cycles(M->data + ch * rows * cols, rows, cols, planar ? 1 : MATRICE_CHANNELS, seen);
+    }
+    free(seen);
+    M->rows = (unsigned short)cols;
+    M->cols = (unsigned short)rows;
+    M->stride = planar ? rows : rows * MATRICE_CHANNELS;
+    M->plane = planar ? rows * cols : 0;
+    return true;
+}
+
+// Turns the matrice by 180 degrees: with a transpose, reflects across the anti-diagonal
+static void rotate_half(matrice *M){
+    const size_t count = (size_t)M->rows * M->cols;
+    for (size_t p = 0, q = count ? count - 1 : 0; p < q; p++, q--){
+        swap_values(M, (unsigned int)(p / M->cols), (unsigned int)(p % M->cols),
+                    (unsigned int)(q / M->cols), (unsigned int)(q % M->cols));
+    }
+}
+
+// Fixed: Renamed to avoid conflict
+void transposeMatriceInPlace(matrice *M){
+    if (!M) return;
+    if (M->rows == M->cols) transpose_square(M);
+    else if (!transpose_packed(M)) fprintf(stderr, "Out of memory transposing matrice\n");
 }
 
 matrice *transposeMatrice(matrice *M, matrice *Dst, const size_t Diagonal){
     if (M == NULL) { fprintf(stderr, "Matrice is empty\n"); return NULL; }
-    // Note: Assuming Diagonal param logic is handled by caller, keeping check simple
-    if (Dst == NULL) Dst = M;
 
-    const unsigned short n = M->rows;
-    for (size_t i = 1; i < n; i++){
-        for (size_t j = i; j < n; j++){ // Fixed loop logic (j < n)
-            swap_pixels(Dst->Mat[i][j], Dst->Mat[j][i]);
-        }
+    if (Dst == M) {
+        transposeMatriceInPlace(M);
+        if (Diagonal) rotate_half(M);
+        return M;
+    }
+    bool allocated = Dst == NULL;
+    if (allocated) Dst = matrice_create(M->cols, M->rows, M->layout);
+    if (Dst == NULL) return NULL;
+    if (!matrice_transpose_into(M, Dst, Diagonal != 0, 0)) {  // Wrong shape: Dst is untouched
+        if (allocated) free_matrice(Dst);
+        return NULL;
     }
     return Dst;
 }
 
+// --- Determinants ---
+// Both eliminations are O(n^3) and work in place on a row-major n x n scratch buffer.
+
+static bool mul_checked(long long a, long long b, long long *out){
+    if (a != 0 && b != 0) {
+        if (a > 0 ? (b > 0 ? a > LLONG_MAX / b : b < LLONG_MIN / a)
+                  : (b > 0 ? a < LLONG_MIN / b : a < LLONG_MAX / b)) return false;
+    }
+    *out = a * b;
+    return true;
+}
+
+static bool sub_checked(long long a, long long b, long long *out){
+    if (b < 0 ? a > LLONG_MAX + b : a < LLONG_MIN + b) return false;
+    *out = a - b;
+    return true;
+}
+
+static void swap_rows_ll(long long *a, size_t n, size_t r1, size_t r2){
+    for (size_t j = 0; j < n; j++){
+        long long t = a[r1 * n + j];
+        a[r1 * n + j] = a[r2 * n + j];
+        a[r2 * n + j] = t;
+    }
+}
+
+bool det_bareiss(long long *a, size_t n, long long *det){
+    if (n == 0) { *det = 1; return true; }
+    long long prev = 1;
+    int sign = 1;
+    for (size_t k = 0; k + 1 < n; k++){
+        if (a[k * n + k] == 0) {
+            size_t p = k + 1;
+            while (p < n && a[p * n + k] == 0) p++;
+            if (p == n) { *det = 0; return true; }
+            swap_rows_ll(a, n, k, p);
+            sign = -sign;
+        }
+        const long long pivot = a[k * n + k];
+        for (size_t i = k + 1; i < n; i++){
+            for (size_t j = k + 1; j < n; j++){
+                long long x, y, t;
+                if (!mul_checked(a[i * n + j], pivot, &x) || !mul_checked(a[i * n + k], a[k * n + j], &y)
+                    || !sub_checked(x, y, &t)) return false;
+                a[i * n + j] = t / prev;   // Exact: every entry is a minor of the input
+            }
+        }
+        prev = pivot;
+    }
+    long long d = a[(n - 1) * n + (n - 1)];
+    if (sign < 0 && d == LLONG_MIN) return false;
+    *det = sign < 0 ? -d : d;
+    return true;
+}
+
+// Inverse of an odd number modulo 2^16 (Newton: each step doubles the correct bits)
+static uint32_t odd_inverse16(uint32_t u){
+    uint32_t inv = u;   // Correct to 3 bits
+    for (int i = 0; i < 3; i++) inv = inv * (2u - u * inv);
+    return inv & 0xFFFFu;
+}
+
+static unsigned int trailing_zeros16(uint32_t x){
+    unsigned int v = 0;
+    while (!(x & 1u)) { x >>= 1; v++; }
+    return v;
+}
+
+unsigned short det_ushort(unsigned short *a, size_t n){
+    uint32_t det = 1;
+    bool negate = false;
+    for (size_t k = 0; k < n; k++){
+        // Pivot: the entry with the fewest factors of 2, so it divides every other entry
+        size_t pr = n, pc = n;
+        unsigned int best = 16;
+        for (size_t i = k; i < n && best; i++){
+            for (size_t j = k; j < n; j++){
+                if (a[i * n + j] == 0) continue;
+                unsigned int v = trailing_zeros16(a[i * n + j]);
+                if (v < best) { best = v; pr = i; pc = j; if (!v) break; }
+            }
+        }
+        if (pr == n) return 0;
+        if (pr != k) {
+            for (size_t j = 0; j < n; j++){
+                unsigned short t = a[pr * n + j]; a[pr * n + j] = a[k * n + j]; a[k * n + j] = t;
+            }
+            negate = !negate;
+        }
+        if (pc != k) {
+            for (size_t i = 0; i < n; i++){
+                unsigned short t = a[i * n + pc]; a[i * n + pc] = a[i * n + k]; a[i * n + k] = t;
+            }
+            negate = !negate;
+        }
+
+        const uint32_t pivot = a[k * n + k];
+        det = (det * pivot) & 0xFFFFu;
+        if (det == 0) return 0;
+        const uint32_t inv = odd_inverse16(pivot >> best);
+        for (size_t i = k + 1; i < n; i++){
+            uint32_t f = (((uint32_t)a[i * n + k] >> best) * inv) & 0xFFFFu;
+            if (f == 0) continue;
+            for (size_t j = k; j < n; j++){
+                a[i * n + j] = (unsigned short)(a[i * n + j] - f * a[k * n + j]);
+            }
+        }
+    }
+    return (unsigned short)(negate ? 0u - det : det);
+}
+
+double det_lu(double *a, size_t n){
+    double det = 1.0;
+    for (size_t k = 0; k < n; k++){
+        // Partial pivoting: largest magnitude in the column
+        size_t p = k;
+        for (size_t i = k + 1; i < n; i++){
+            if (fabs(a[i * n + k]) > fabs(a[p * n + k])) p = i;
+        }
+        if (a[p * n + k] == 0.0) return 0.0;
+        if (p != k) {
+            for (size_t j = k; j < n; j++){
+                double t = a[p * n + j]; a[p * n + j] = a[k * n + j]; a[k * n + j] = t;
+            }
+            det = -det;
+        }
+        const double pivot = a[k * n + k];
+        det *= pivot;
+        for (size_t i = k + 1; i < n; i++){
+            const double f = a[i * n + k] / pivot;
+            if (f == 0.0) continue;
+            for (size_t j = k + 1; j < n; j++) a[i * n + j] -= f * a[k * n + j];
+        }
+    }
+    return det;
+}
+
+double matrice_det_real(const matrice *M, unsigned int channel){
+    if (!M || M->rows != M->cols || channel >= MATRICE_CHANNELS) return NAN;
+    const size_t n = M->rows;
+    double *a = (double *)malloc(sizeof(double) * (n ? n * n : 1));
+    if (a == NULL) return NAN;
+    for (size_t i = 0; i < n; i++)
+        for (size_t j = 0; j < n; j++) a[i * n + j] = M->data[value_index(M, i, j, channel)];
+    double det = det_lu(a, n);
+    free(a);
+    return det;
+}
+
+// Determinant of each channel modulo 2^16, as unsigned short arithmetic gives it:
+// exact Bareiss when the minors fit in 64 bits, else elimination modulo 2^16.
 pix *Det(matrice *M){
     if (M->cols != M->rows) { fprintf(stderr, "Invalid matrice\n"); return NULL; }
-    
-    // Fixed: Base case must return a COPY, because caller will try to free it
-    if (M->rows == 1) {
-        return generatePixel(M->Mat[0][0]->R, M->Mat[0][0]->G, M->Mat[0][0]->B);
-    }
 
     const size_t n = M->rows;
-    
-    // Fixed: Initialize to 0
-    pix *Det_pix = generatePixel(0, 0, 0); 
-    
-    matrice *temp = generateMatrice(n-1, n-1, 0);
-    int sign = 1; // Changed to int for easier math
-
-    for (size_t f = 0; f < n; f++){
-        cofactor(M, temp, 0, f, n);
-        
-        // Fixed: Calculate sub-determinant ONCE to prevent exponential recursion and leaks
-        pix *subDet = Det(temp);
-        
-        Det_pix->B += sign * M->Mat[0][f]->B * subDet->B;
-        Det_pix->G += sign * M->Mat[0][f]->G * subDet->G;
-        Det_pix->R += sign * M->Mat[0][f]->R * subDet->R;
-        
-        free(subDet); // Fixed: Free the sub-determinant
-        sign *= (-1);
-    }
-
-    free_matrice(temp); // Fixed: Free the temporary matrix
-    return Det_pix;     // Fixed: Added return statement
+    long long *exact = (long long *)malloc(sizeof(long long) * (n ? n * n : 1));
+    unsigned short *wrapped = NULL;
+    pix *Det_pix = generatePixel(0, 0, 0);
+    if (!exact || !Det_pix) { free(exact); free(Det_pix); return NULL; }
+
+    unsigned short result[MATRICE_CHANNELS];
+    for (unsigned int ch = 0; ch < MATRICE_CHANNELS; ch++){
+        for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < n; j++) exact[i * n + j] = M->data[value_index(M, i, j, ch)];
+        long long det;
+        if (det_bareiss(exact, n, &det)) {
+            result[ch] = (unsigned short)((unsigned long long)det & 0xFFFFu);
+            continue;
+        }
+        if (!wrapped && !(wrapped = (unsigned short *)malloc(sizeof(unsigned short) * n * n))) {
+            free(Det_pix);
+            Det_pix = NULL;
+            break;
+        }
+        for (size_t i = 0; i < n; i++)
+            for (size_t j = 0; j < n; j++) wrapped[i * n + j] = M->data[value_index(M, i, j, ch)];
+        result[ch] = det_ushort(wrapped, n);
+    }
+    if (Det_pix) {
+        Det_pix->R = result[0];
+        Det_pix->G = result[1];
+        Det_pix->B = result[2];
+    }
+    free(exact);
+    free(wrapped);
+    return Det_pix;
 }
 
 void cofactor(matrice *M, matrice *tmp, const unsigned int p, const unsigned int q, const unsigned int n){
@@ -129,10 +543,7 @@ void cofactor(matrice *M, matrice *tmp, const unsigned int p, const unsigned int
     for (unsigned int r = 0; r < n; r++) {
         for (unsigned int c = 0; c < n; c++) {
             if (r != p && c != q) {
-                // Fixed: Do not increment j++ three times for one pixel!
-                tmp->Mat[i][j]->B = M->Mat[r][c]->B;
-                tmp->Mat[i][j]->G = M->Mat[r][c]->G;
-                tmp->Mat[i][j]->R = M->Mat[r][c]->R;
+                matrice_set(tmp, i, j, matrice_get(M, r, c));
                 
                 j++; // Increment col index once per pixel
                 if (j == n - 1) {
@@ -144,24 +555,32 @@ void cofactor(matrice *M, matrice *tmp, const unsigned int p, const unsigned int
     }
 }
 
+// Copies the values of row 'from' of M, columns [c0, c1), to row 'to' of D starting at column d0
+static void copy_row_span(const matrice *M, unsigned int from, unsigned int c0, unsigned int c1,
+                          matrice *D, unsigned int to, unsigned int d0){
+    if (c1 <= c0) return;
+    size_t count = c1 - c0;
+    if (M->layout == MATRICE_INTERLEAVED) {
+        memcpy(D->data + value_index(D, to, d0, 0), M->data + value_index(M, from, c0, 0),
+               sizeof(pix) * count);
+        return;
+    }
+    for (unsigned int ch = 0; ch < MATRICE_CHANNELS; ch++){
+        memcpy(D->data + value_index(D, to, d0, ch), M->data + value_index(M, from, c0, ch),
+               sizeof(unsigned short) * count);
+    }
+}
+
 matrice *remove_row(matrice *M, unsigned short row){
     if (row >= M->rows) return NULL;
 
-    matrice *neo_M = (matrice *)malloc(sizeof(matrice));
-    neo_M->cols = M->cols;
-    neo_M->rows = M->rows - 1;
-    neo_M->Mat = (pix ***)malloc(sizeof(pix **) * neo_M->rows);
+    matrice *neo_M = matrice_create((unsigned short)(M->rows - 1), M->cols, M->layout);
+    if (neo_M == NULL) return NULL;
 
-    int target_i = 0;
+    unsigned int target_i = 0;
     for (unsigned short i = 0; i < M->rows; i++){
         if (i == row) continue;
-        neo_M->Mat[target_i] = (pix **)malloc(sizeof(pix *) * neo_M->cols);
-        for (unsigned short j = 0; j < M->cols; j++) {
-            // Fixed: Deep Copy (create new pixel) instead of Shallow Copy
-            neo_M->Mat[target_i][j] = generatePixel(
-                M->Mat[i][j]->R, M->Mat[i][j]->G, M->Mat[i][j]->B
-            );
-        }
+        copy_row_span(M, i, 0, M->cols, neo_M, target_i, 0);
         target_i++;
     }  
     return neo_M;
@@ -170,23 +589,12 @@ matrice *remove_row(matrice *M, unsigned short row){
 matrice *remove_col(matrice *M, unsigned short col){
     if (col >= M->cols) return NULL;
 
-    matrice *neo_M = (matrice *)malloc(sizeof(matrice));
-    neo_M->cols = M->cols - 1;
-    neo_M->rows = M->rows;
-    neo_M->Mat = (pix ***)malloc(sizeof(pix **) * neo_M->rows);
+    matrice *neo_M = matrice_create(M->rows, (unsigned short)(M->cols - 1), M->layout);
+    if (neo_M == NULL) return NULL;
 
     for (unsigned short i = 0; i < neo_M->rows; i++){
-        neo_M->Mat[i] = (pix **)malloc(sizeof(pix *) * neo_M->cols);
-        unsigned short target_j = 0;
-
-        for (unsigned short j = 0; j < M->cols; j++){
-            if (j == col) continue;
-            // Fixed: Deep Copy
-            neo_M->Mat[i][target_j] = generatePixel(
-                M->Mat[i][j]->R, M->Mat[i][j]->G, M->Mat[i][j]->B
-            );
-            target_j++;
-        }
+        copy_row_span(M, i, 0, col, neo_M, i, 0);
+        copy_row_span(M, i, col + 1u, M->cols, neo_M, i, col);
     }  
     return neo_M;
 }
@@ -196,7 +604,8 @@ void print_matrice(matrice *M){
     unsigned short rows = M->rows, cols = M->cols;
     for (unsigned short i = 0; i < rows; i++){
         for (unsigned short j = 0; j < cols; j++){
-            print_pixel(M->Mat[i][j]);
+            pix p = matrice_get(M, i, j);
+            print_pixel(&p);
         }
         printf("\n");
     }
@@ -206,15 +615,3 @@ void print_pixel(pix *p){
     if(p) printf("<%hu|%hu|%hu>\t", p->B, p->G, p->R);
     else printf("<NULL>\t");
 }
-
-void free_matrice(matrice *M){
-    if (M == NULL) return;
-    for (unsigned short i = 0; i < M->rows; i++){
-        for (unsigned short j = 0; j < M->cols; j++){
-            if(M->Mat[i][j]) free(M->Mat[i][j]); // Free pixels
-        }
-        free(M->Mat[i]); // Free row pointers
-    }  
-    free(M->Mat); // Free rows array
-    free(M);      // Free struct
-}
\ No newline at end of file
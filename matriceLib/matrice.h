@@ -2,6 +2,7 @@
 #define MATRICE_H
 
 #include <stddef.h> // Fixed: Required for size_t
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h> // Fixed: Required for malloc/free
 
@@ -11,26 +12,144 @@ typedef struct {
     unsigned short B;
 } pix;
 
+#define MATRICE_CHANNELS 3
+#define MATRICE_ALIGN 64        // Bytes: alignment of the buffer and of every row
+
+typedef enum {
+    MATRICE_INTERLEAVED = 0,    // R,G,B,R,G,B,... : every row is an array of pix
+    MATRICE_PLANAR              // One plane per channel: all R, then all G, then all B
+} MatriceLayout;
+
+/**
+ * @brief An image in one contiguous, MATRICE_ALIGN-aligned buffer of channel
+ * values. Value (r, c, channel) lives at
+ *   interleaved: data[r * stride + c * 3 + channel]
+ *   planar:      data[channel * plane + r * stride + c]
+ * matrice_create pads rows so each one starts on an aligned address.
+ */
 typedef struct {
     unsigned short rows;
     unsigned short cols;
-    pix ***Mat;
+    MatriceLayout layout;
+    size_t stride;              // Values from one row to the next (within a plane)
+    size_t plane;               // Values from one plane to the next (planar only)
+    unsigned short *data;
+    void *storage;              // Released by free_matrice (NULL: data is not owned)
 } matrice;
 
 // Memory Management
 pix *generatePixel(unsigned short r, unsigned short g, unsigned short b);
+
+/**
+ * @brief Interleaved r x c matrice filled by rand_fill_matrice.
+ */
 matrice *generateMatrice(unsigned short r, unsigned int c, int seed);
+
+/**
+ * @brief Zero-filled matrice in the given layout.
+ * @return NULL if out of memory
+ */
+matrice *matrice_create(unsigned short rows, unsigned short cols, MatriceLayout layout);
+
+/**
+ * @brief Copy of M in the given layout (also converts between layouts).
+ */
+matrice *matrice_convert(const matrice *M, MatriceLayout layout);
+
 void free_matrice(matrice *M);
 void free_pixel(pix *p);
 
+// Pixel Access
+
+/**
+ * @brief Pixel (r, c) by value, in any layout.
+ */
+pix matrice_get(const matrice *M, unsigned int r, unsigned int c);
+void matrice_set(matrice *M, unsigned int r, unsigned int c, pix p);
+
+/**
+ * @brief Compatibility accessor for code written against the old Mat[r][c]:
+ * a pointer into the buffer, valid until the matrice is freed.
+ * @return NULL for planar matrices or out-of-range positions
+ */
+pix *matrice_pixel(matrice *M, unsigned int r, unsigned int c);
+
+/**
+ * @brief First pixel of row r (interleaved) or NULL.
+ */
+pix *matrice_row(matrice *M, unsigned int r);
+
+/**
+ * @brief Row r of one channel's plane (planar) or NULL.
+ */
+unsigned short *matrice_channel_row(matrice *M, unsigned int channel, unsigned int r);
+
 // Matrix Operations
-void rand_fill_matrice(int seed, unsigned int r, unsigned int c, pix ***mat);
 
+/**
+ * @brief Fills every pixel with rand() % 256 per channel (R, G, B order).
+ * @param seed Reseeds rand() unless 0
+ */
+void rand_fill_matrice(matrice *M, int seed);
+
+/**
+ * @brief Transposes M in place, any shape. Square matrices keep their stride;
+ * others are packed (stride = row width, no padding) and permuted by cycle
+ * following, using one bit of scratch per pixel.
+ */
 // Fixed: Renamed to avoid conflict with the other transpose function
 void transposeMatriceInPlace(matrice *M); 
+
+/**
+ * @brief Transpose of M into Dst (cols x rows, any layout), tiled and split
+ * across threads for large images.
+ * @param Dst NULL = new matrice in M's layout; M = in place
+ * @param Diagonal 0 reflects across the main diagonal, otherwise across the anti-diagonal
+ * @return Dst, or NULL if Dst has the wrong shape or out of memory
+ */
 matrice *transposeMatrice(matrice *M, matrice *Dst, const size_t Diagonal);
 
+/**
+ * @brief Out-of-place tiled transpose (see transposeMatrice).
+ * @param anti Reflect across the anti-diagonal
+ * @param threads Worker threads (0 = default thread count; small images use one)
+ * @return false if Dst is not M->cols x M->rows or is M itself
+ */
+bool matrice_transpose_into(const matrice *M, matrice *Dst, bool anti, unsigned int threads);
+
+/**
+ * @brief Determinant of each channel modulo 2^16 (the value unsigned short
+ * arithmetic gives), in O(n^3): exact fraction-free elimination while the
+ * intermediate minors fit in 64 bits, elimination modulo 2^16 beyond that.
+ * @return Heap pixel (free with free_pixel), or NULL if M is not square
+ */
 pix *Det(matrice *M);
+
+/**
+ * @brief Real-valued determinant of one channel (0 = R, 1 = G, 2 = B) by LU
+ * decomposition with partial pivoting; may round or overflow to inf for large n.
+ * @return NAN if M is not square or out of memory
+ */
+double matrice_det_real(const matrice *M, unsigned int channel);
+
+// Determinant kernels: each destroys its row-major n x n input
+
+/**
+ * @brief Bareiss fraction-free elimination (exact).
+ * @return false if an intermediate value would overflow (*det untouched)
+ */
+bool det_bareiss(long long *a, size_t n, long long *det);
+
+/**
+ * @brief Exact determinant modulo 2^16 (elimination over Z/2^16).
+ */
+unsigned short det_ushort(unsigned short *a, size_t n);
+
+/**
+ * @brief LU decomposition with partial pivoting.
+ */
+double det_lu(double *a, size_t n);
+
 void cofactor(matrice *M, matrice *tmp, const unsigned int p, const unsigned int q, const unsigned int n);
 
 // Helpers
@@ -48,4 +167,4 @@ void inverse(unsigned short **mat, unsigned int n);
 matrice *remove_row(matrice *M, unsigned short row);
 matrice *remove_col(matrice *M, unsigned short col);
 
-#endif // MATRICE_H
\ No newline at end of file
+#endif // MATRICE_H
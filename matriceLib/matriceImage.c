@@ -0,0 +1,179 @@
+#include "matriceImage.h"
+#include "csvMap.h"
+#include "parallel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PNM_WRITE_BUFFER (1 << 20)   // stdio buffer for the output file
+
+// --- Reading ---
+
+static bool is_space(unsigned char ch) {
+    return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v' || ch == '\f';
+}
+
+// Skips whitespace and '#' comments, then reads a decimal number
+static bool header_number(const unsigned char **pos, const unsigned char *end, unsigned long *out) {
+    const unsigned char *p = *pos;
+    for (;;) {
+        while (p < end && is_space(*p)) p++;
+        if (p < end && *p == '#') {
+            while (p < end && *p != '\n') p++;
+            continue;
+        }
+        break;
+    }
+    if (p == end || *p < '0' || *p > '9') return false;
+    unsigned long v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (unsigned long)(*p - '0');
+        if (v > 0xFFFFFFFFul) return false;
+        p++;
+    }
+    *pos = p;
+    *out = v;
+    return true;
+}
+
+bool pnm_open(const char *path, PnmImage *img) {
+    memset(img, 0, sizeof(*img));
+    CsvMap *map = csv_map_open(path);
+    if (!map) return false;
+
+    const unsigned char *p = (const unsigned char *)map->data;
+    const unsigned char *end = p + map->size;
+    unsigned long width, height, maxval;
+    bool ok = map->size >= 2 && p[0] == 'P' && (p[1] == '5' || p[1] == '6');
+    if (ok) {
+        img->channels = p[1] == '6' ? 3 : 1;
+        p += 2;
+        ok = header_number(&p, end, &width) && header_number(&p, end, &height)
+             && header_number(&p, end, &maxval)
+             && p < end && is_space(*p)     // Exactly one whitespace byte before the samples
+             && maxval >= 1 && maxval <= 65535;
+    }
+    if (ok) {
+        p++;
+        img->width = (unsigned int)width;
+        img->height = (unsigned int)height;
+        img->maxval = (unsigned int)maxval;
+        img->sample_bytes = maxval > 255 ? 2 : 1;
+        img->row_bytes = (size_t)width * img->channels * img->sample_bytes;
+        ok = height == 0 || (size_t)(end - p) / height >= img->row_bytes;
+    }
+    if (!ok) {
+        csv_map_close(map);
+        memset(img, 0, sizeof(*img));
+        return false;
+    }
+    img->pixels = p;
+    img->map = map;
+    return true;
+}
+
+void pnm_close(PnmImage *img) {
+    if (!img) return;
+    csv_map_close((CsvMap *)img->map);
+    memset(img, 0, sizeof(*img));
+}
+
+typedef struct {
+    const PnmImage *img;
+    matrice *m;
+} PnmJob;
+
+static unsigned short sample_at(const unsigned char *s, unsigned int bytes) {
+    return bytes == 2 ? (unsigned short)((s[0] << 8) | s[1]) : s[0];
+}
+
+static void decode_rows(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    const PnmJob *job = (const PnmJob *)ctx;
+    const PnmImage *img = job->img;
+    matrice *m = job->m;
+    const unsigned int bytes = img->sample_bytes, step = img->channels * bytes;
+    (void)worker;
+
+    for (size_t r = begin; r < end; r++) {
+        const unsigned char *s = img->pixels + r * img->row_bytes;
+        pix *row = matrice_row(m, (unsigned int)r);
+        if (row && img->channels == 3 && bytes == 1) {
+            for (unsigned int c = 0; c < img->width; c++, s += 3) {
+                row[c].R = s[0];
+                row[c].G = s[1];
+                row[c].B = s[2];
+            }
+            continue;
+        }
+        for (unsigned int c = 0; c < img->width; c++, s += step) {
+            pix p;
+            p.R = sample_at(s, bytes);
+            p.G = img->channels == 3 ? sample_at(s + bytes, bytes) : p.R;
+            p.B = img->channels == 3 ? sample_at(s + 2 * bytes, bytes) : p.R;
+            matrice_set(m, (unsigned int)r, c, p);
+        }
+    }
+}
+
+matrice *matrice_from_pnm(const PnmImage *img, MatriceLayout layout) {
+    if (!img || !img->map || img->width > 65535 || img->height > 65535) return NULL;
+    matrice *m = matrice_create((unsigned short)img->height, (unsigned short)img->width, layout);
+    if (!m) return NULL;
+    PnmJob job = {img, m};
+    parallel_for(img->height, 0, decode_rows, &job);
+    return m;
+}
+
+matrice *matrice_read_pnm(const char *path, MatriceLayout layout, unsigned int *maxval) {
+    PnmImage img;
+    if (!pnm_open(path, &img)) return NULL;
+    matrice *m = matrice_from_pnm(&img, layout);
+    if (m && maxval) *maxval = img.maxval;
+    pnm_close(&img);
+    return m;
+}
+
+// --- Writing ---
+
+static unsigned char *put_sample(unsigned char *out, unsigned int v, unsigned int maxval) {
+    if (v > maxval) v = maxval;
+    if (maxval > 255) *out++ = (unsigned char)(v >> 8);
+    *out++ = (unsigned char)v;
+    return out;
+}
+
+bool matrice_write_pnm(const matrice *M, const char *path, unsigned int channels, unsigned int maxval) {
+    if (!M || !path || (channels != 1 && channels != 3) || maxval < 1 || maxval > 65535) return false;
+    const size_t row_bytes = (size_t)M->cols * channels * (maxval > 255 ? 2 : 1);
+    unsigned char *line = (unsigned char *)malloc(row_bytes ? row_bytes : 1);
+    if (!line) return false;
+
+    bool is_stdout = strcmp(path, "-") == 0;
+    FILE *out = is_stdout ? stdout : fopen(path, "wb");
+    if (!out) {
+        perror("Error opening output file");
+        free(line);
+        return false;
+    }
+    if (!is_stdout) setvbuf(out, NULL, _IOFBF, PNM_WRITE_BUFFER);
+
+    bool ok = fprintf(out, "P%c\n%hu %hu\n%u\n", channels == 3 ? '6' : '5', M->cols, M->rows, maxval) > 0;
+    for (unsigned int r = 0; ok && r < M->rows; r++) {
+        unsigned char *o = line;
+        for (unsigned int c = 0; c < M->cols; c++) {
+            pix p = matrice_get(M, r, c);
+            if (channels == 3) {
+                o = put_sample(o, p.R, maxval);
+                o = put_sample(o, p.G, maxval);
+                o = put_sample(o, p.B, maxval);
+            } else {
+                o = put_sample(o, (299u * p.R + 587u * p.G + 114u * p.B + 500u) / 1000u, maxval);
+            }
+        }
+        ok = fwrite(line, 1, row_bytes, out) == row_bytes;
+    }
+    if (is_stdout) ok = fflush(out) == 0 && ok;
+    else if (fclose(out) != 0) ok = false;
+    free(line);
+    return ok;
+}
@@ -0,0 +1,56 @@
+#ifndef MATRICE_IMAGE_H
+#define MATRICE_IMAGE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "matrice.h"
+
+// --- Binary PPM / PGM Images ---
+//
+// P6 (PPM, RGB) and P5 (PGM, gray) with 8-bit samples (maxval <= 255) or
+// 16-bit big-endian samples (maxval up to 65535). Files are mapped, not read:
+// pnm_open exposes the samples in place, and the matrice readers decode them
+// straight from the mapping into the matrice buffer.
+
+typedef struct {
+    unsigned int width;
+    unsigned int height;
+    unsigned int channels;          // 3 (P6) or 1 (P5)
+    unsigned int maxval;            // Largest sample value, 1..65535
+    unsigned int sample_bytes;      // 1, or 2 when maxval > 255
+    const unsigned char *pixels;    // First sample of the first row, inside the mapping
+    size_t row_bytes;               // width * channels * sample_bytes
+    void *map;                      // CsvMap holding the file
+} PnmImage;
+
+/**
+ * @brief Maps a binary PPM/PGM file and parses its header (comments allowed).
+ * @return false if the file cannot be read, is not P5/P6, or is truncated
+ */
+bool pnm_open(const char *path, PnmImage *img);
+
+void pnm_close(PnmImage *img);
+
+/**
+ * @brief Decodes a mapped image into a new matrice (rows split across threads).
+ * Gray images set R = G = B. Samples keep their values (0..maxval).
+ * @return NULL if out of memory or wider / taller than 65535
+ */
+matrice *matrice_from_pnm(const PnmImage *img, MatriceLayout layout);
+
+/**
+ * @brief pnm_open + matrice_from_pnm + pnm_close.
+ * @param maxval Optional: the file's maxval
+ */
+matrice *matrice_read_pnm(const char *path, MatriceLayout layout, unsigned int *maxval);
+
+/**
+ * @brief Writes M as P6 (channels 3) or P5 (channels 1, Rec. 601 luma of R, G, B),
+ * one row at a time. Samples above maxval are clamped.
+ * @param path Output file ("-" = stdout)
+ * @param maxval 1..65535; above 255 samples are written as 16 bits
+ * @return false on an invalid argument or write error
+ */
+bool matrice_write_pnm(const matrice *M, const char *path, unsigned int channels, unsigned int maxval);
+
+#endif // MATRICE_IMAGE_H
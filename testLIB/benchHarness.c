@@ -0,0 +1,660 @@
+#define _GNU_SOURCE
+
+#include "benchHarness.h"
+#include "universal.h"
+#include "parallel.h"
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#define BENCH_MAX_CALLS_PER_SAMPLE 100000000u
+
+volatile double bench_sink;
+
+BenchOptions bench_default_options(void) {
+    BenchOptions o;
+    memset(&o, 0, sizeof(o));
+    o.warmup = 3;
+    o.repetitions = 15;
+    o.min_sample_ns = 2e6;      // 2 ms
+    o.seed = 12345;
+    return o;
+}
+
+bool bench_parse_sizes(const char *list, size_t sizes[BENCH_MAX_SIZES]) {
+    size_t n = 0;
+    const char *p = list;
+    if (!p || !*p) return false;
+    while (*p) {
+        char *end;
+        errno = 0;
+        double v = strtod(p, &end); // Accepts 1e5 as well as 100000
+        if (end == p || errno || !(v >= 1.0) || v > 1e15 || v != floor(v) || n == BENCH_MAX_SIZES - 1) {
+            return false;
+        }
+        sizes[n++] = (size_t)v;
+        p = end;
+        if (*p == ',') p++;
+        else if (*p) return false;
+    }
+    sizes[n] = 0;
+    return n > 0;
+}
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+bool bench_selected(const BenchCase *c, const BenchOptions *opts) {
+    return !opts->filter || !*opts->filter || strstr(c->name, opts->filter) != NULL;
+}
+
+// --- Hardware Counters ---
+
+enum { COUNTER_CYCLES, COUNTER_INSTRUCTIONS, COUNTER_CACHE_MISSES, COUNTER_BRANCH_MISSES, COUNTER_COUNT };
+
+typedef struct {
+    int fd[COUNTER_COUNT];
+    uint64_t total[COUNTER_COUNT];
+    bool open;
+} Counters;
+
+#ifdef __linux__
+static int counter_open(uint64_t config) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+// All four or none: a partial set would make per-item figures inconsistent
+static bool counters_open(Counters *c) {
+    memset(c, 0, sizeof(*c));
+    for (int i = 0; i < COUNTER_COUNT; i++) c->fd[i] = -1;
+#ifdef __linux__
+    static const uint64_t config[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+    };
+    c->open = true;
+    for (int i = 0; i < COUNTER_COUNT && c->open; i++) {
+        c->fd[i] = counter_open(config[i]);
+        if (c->fd[i] < 0) c->open = false;
+    }
+    if (!c->open) {
+        for (int i = 0; i < COUNTER_COUNT; i++) {
+            if (c->fd[i] >= 0) close(c->fd[i]);
+            c->fd[i] = -1;
+        }
+    }
+#endif
+    return c->open;
+}
+
+static void counters_enable(Counters *c, bool on) {
+#ifdef __linux__
+    for (int i = 0; c->open && i < COUNTER_COUNT; i++) {
+        ioctl(c->fd[i], on ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+    }
+#else
+    (void)c;
+    (void)on;
+#endif
+}
+
+static void counters_close(Counters *c) {
+#ifdef __linux__
+    for (int i = 0; c->open && i < COUNTER_COUNT; i++) {
+        uint64_t v = 0;
+        if (read(c->fd[i], &v, sizeof(v)) == (ssize_t)sizeof(v)) c->total[i] = v;
+        close(c->fd[i]);
+    }
+#else
+    (void)c;
+#endif
+}
+
+// --- Measurement ---
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// Linear interpolation between closest ranks of an ascending array
+static double percentile(const double *sorted, size_t n, double q) {
+    if (n == 0) return 0.0;
+    double pos = q * (double)(n - 1);
+    size_t lo = (size_t)pos;
+    if (lo + 1 >= n) return sorted[n - 1];
+    return sorted[lo] + (pos - (double)lo) * (sorted[lo + 1] - sorted[lo]);
+}
+
+// Sorts the samples and derives the order statistics
+static void summarize(BenchResult *r) {
+    size_t n = r->repetitions;
+    qsort(r->samples, n, sizeof(double), compare_double);
+    r->min = r->samples[0];
+    r->p10 = percentile(r->samples, n, 0.10);
+    r->median = percentile(r->samples, n, 0.50);
+    r->p90 = percentile(r->samples, n, 0.90);
+    r->max = r->samples[n - 1];
+    r->items_per_sec = r->median > 0.0 ? 1e9 / r->median : 0.0;
+}
+
+bool bench_run_case(const BenchCase *c, size_t size, const BenchOptions *opts, BenchResult *result) {
+    void *state = c->setup ? c->setup(size, opts->seed) : NULL;
+    if (c->setup && !state) return false;
+
+    unsigned int reps = opts->repetitions ? opts->repetitions : 1;
+    double *samples = malloc(sizeof(double) * reps);
+    if (!samples) {
+        if (c->teardown) c->teardown(state);
+        return false;
+    }
+
+    // Warm-up; the last call also sizes the samples
+    size_t items = 0;
+    uint64_t call_ns = 0;
+    for (unsigned int w = 0; w <= opts->warmup; w++) {
+        uint64_t t0 = bench_now_ns();
+        items = c->run(state);
+        call_ns = bench_now_ns() - t0;
+    }
+    size_t calls = 1;
+    if ((double)call_ns < opts->min_sample_ns) {
+        double want = ceil(opts->min_sample_ns / (double)(call_ns ? call_ns : 1));
+        calls = want > BENCH_MAX_CALLS_PER_SAMPLE ? BENCH_MAX_CALLS_PER_SAMPLE : (size_t)want;
+    }
+    if (items == 0) items = 1;
+
+    Counters counters;
+    if (opts->counters) counters_open(&counters);
+    else memset(&counters, 0, sizeof(counters));
+
+    for (unsigned int r = 0; r < reps; r++) {
+        counters_enable(&counters, true);
+        uint64_t t0 = bench_now_ns();
+        for (size_t k = 0; k < calls; k++) c->run(state);
+        uint64_t elapsed = bench_now_ns() - t0;
+        counters_enable(&counters, false);
+        samples[r] = (double)elapsed / ((double)calls * (double)items);
+    }
+    counters_close(&counters);
+    if (c->teardown) c->teardown(state);
+
+    memset(result, 0, sizeof(*result));
+    result->name = c->name;
+    result->size = size;
+    result->repetitions = reps;
+    result->calls_per_sample = calls;
+    result->items = items;
+    result->samples = samples;
+    summarize(result);
+    if (counters.open) {
+        double total_items = (double)reps * (double)calls * (double)items;
+        result->has_counters = true;
+        result->cycles = (double)counters.total[COUNTER_CYCLES] / total_items;
+        result->instructions = (double)counters.total[COUNTER_INSTRUCTIONS] / total_items;
+        result->cache_misses = (double)counters.total[COUNTER_CACHE_MISSES] / total_items;
+        result->branch_misses = (double)counters.total[COUNTER_BRANCH_MISSES] / total_items;
+    }
+    return true;
+}
+
+void bench_result_free(BenchResult *result) {
+    if (!result) return;
+    free(result->samples);
+    result->samples = NULL;
+}
+
+// --- Output ---
+
+void bench_print_header(FILE *out) {
+    fprintf(out, "%-40s %10s %12s %12s %12s %14s\n", "benchmark", "size", "median ns", "p10 ns", "p90 ns", "items/s");
+}
+
+void bench_print_result(FILE *out, const BenchResult *r) {
+    fprintf(out, "%-40s %10zu %12.3f %12.3f %12.3f %14.4g", r->name, r->size, r->median, r->p10, r->p90, r->items_per_sec);
+    if (r->has_counters) {
+        fprintf(out, "  (%.1f cyc, %.1f ins, %.3f cache-miss, %.3f br-miss /item)",
+                r->cycles, r->instructions, r->cache_misses, r->branch_misses);
+    }
+    fprintf(out, "\n");
+}
+
+// --- Environment ---
+
+static void copy_text(char *dst, size_t cap, const char *src) {
+    snprintf(dst, cap, "%s", src ? src : "unknown");
+}
+
+void bench_environment(BenchEnvironment *env, const char *flags) {
+    memset(env, 0, sizeof(*env));
+    copy_text(env->cpu, sizeof(env->cpu), NULL);
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    char line[512];
+    while (f && fgets(line, sizeof(line), f)) {
+        char *colon = strchr(line, ':');
+        if (colon && strncmp(line, "model name", 10) == 0) {
+            colon += 1 + strspn(colon + 1, " \t");
+            colon[strcspn(colon, "\n")] = '\0';
+            copy_text(env->cpu, sizeof(env->cpu), colon);
+            break;
+        }
+    }
+    if (f) fclose(f);
+
+#ifdef __VERSION__
+    copy_text(env->compiler, sizeof(env->compiler), __VERSION__);
+#else
+    copy_text(env->compiler, sizeof(env->compiler), NULL);
+#endif
+    copy_text(env->flags, sizeof(env->flags), flags);
+
+    // The instruction sets this build was allowed to use
+    static const char *const simd[] = {
+#ifdef __SSE2__
+        "sse2",
+#endif
+#ifdef __SSE4_2__
+        "sse4.2",
+#endif
+#ifdef __AVX__
+        "avx",
+#endif
+#ifdef __AVX2__
+        "avx2",
+#endif
+#ifdef __FMA__
+        "fma",
+#endif
+#ifdef __AVX512F__
+        "avx512f",
+#endif
+#ifdef __ARM_NEON
+        "neon",
+#endif
+        NULL
+    };
+    size_t len = 0;
+    for (size_t i = 0; simd[i] && len < sizeof(env->simd); i++) {
+        len += (size_t)snprintf(env->simd + len, sizeof(env->simd) - len, "%s%s", len ? " " : "", simd[i]);
+    }
+    if (!simd[0]) copy_text(env->simd, sizeof(env->simd), "none");
+    env->threads = parallel_resolve_threads(0);
+}
+
+bool bench_environment_matches(const BenchEnvironment *a, const BenchEnvironment *b) {
+    return strcmp(a->cpu, b->cpu) == 0 && strcmp(a->compiler, b->compiler) == 0 &&
+           strcmp(a->flags, b->flags) == 0 && strcmp(a->simd, b->simd) == 0;
+}
+
+static void json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        unsigned char ch = (unsigned char)*s;
+        if (ch == '"' || ch == '\\') fprintf(out, "\\%c", ch);
+        else if (ch < 0x20) fprintf(out, "\\u%04x", ch);
+        else fputc(ch, out);
+    }
+    fputc('"', out);
+}
+
+bool bench_write_json(FILE *out, const BenchResult results[], size_t count, const BenchOptions *opts,
+                      const BenchEnvironment *env) {
+    fprintf(out, "{\n  \"version\": ");
+    json_string(out, CALC_LIB_VERSION);
+    if (env) {
+        fprintf(out, ",\n  \"environment\": {\"cpu\": ");
+        json_string(out, env->cpu);
+        fprintf(out, ", \"compiler\": ");
+        json_string(out, env->compiler);
+        fprintf(out, ", \"flags\": ");
+        json_string(out, env->flags);
+        fprintf(out, ", \"simd\": ");
+        json_string(out, env->simd);
+        fprintf(out, ", \"threads\": %u}", env->threads);
+    }
+    fprintf(out, ",\n  \"warmup\": %u,\n  \"repetitions\": %u,\n  \"min_sample_ns\": %.0f,\n  \"seed\": %u,\n",
+            opts->warmup, opts->repetitions, opts->min_sample_ns, opts->seed);
+    fprintf(out, "  \"benchmarks\": [");
+    for (size_t i = 0; i < count; i++) {
+        const BenchResult *r = &results[i];
+        fprintf(out, "%s\n    {\"name\": ", i ? "," : "");
+        json_string(out, r->name);
+        fprintf(out, ", \"size\": %zu, \"items\": %zu, \"calls_per_sample\": %zu,\n", r->size, r->items, r->calls_per_sample);
+        fprintf(out, "     \"ns_per_item\": {\"min\": %.6g, \"p10\": %.6g, \"median\": %.6g, \"p90\": %.6g, \"max\": %.6g},\n",
+                r->min, r->p10, r->median, r->p90, r->max);
+        fprintf(out, "     \"items_per_sec\": %.6g,\n", r->items_per_sec);
+        if (r->has_counters) {
+            fprintf(out, "     \"per_item\": {\"cycles\": %.6g, \"instructions\": %.6g, \"cache_misses\": %.6g, \"branch_misses\": %.6g},\n",
+                    r->cycles, r->instructions, r->cache_misses, r->branch_misses);
+        }
+        fprintf(out, "     \"samples_ns\": [");
+        for (unsigned int s = 0; s < r->repetitions; s++) fprintf(out, "%s%.6g", s ? ", " : "", r->samples[s]);
+        fprintf(out, "]}");
+    }
+    fprintf(out, "\n  ]\n}\n");
+    return !ferror(out);
+}
+
+// --- Result Files ---
+
+typedef struct {
+    const char *p;
+    const char *end;
+} JsonReader;
+
+static void json_ws(JsonReader *j) {
+    while (j->p < j->end && (*j->p == ' ' || *j->p == '\t' || *j->p == '\n' || *j->p == '\r')) j->p++;
+}
+
+static bool json_take(JsonReader *j, char ch) {
+    json_ws(j);
+    if (j->p < j->end && *j->p == ch) {
+        j->p++;
+        return true;
+    }
+    return false;
+}
+
+// Into 'dst' (truncated to cap - 1); only the escapes bench_write_json produces
+static bool json_read_string(JsonReader *j, char *dst, size_t cap) {
+    size_t len = 0;
+    if (!json_take(j, '"')) return false;
+    while (j->p < j->end && *j->p != '"') {
+        char ch = *j->p++;
+        if (ch == '\\') {
+            if (j->p >= j->end) return false;
+            ch = *j->p++;
+            if (ch == 'u') {
+                if (j->end - j->p < 4) return false;
+                ch = (char)strtol((char[]){j->p[0], j->p[1], j->p[2], j->p[3], '\0'}, NULL, 16);
+                j->p += 4;
+            } else if (ch == 'n') {
+                ch = '\n';
+            } else if (ch == 't') {
+                ch = '\t';
+            }
+        }
+        if (len + 1 < cap) dst[len++] = ch;
+    }
+    if (cap) dst[len] = '\0';
+    return json_take(j, '"');
+}
+
+static bool json_read_number(JsonReader *j, double *out) {
+    json_ws(j);
+    char buf[64];
+    size_t n = 0;
+    while (j->p + n < j->end && n < sizeof(buf) - 1 && strchr("+-.0123456789eE", j->p[n])) {
+        buf[n] = j->p[n];
+        n++;
+    }
+    buf[n] = '\0';
+    char *end;
+    *out = strtod(buf, &end);
+    if (n == 0 || *end) return false;
+    j->p += n;
+    return true;
+}
+
+static bool json_skip_value(JsonReader *j, int depth) {
+    json_ws(j);
+    if (j->p >= j->end || depth > 32) return false;
+    char ch = *j->p;
+    if (ch == '"') return json_read_string(j, NULL, 0);
+    if (ch == '{' || ch == '[') {
+        char close = ch == '{' ? '}' : ']';
+        j->p++;
+        if (json_take(j, close)) return true;
+        do {
+            if (ch == '{' && (!json_read_string(j, NULL, 0) || !json_take(j, ':'))) return false;
+            if (!json_skip_value(j, depth + 1)) return false;
+        } while (json_take(j, ','));
+        return json_take(j, close);
+    }
+    const char *word = ch == 't' ? "true" : ch == 'f' ? "false" : ch == 'n' ? "null" : NULL;
+    if (word) {
+        size_t n = strlen(word);
+        if ((size_t)(j->end - j->p) < n || memcmp(j->p, word, n) != 0) return false;
+        j->p += n;
+        return true;
+    }
+    double ignored;
+    return json_read_number(j, &ignored);
+}
+
+static bool read_environment(JsonReader *j, BenchEnvironment *env) {
+    if (!json_take(j, '{')) return false;
+    if (json_take(j, '}')) return true;
+    do {
+        char key[32];
+        if (!json_read_string(j, key, sizeof(key)) || !json_take(j, ':')) return false;
+        bool ok;
+        if (strcmp(key, "cpu") == 0) ok = json_read_string(j, env->cpu, sizeof(env->cpu));
+        else if (strcmp(key, "compiler") == 0) ok = json_read_string(j, env->compiler, sizeof(env->compiler));
+        else if (strcmp(key, "flags") == 0) ok = json_read_string(j, env->flags, sizeof(env->flags));
+        else if (strcmp(key, "simd") == 0) ok = json_read_string(j, env->simd, sizeof(env->simd));
+        else if (strcmp(key, "threads") == 0) {
+            double v;
+            ok = json_read_number(j, &v);
+            env->threads = (unsigned int)v;
+        } else ok = json_skip_value(j, 1);
+        if (!ok) return false;
+    } while (json_take(j, ','));
+    return json_take(j, '}');
+}
+
+static bool read_samples(JsonReader *j, BenchResult *r) {
+    size_t cap = 16;
+    free(r->samples);
+    r->samples = malloc(sizeof(double) * cap);
+    r->repetitions = 0;
+    if (!r->samples || !json_take(j, '[')) return false;
+    if (json_take(j, ']')) return true;
+    do {
+        if (r->repetitions == cap) {
+            double *grown = realloc(r->samples, sizeof(double) * cap * 2);
+            if (!grown) return false;
+            r->samples = grown;
+            cap *= 2;
+        }
+        if (!json_read_number(j, &r->samples[r->repetitions])) return false;
+        r->repetitions++;
+    } while (json_take(j, ','));
+    return json_take(j, ']');
+}
+
+static bool read_result(JsonReader *j, BenchResult *r) {
+    char name[256] = "";
+    if (!json_take(j, '{')) return false;
+    if (!json_take(j, '}')) {
+        do {
+            char key[32];
+            double v = 0.0;
+            bool ok;
+            if (!json_read_string(j, key, sizeof(key)) || !json_take(j, ':')) return false;
+            if (strcmp(key, "name") == 0) ok = json_read_string(j, name, sizeof(name));
+            else if (strcmp(key, "samples_ns") == 0) ok = read_samples(j, r);
+            else if (strcmp(key, "size") == 0 || strcmp(key, "items") == 0 || strcmp(key, "calls_per_sample") == 0) {
+                ok = json_read_number(j, &v) && v >= 0.0;
+                if (key[0] == 's') r->size = (size_t)v;
+                else if (key[0] == 'i') r->items = (size_t)v;
+                else r->calls_per_sample = (size_t)v;
+            } else ok = json_skip_value(j, 1);
+            if (!ok) return false;
+        } while (json_take(j, ','));
+        if (!json_take(j, '}')) return false;
+    }
+    if (!name[0] || r->repetitions == 0) return false;
+    r->name = strdup(name);
+    if (!r->name) return false;
+    summarize(r);
+    return true;
+}
+
+static bool read_report(JsonReader *j, BenchReport *report) {
+    bool have_results = false;
+    if (!json_take(j, '{')) return false;
+    do {
+        char key[32];
+        if (!json_read_string(j, key, sizeof(key)) || !json_take(j, ':')) return false;
+        if (strcmp(key, "environment") == 0) {
+            if (!read_environment(j, &report->env)) return false;
+        } else if (strcmp(key, "benchmarks") == 0) {
+            size_t cap = 0;
+            have_results = true;
+            if (!json_take(j, '[')) return false;
+            if (json_take(j, ']')) continue;
+            do {
+                if (report->count == cap) {
+                    size_t grown_cap = cap ? cap * 2 : 32;
+                    BenchResult *grown = realloc(report->results, sizeof(BenchResult) * grown_cap);
+                    if (!grown) return false;
+                    memset(grown + cap, 0, sizeof(BenchResult) * (grown_cap - cap));
+                    report->results = grown;
+                    cap = grown_cap;
+                }
+                // Counted before reading so a half-read entry is still freed
+                if (!read_result(j, &report->results[report->count++])) return false;
+            } while (json_take(j, ','));
+            if (!json_take(j, ']')) return false;
+        } else if (!json_skip_value(j, 1)) {
+            return false;
+        }
+    } while (json_take(j, ','));
+    return have_results && json_take(j, '}');
+}
+
+BenchReport *bench_load_json(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    size_t cap = 1 << 16, len = 0;
+    char *text = malloc(cap);
+    size_t got;
+    while (text && (got = fread(text + len, 1, cap - len, f)) > 0) {
+        len += got;
+        if (len == cap) {
+            char *grown = realloc(text, cap * 2);
+            if (!grown) free(text);
+            text = grown;
+            cap *= 2;
+        }
+    }
+    fclose(f);
+
+    BenchReport *report = text ? calloc(1, sizeof(BenchReport)) : NULL;
+    if (report) {
+        copy_text(report->env.cpu, sizeof(report->env.cpu), NULL);
+        copy_text(report->env.compiler, sizeof(report->env.compiler), NULL);
+        copy_text(report->env.flags, sizeof(report->env.flags), NULL);
+        copy_text(report->env.simd, sizeof(report->env.simd), NULL);
+        JsonReader j = {text, text + len};
+        if (!read_report(&j, report)) {
+            bench_report_free(report);
+            report = NULL;
+        }
+    }
+    free(text);
+    return report;
+}
+
+void bench_report_free(BenchReport *report) {
+    if (!report) return;
+    for (size_t i = 0; i < report->count; i++) {
+        free((char *)report->results[i].name);
+        bench_result_free(&report->results[i]);
+    }
+    free(report->results);
+    free(report);
+}
+
+// --- Regression Comparison ---
+
+typedef struct {
+    double value;
+    bool from_b;
+} RankedSample;
+
+static int compare_ranked(const void *x, const void *y) {
+    return compare_double(&((const RankedSample *)x)->value, &((const RankedSample *)y)->value);
+}
+
+double bench_mann_whitney(const double *a, size_t na, const double *b, size_t nb) {
+    size_t n = na + nb;
+    if (na == 0 || nb == 0) return 1.0;
+    RankedSample *all = malloc(sizeof(RankedSample) * n);
+    if (!all) return 1.0;
+    for (size_t i = 0; i < na; i++) all[i] = (RankedSample){a[i], false};
+    for (size_t i = 0; i < nb; i++) all[na + i] = (RankedSample){b[i], true};
+    qsort(all, n, sizeof(RankedSample), compare_ranked);
+
+    // Rank sum of b, ties sharing their average rank
+    double rank_b = 0.0, ties = 0.0;
+    for (size_t i = 0; i < n;) {
+        size_t k = i;
+        while (k < n && all[k].value == all[i].value) k++;
+        double t = (double)(k - i), rank = (double)(i + k + 1) / 2.0;
+        for (size_t m = i; m < k; m++) if (all[m].from_b) rank_b += rank;
+        ties += t * t * t - t;
+        i = k;
+    }
+    free(all);
+
+    double u = rank_b - (double)nb * ((double)nb + 1.0) / 2.0;
+    double mean = (double)na * (double)nb / 2.0;
+    double var = (double)na * (double)nb / 12.0 * (((double)n + 1.0) - ties / ((double)n * ((double)n - 1.0)));
+    if (var <= 0.0) return 1.0;     // Every sample equal
+    double z = (u - mean - 0.5) / sqrt(var);
+    return 0.5 * erfc(z / sqrt(2.0));
+}
+
+size_t bench_compare(const BenchReport *baseline, const BenchResult current[], size_t count,
+                     double threshold, double alpha, BenchComparison out[]) {
+    size_t written = 0;
+    for (size_t i = 0; i < count; i++) {
+        const BenchResult *cur = &current[i], *base = NULL;
+        for (size_t k = 0; k < baseline->count && !base; k++) {
+            const BenchResult *b = &baseline->results[k];
+            if (b->size == cur->size && strcmp(b->name, cur->name) == 0) base = b;
+        }
+        if (!base) continue;
+
+        BenchComparison *c = &out[written++];
+        c->name = cur->name;
+        c->size = cur->size;
+        c->base_median = base->median;
+        c->new_median = cur->median;
+        c->change = base->median > 0.0 ? cur->median / base->median - 1.0 : 0.0;
+        c->p_slower = bench_mann_whitney(base->samples, base->repetitions, cur->samples, cur->repetitions);
+        c->p_faster = bench_mann_whitney(cur->samples, cur->repetitions, base->samples, base->repetitions);
+        c->regression = c->change > threshold && c->p_slower < alpha;
+        c->improvement = c->change < -threshold && c->p_faster < alpha;
+    }
+    return written;
+}
+
+void bench_print_comparison(FILE *out, const BenchComparison *c) {
+    fprintf(out, "%-40s %10zu %12.3f %12.3f %+8.1f%%  p=%-8.2g %s\n", c->name, c->size, c->base_median,
+            c->new_median, 100.0 * c->change, c->change >= 0.0 ? c->p_slower : c->p_faster,
+            c->regression ? "REGRESSION" : c->improvement ? "improved" : "");
+}
@@ -0,0 +1,170 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// --- Microbenchmark Harness ---
+//
+// A case builds its input once per size (setup), then run() is called
+// repeatedly: a few untimed warm-up calls, then 'repetitions' timed samples.
+// Each sample repeats run() until it lasts at least min_sample_ns, so fast
+// operations are not lost in timer resolution. Times are reported per item.
+
+#define BENCH_MAX_SIZES 8
+
+typedef struct {
+    const char *name;                       // "group/function"
+    void *(*setup)(size_t size, unsigned int seed);
+    size_t (*run)(void *state);             // One call; returns the items it processed
+    void (*teardown)(void *state);
+    size_t sizes[BENCH_MAX_SIZES];          // Default sizes (zero-terminated)
+    size_t max_size;                        // Larger requested sizes are skipped (0 = no limit)
+} BenchCase;
+
+typedef struct {
+    unsigned int warmup;                    // Untimed calls before sampling
+    unsigned int repetitions;               // Timed samples
+    double min_sample_ns;                   // Minimum duration of one sample
+    bool counters;                          // Hardware counters via perf_event_open
+    const char *filter;                     // Substring of the case names to run (NULL = all)
+    size_t sizes[BENCH_MAX_SIZES];          // Overrides every case's sizes (zero-terminated; empty = defaults)
+    unsigned int seed;                      // Passed to setup
+} BenchOptions;
+
+typedef struct {
+    const char *name;
+    size_t size;
+    unsigned int repetitions;
+    size_t calls_per_sample;
+    size_t items;                           // Items per sample
+    double *samples;                        // ns per item, one per repetition, ascending
+    double min, p10, median, p90, max;      // ns per item
+    double items_per_sec;                   // At the median
+    bool has_counters;
+    double cycles, instructions;            // Per item, over all samples
+    double cache_misses, branch_misses;
+} BenchResult;
+
+/**
+ * @brief Where the numbers came from; comparisons across different
+ * environments are flagged.
+ */
+typedef struct {
+    char cpu[128];          // Model name from /proc/cpuinfo ("unknown" elsewhere)
+    char compiler[96];
+    char flags[256];        // Build flags (as passed to bench_environment)
+    char simd[96];          // Vector instruction sets the build may use, e.g. "sse2 avx2"
+    unsigned int threads;   // Default thread count
+} BenchEnvironment;
+
+/**
+ * @brief A result file read back by bench_load_json.
+ */
+typedef struct {
+    BenchEnvironment env;
+    BenchResult *results;   // Names and samples owned by the report
+    size_t count;
+} BenchReport;
+
+typedef struct {
+    const char *name;
+    size_t size;
+    double base_median;     // ns per item
+    double new_median;
+    double change;          // new / base - 1
+    double p_slower;        // Mann-Whitney one-sided p-value: new samples larger
+    double p_faster;        // ... new samples smaller
+    bool regression;        // Slower beyond the threshold and significant
+    bool improvement;       // Faster beyond the threshold and significant
+} BenchComparison;
+
+/**
+ * @brief Written by benchmark bodies so the compiler cannot drop their work.
+ */
+extern volatile double bench_sink;
+
+BenchOptions bench_default_options(void);
+
+/**
+ * @brief Parses "1000,1e5,64" into a zero-terminated size list.
+ * @return false if the list is empty, malformed or too long
+ */
+bool bench_parse_sizes(const char *list, size_t sizes[BENCH_MAX_SIZES]);
+
+/**
+ * @brief Monotonic clock in nanoseconds.
+ */
+uint64_t bench_now_ns(void);
+
+/**
+ * @brief True if 'c' runs under 'opts' (name filter).
+ */
+bool bench_selected(const BenchCase *c, const BenchOptions *opts);
+
+/**
+ * @brief Measures one case at one size.
+ * @return false if setup fails (result untouched); free the result with bench_result_free
+ */
+bool bench_run_case(const BenchCase *c, size_t size, const BenchOptions *opts, BenchResult *result);
+
+void bench_result_free(BenchResult *result);
+
+/**
+ * @brief One aligned text line per result; bench_print_header prints the column titles.
+ */
+void bench_print_header(FILE *out);
+void bench_print_result(FILE *out, const BenchResult *r);
+
+/**
+ * @brief Fills 'env' for this process and build.
+ * @param flags Build flags to record (NULL = unknown)
+ */
+void bench_environment(BenchEnvironment *env, const char *flags);
+
+/**
+ * @brief True if CPU, compiler, flags and SIMD sets all match.
+ */
+bool bench_environment_matches(const BenchEnvironment *a, const BenchEnvironment *b);
+
+/**
+ * @brief Writes the run as one JSON document (environment, options, then
+ * every result with its samples).
+ * @param env Optional
+ */
+bool bench_write_json(FILE *out, const BenchResult results[], size_t count, const BenchOptions *opts,
+                      const BenchEnvironment *env);
+
+/**
+ * @brief Reads a file written by bench_write_json.
+ * @return Report (free with bench_report_free), or NULL if unreadable or malformed
+ */
+BenchReport *bench_load_json(const char *path);
+
+void bench_report_free(BenchReport *report);
+
+// --- Regression Comparison ---
+
+/**
+ * @brief One-sided Mann-Whitney U test (normal approximation with tie and
+ * continuity corrections).
+ * @return p-value for "samples of b tend to be larger than samples of a"
+ */
+double bench_mann_whitney(const double *a, size_t na, const double *b, size_t nb);
+
+/**
+ * @brief Compares every current result with the baseline entry of the same
+ * name and size. An entry is a regression when its median is more than
+ * 'threshold' (0.05 = 5%) slower and the U test gives p < alpha; unmatched
+ * results are skipped.
+ * @param out At least 'count' entries
+ * @return Number of comparisons written
+ */
+size_t bench_compare(const BenchReport *baseline, const BenchResult current[], size_t count,
+                     double threshold, double alpha, BenchComparison out[]);
+
+void bench_print_comparison(FILE *out, const BenchComparison *c);
+
+#endif // BENCH_HARNESS_H
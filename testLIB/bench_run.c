@@ -0,0 +1,717 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "benchHarness.h"
+#include "vectorOps.h"
+#include "fastMath.h"
+#include "modular.h"
+#include "calculus.h"
+#include "matrice.h"
+
+// --- Inputs ---
+
+static unsigned int rng_state;
+
+static unsigned int rng_next(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static double rng_double(void) {
+    return (double)(rng_next() % 20001) / 1000.0 - 10.0;     // [-10, 10]
+}
+
+typedef struct {
+    size_t n;
+    vector *a;          // 3n vectors: a[i], a[n + i], a[2n + i]
+    line_equation *lines;
+    plain *plains;
+} VectorData;
+
+static void vector_teardown(void *state) {
+    VectorData *d = (VectorData *)state;
+    for (size_t i = 0; d->a && i < 3 * d->n; i++) dcnstVector(d->a[i]);
+    free(d->a);
+    free(d->lines);
+    free(d->plains);
+    free(d);
+}
+
+static void *vector_setup(size_t size, unsigned int seed) {
+    VectorData *d = calloc(1, sizeof(VectorData));
+    if (!d) return NULL;
+    rng_state = seed ? seed : 1;
+    d->n = size;
+    d->a = calloc(3 * size, sizeof(vector));
+    d->lines = calloc(2 * size, sizeof(line_equation));
+    d->plains = calloc(size, sizeof(plain));
+    bool ok = d->a && d->lines && d->plains;
+    for (size_t i = 0; ok && i < 3 * size; i++) {
+        d->a[i] = cnstVector(3);
+        ok = d->a[i] != NULL;
+        for (int k = 0; ok && k < 3; k++) d->a[i]->val[k] = rng_double();
+    }
+    if (!ok) {
+        vector_teardown(d);
+        return NULL;
+    }
+    // Lines and planes share the vectors: their members are never freed separately
+    for (size_t i = 0; i < size; i++) {
+        d->lines[2 * i].point = d->a[i];
+        d->lines[2 * i].direction = d->a[size + i];
+        d->lines[2 * i + 1].point = d->a[2 * size + i];
+        d->lines[2 * i + 1].direction = d->a[i];
+        d->plains[i].normal = d->a[size + i];
+        d->plains[i].point = d->a[2 * size + i];
+    }
+    return d;
+}
+
+typedef struct {
+    size_t n;
+    int *a, *b, *m;     // m[i] is an odd prime-ish modulus > 2
+} IntData;
+
+static void *int_setup(size_t size, unsigned int seed) {
+    IntData *d = calloc(1, sizeof(IntData));
+    if (!d) return NULL;
+    rng_state = seed ? seed : 1;
+    d->n = size;
+    d->a = malloc(sizeof(int) * size);
+    d->b = malloc(sizeof(int) * size);
+    d->m = malloc(sizeof(int) * size);
+    if (!d->a || !d->b || !d->m) {
+        free(d->a); free(d->b); free(d->m); free(d);
+        return NULL;
+    }
+    for (size_t i = 0; i < size; i++) {
+        d->a[i] = (int)(rng_next() % 1000000);
+        d->b[i] = (int)(rng_next() % 1000000) + 1;
+        d->m[i] = (int)(rng_next() % 1000000) | 1;
+        if (d->m[i] < 3) d->m[i] = 1000003;
+    }
+    return d;
+}
+
+static void int_teardown(void *state) {
+    IntData *d = (IntData *)state;
+    free(d->a);
+    free(d->b);
+    free(d->m);
+    free(d);
+}
+
+typedef struct {
+    size_t n;
+} SizeData;
+
+static void *size_setup(size_t size, unsigned int seed) {
+    (void)seed;
+    SizeData *d = malloc(sizeof(SizeData));
+    if (d) d->n = size;
+    return d;
+}
+
+static void size_teardown(void *state) {
+    free(state);
+}
+
+typedef struct {
+    size_t n;
+    double *a, *b;      // n packed xyz points each
+    double *out;
+} BatchData;
+
+static void batch_teardown(void *state) {
+    BatchData *d = (BatchData *)state;
+    free(d->a);
+    free(d->b);
+    free(d->out);
+    free(d);
+}
+
+static void *batch_setup(size_t size, unsigned int seed) {
+    BatchData *d = calloc(1, sizeof(BatchData));
+    if (!d) return NULL;
+    rng_state = seed ? seed : 1;
+    d->n = size;
+    d->a = malloc(sizeof(double) * 3 * size);
+    d->b = malloc(sizeof(double) * 3 * size);
+    d->out = malloc(sizeof(double) * size);
+    if (!d->a || !d->b || !d->out) {
+        batch_teardown(d);
+        return NULL;
+    }
+    for (size_t i = 0; i < 3 * size; i++) {
+        d->a[i] = rng_double();
+        d->b[i] = rng_double();
+    }
+    return d;
+}
+
+typedef struct {
+    size_t n;
+    matrice *m;
+    matrice *sub;       // (n-1) x (n-1) scratch for cofactor
+    matrice *dst;       // n x n transpose destination
+} MatrixData;
+
+static void *matrix_setup(size_t size, unsigned int seed) {
+    if (size < 2 || size > 65535) return NULL;
+    MatrixData *d = calloc(1, sizeof(MatrixData));
+    if (!d) return NULL;
+    d->n = size;
+    d->m = generateMatrice((unsigned short)size, (unsigned int)size, (int)(seed ? seed : 1));
+    d->sub = generateMatrice((unsigned short)(size - 1), (unsigned int)(size - 1), 0);
+    d->dst = matrice_create((unsigned short)size, (unsigned short)size, MATRICE_INTERLEAVED);
+    if (!d->m || !d->sub || !d->dst) {
+        free_matrice(d->m);
+        free_matrice(d->sub);
+        free_matrice(d->dst);
+        free(d);
+        return NULL;
+    }
+    return d;
+}
+
+static void matrix_teardown(void *state) {
+    MatrixData *d = (MatrixData *)state;
+    free_matrice(d->m);
+    free_matrice(d->sub);
+    free_matrice(d->dst);
+    free(d);
+}
+
+// --- vectorOps ---
+
+static size_t run_scalar_product(void *state) {
+    VectorData *d = (VectorData *)state;
+    double s = 0.0;
+    for (size_t i = 0; i < d->n; i++) s += scalaricProduct(d->a[i], d->a[d->n + i]);
+    bench_sink = s;
+    return d->n;
+}
+
+static size_t run_cross_product(void *state) {
+    VectorData *d = (VectorData *)state;
+    double s = 0.0;
+    for (size_t i = 0; i < d->n; i++) {
+        vector c = crossProduct(d->a[i], d->a[d->n + i]);
+        s += c->val[0];
+        dcnstVector(c);
+    }
+    bench_sink = s;
+    return d->n;
+}
+
+static size_t run_addition(void *state) {
+    VectorData *d = (VectorData *)state;
+    double s = 0.0;
+    for (size_t i = 0; i < d->n; i++) {
+        vector c = addition(d->a[i], d->a[d->n + i], (i & 1) != 0);
+        s += c->val[1];
+        dcnstVector(c);
+    }
+    bench_sink = s;
+    return d->n;
+}
+
+static size_t run_get_normal(void *state) {
+    VectorData *d = (VectorData *)state;
+    double s = 0.0;
+    for (size_t i = 0; i < d->n; i++) {
+        vector c = getNormal(d->a[i]);
+        if (c) s += c->val[2];
+        dcnstVector(c);
+    }
+    bench_sink = s;
+    return d->n;
+}
+
+static size_t run_get_dist(void *state) {
+    VectorData *d = (VectorData *)state;
+    double s = 0.0;
+    for (size_t i = 0; i < d->n; i++) s += getDist(d->a[i], d->a[d->n + i]);
+    bench_sink = s;
+    return d->n;
+}
+
+static size_t run_check_parallel(void *state) {
+    VectorData *d = (VectorData *)state;
+    size_t hits = 0;
+    for (size_t i = 0; i < d->n; i++) hits += checkParallel(d->a[i], d->a[d->n + i]);
+    bench_sink = (double)hits;
+    return d->n;
+}
+
+static size_t run_angle(void *state) {
+    VectorData *d = (VectorData *)state;
+    double s = 0.0;
+    for (size_t i = 0; i < d->n; i++) s += getAngleRad(d->a[i], d->a[d->n + i]);
+    bench_sink = s;
+    return d->n;
+}
+
+static size_t run_volume(void *state) {
+    VectorData *d = (VectorData *)state;
+    double s = 0.0;
+    vector triple[3];
+    for (size_t i = 0; i < d->n; i++) {
+        triple[0] = d->a[i];
+        triple[1] = d->a[d->n + i];
+        triple[2] = d->a[2 * d->n + i];
+        s += volumeParallelepiped(triple, 1.0);
+    }
+    bench_sink = s;
+    return d->n;
+}
+
+static size_t run_determinant(void *state) {
+    VectorData *d = (VectorData *)state;
+    double s = 0.0;
+    for (size_t i = 0; i + 3 <= d->n; i += 3) s += determinant(d->a + i, 3);
+    bench_sink = s;
+    return d->n / 3 ? d->n / 3 : 1;
+}
+
+static size_t run_total_volume(void *state) {
+    VectorData *d = (VectorData *)state;
+    bench_sink = totalVolumeParallelepiped(d->a, d->n, 1.0, 0);    // Triples are a[3i..3i+2]
+    return d->n;
+}
+
+static size_t run_total_scalar(void *state) {
+    VectorData *d = (VectorData *)state;
+    bench_sink = totalScalaricProduct(d->a, d->a + d->n, d->n, 0);
+    return d->n;
+}
+
+static size_t run_intersection(void *state) {
+    VectorData *d = (VectorData *)state;
+    double s = 0.0;
+    for (size_t i = 0; i < d->n; i++) {
+        vector p = getIntersection2Lines(&d->lines[2 * i], &d->lines[2 * i + 1]);
+        if (p) s += p->val[0];
+        dcnstVector(p);
+    }
+    bench_sink = s;
+    return d->n;
+}
+
+static size_t run_dist_plain(void *state) {
+    VectorData *d = (VectorData *)state;
+    double s = 0.0;
+    for (size_t i = 0; i < d->n; i++) s += distPointPlain(d->a[i], d->plains[i]);
+    bench_sink = s;
+    return d->n;
+}
+
+// --- fastMath (one thread, so the two angle modes compare kernel against kernel) ---
+
+static const mathContext precise_ctx = {MATH_PRECISE, 1};
+static const mathContext fast_ctx = {MATH_FAST, 1};
+
+// Normalising in place: after the first pass the inputs are unit vectors, same cost
+static size_t batch_normalize(BatchData *d, const mathContext *ctx) {
+    normalizeBatch(d->a, d->n, ctx);
+    bench_sink = d->a[0];
+    return d->n;
+}
+
+static size_t batch_dist(BatchData *d, const mathContext *ctx) {
+    distBatch(d->a, d->b, d->n, d->out, ctx);
+    bench_sink = d->out[d->n - 1];
+    return d->n;
+}
+
+static size_t batch_angle(BatchData *d, const mathContext *ctx) {
+    angleBatch(d->a, d->b, d->n, d->out, ctx);
+    bench_sink = d->out[d->n - 1];
+    return d->n;
+}
+
+static size_t run_normalize(void *state) { return batch_normalize(state, &precise_ctx); }
+static size_t run_dist(void *state) { return batch_dist(state, &precise_ctx); }
+static size_t run_angle_precise(void *state) { return batch_angle(state, &precise_ctx); }
+static size_t run_angle_fast(void *state) { return batch_angle(state, &fast_ctx); }
+
+// --- modular ---
+
+static size_t run_gcd(void *state) {
+    IntData *d = (IntData *)state;
+    long s = 0;
+    for (size_t i = 0; i < d->n; i++) s += GCD(d->a[i], d->b[i]);
+    bench_sink = (double)s;
+    return d->n;
+}
+
+static size_t run_invertible(void *state) {
+    IntData *d = (IntData *)state;
+    long s = 0;
+    for (size_t i = 0; i < d->n; i++) s += invertible(d->a[i], d->m[i]);
+    bench_sink = (double)s;
+    return d->n;
+}
+
+static size_t run_add_mod(void *state) {
+    IntData *d = (IntData *)state;
+    long s = 0;
+    for (size_t i = 0; i < d->n; i++) s += additionMudolar(d->a[i], d->b[i], d->m[i], (i & 1) != 0);
+    bench_sink = (double)s;
+    return d->n;
+}
+
+static size_t run_mul_mod(void *state) {
+    IntData *d = (IntData *)state;
+    long s = 0;
+    for (size_t i = 0; i < d->n; i++) s += multiplicationModular(d->a[i], d->b[i], d->m[i], false);
+    bench_sink = (double)s;
+    return d->n;
+}
+
+static size_t run_div_mod(void *state) {
+    IntData *d = (IntData *)state;
+    long s = 0;
+    for (size_t i = 0; i < d->n; i++) s += multiplicationModular(d->a[i], d->b[i], d->m[i], true);
+    bench_sink = (double)s;
+    return d->n;
+}
+
+static size_t run_exp_mod(void *state) {
+    IntData *d = (IntData *)state;
+    long s = 0;
+    for (size_t i = 0; i < d->n; i++) s += exponantialModular(d->a[i], d->b[i], d->m[i]);
+    bench_sink = (double)s;
+    return d->n;
+}
+
+static size_t run_find_x(void *state) {
+    IntData *d = (IntData *)state;
+    long s = 0;
+    for (size_t i = 0; i < d->n; i++) s += findTheX(d->a[i], d->b[i], d->m[i]);
+    bench_sink = (double)s;
+    return d->n;
+}
+
+// --- calculus ---
+
+static double curve(double x) {
+    return x * x - 3.0 * x + 1.0;
+}
+
+static double surface(double x, double y) {
+    return x * y + y * y - x;
+}
+
+// 'size' grid steps of dx = 0.0001
+static size_t run_integral(void *state) {
+    SizeData *d = (SizeData *)state;
+    bench_sink = intergal(curve, 0.0, (double)d->n * 0.0001);
+    return d->n;
+}
+
+static size_t run_integral_parallel(void *state) {
+    SizeData *d = (SizeData *)state;
+    bench_sink = intergal_parallel(curve, 0.0, (double)d->n * 0.0001, 0);
+    return d->n;
+}
+
+// About 'size' grid points: 100 rows of y
+static size_t run_double_integral_parallel(void *state) {
+    SizeData *d = (SizeData *)state;
+    size_t nx = d->n / 100 ? d->n / 100 : 1;
+    bench_sink = double_integral_parallel(surface, 0.0, (double)nx * 0.0001, 0.0, 0.01, 0);
+    return nx * 100;
+}
+
+static size_t run_derivative(void *state) {
+    SizeData *d = (SizeData *)state;
+    double s = 0.0;
+    for (size_t i = 0; i < d->n; i++) s += derivative((int)(i & 1), surface, (double)i * 1e-3, 1.0);
+    bench_sink = s;
+    return d->n;
+}
+
+static size_t run_gradient(void *state) {
+    SizeData *d = (SizeData *)state;
+    double s = 0.0, dx, dy, dl;
+    for (size_t i = 0; i < d->n; i++) {
+        gradient_L(surface, surface, (double)i * 1e-3, 0.5, 0.25, &dx, &dy, &dl);
+        s += dx + dy + dl;
+    }
+    bench_sink = s;
+    return d->n;
+}
+
+// --- matrice (size = n for an n x n matrix) ---
+
+static size_t run_transpose_in_place(void *state) {
+    MatrixData *d = (MatrixData *)state;
+    transposeMatriceInPlace(d->m);
+    bench_sink = matrice_get(d->m, 0, (unsigned int)(d->n - 1)).R;
+    return d->n * d->n;
+}
+
+static size_t run_transpose(void *state) {
+    MatrixData *d = (MatrixData *)state;
+    matrice *t = transposeMatrice(d->m, d->dst, 0);
+    bench_sink = matrice_get(t, (unsigned int)(d->n - 1), 0).G;
+    return d->n * d->n;
+}
+
+static size_t run_cofactor(void *state) {
+    MatrixData *d = (MatrixData *)state;
+    cofactor(d->m, d->sub, 0, 0, (unsigned int)d->n);
+    bench_sink = matrice_get(d->sub, 0, 0).B;
+    return d->n * d->n;
+}
+
+static size_t run_det(void *state) {
+    MatrixData *d = (MatrixData *)state;
+    pix *p = Det(d->m);
+    bench_sink = p ? p->R : 0;
+    free(p);
+    return 1;
+}
+
+static size_t run_remove_row(void *state) {
+    MatrixData *d = (MatrixData *)state;
+    matrice *r = remove_row(d->m, (unsigned short)(d->n / 2));
+    bench_sink = r->rows;
+    free_matrice(r);
+    return d->n * d->n;
+}
+
+static size_t run_generate(void *state) {
+    MatrixData *d = (MatrixData *)state;
+    matrice *m = generateMatrice((unsigned short)d->n, (unsigned int)d->n, 0);
+    bench_sink = matrice_get(m, 0, 0).R;
+    free_matrice(m);
+    return d->n * d->n;
+}
+
+// --- Registry ---
+
+#define VECTOR_CASE(name, fn) {name, vector_setup, fn, vector_teardown, {1000, 100000, 0}, 0}
+#define BATCH_CASE(name, fn) {name, batch_setup, fn, batch_teardown, {1000, 100000, 0}, 0}
+#define INT_CASE(name, fn) {name, int_setup, fn, int_teardown, {1000, 100000, 0}, 0}
+#define SIZE_CASE(name, fn) {name, size_setup, fn, size_teardown, {10000, 1000000, 0}, 0}
+#define MATRIX_CASE(name, fn) {name, matrix_setup, fn, matrix_teardown, {64, 512, 0}, 4096}
+
+static const BenchCase bench_cases[] = {
+    VECTOR_CASE("vectorOps/scalaricProduct", run_scalar_product),
+    VECTOR_CASE("vectorOps/crossProduct", run_cross_product),
+    VECTOR_CASE("vectorOps/addition", run_addition),
+    VECTOR_CASE("vectorOps/getNormal", run_get_normal),
+    VECTOR_CASE("vectorOps/getDist", run_get_dist),
+    VECTOR_CASE("vectorOps/checkParallel", run_check_parallel),
+    VECTOR_CASE("vectorOps/getAngleRad", run_angle),
+    VECTOR_CASE("vectorOps/volumeParallelepiped", run_volume),
+    VECTOR_CASE("vectorOps/determinant", run_determinant),
+    VECTOR_CASE("vectorOps/totalVolumeParallelepiped", run_total_volume),
+    VECTOR_CASE("vectorOps/totalScalaricProduct", run_total_scalar),
+    VECTOR_CASE("vectorOps/getIntersection2Lines", run_intersection),
+    VECTOR_CASE("vectorOps/distPointPlain", run_dist_plain),
+    BATCH_CASE("fastMath/normalizeBatch", run_normalize),
+    BATCH_CASE("fastMath/distBatch", run_dist),
+    BATCH_CASE("fastMath/angleBatch_precise", run_angle_precise),
+    BATCH_CASE("fastMath/angleBatch_fast", run_angle_fast),
+    INT_CASE("modular/GCD", run_gcd),
+    INT_CASE("modular/invertible", run_invertible),
+    INT_CASE("modular/additionMudolar", run_add_mod),
+    INT_CASE("modular/multiplicationModular", run_mul_mod),
+    INT_CASE("modular/divisionModular", run_div_mod),
+    INT_CASE("modular/exponantialModular", run_exp_mod),
+    INT_CASE("modular/findTheX", run_find_x),
+    SIZE_CASE("calculus/intergal", run_integral),
+    SIZE_CASE("calculus/intergal_parallel", run_integral_parallel),
+    SIZE_CASE("calculus/double_integral_parallel", run_double_integral_parallel),
+    SIZE_CASE("calculus/derivative", run_derivative),
+    SIZE_CASE("calculus/gradient_L", run_gradient),
+    MATRIX_CASE("matrice/generateMatrice", run_generate),
+    MATRIX_CASE("matrice/transposeMatriceInPlace", run_transpose_in_place),
+    MATRIX_CASE("matrice/transposeMatrice", run_transpose),
+    MATRIX_CASE("matrice/cofactor", run_cofactor),
+    MATRIX_CASE("matrice/remove_row", run_remove_row),
+    {"matrice/Det", matrix_setup, run_det, matrix_teardown, {16, 128, 0}, 1024},
+};
+
+#define BENCH_CASE_COUNT (sizeof(bench_cases) / sizeof(bench_cases[0]))
+
+#ifndef BENCH_BUILD_FLAGS
+#define BENCH_BUILD_FLAGS NULL      // Set by the makefile
+#endif
+
+#define EXIT_REGRESSION 2
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --filter TEXT     Only benchmarks whose name contains TEXT\n"
+            "  --sizes N,N,...   Input sizes for every benchmark (default: per benchmark)\n"
+            "  --reps N          Timed samples per benchmark (default 15)\n"
+            "  --warmup N        Untimed calls first (default 3)\n"
+            "  --min-time-us N   Minimum duration of one sample (default 2000)\n"
+            "  --seed N          Input seed\n"
+            "  --counters        Hardware counters (perf_event_open)\n"
+            "  --json FILE       Also write the results as JSON ('-' = stdout)\n"
+            "  --baseline FILE   Compare this run with an earlier --json file\n"
+            "  --compare BASE NEW  Compare two result files without running anything\n"
+            "  --threshold PCT   Slowdown that counts as a regression (default 5)\n"
+            "  --alpha P         Significance level of the U test (default 0.01)\n"
+            "  --list            List the benchmarks and exit\n"
+            "Exit status %d when a regression is found.\n", prog, EXIT_REGRESSION);
+}
+
+static void print_environment(FILE *out, const char *label, const BenchEnvironment *env) {
+    fprintf(out, "%s: %s | %s | %s | simd: %s | %u threads\n", label, env->cpu, env->compiler, env->flags,
+            env->simd, env->threads);
+}
+
+// Prints one line per matched benchmark; returns EXIT_REGRESSION if any regressed
+static int compare_runs(const BenchReport *baseline, const BenchEnvironment *env, const BenchResult results[],
+                        size_t count, double threshold, double alpha) {
+    if (!bench_environment_matches(&baseline->env, env)) {
+        fprintf(stderr, "Warning: the baseline was measured in a different environment\n");
+        print_environment(stderr, "  baseline", &baseline->env);
+        print_environment(stderr, "  current ", env);
+    }
+    BenchComparison *cmp = calloc(count ? count : 1, sizeof(BenchComparison));
+    if (!cmp) return 1;
+    size_t n = bench_compare(baseline, results, count, threshold, alpha, cmp);
+
+    size_t regressions = 0, improvements = 0;
+    printf("\n%-40s %10s %12s %12s %9s\n", "benchmark", "size", "base ns", "new ns", "change");
+    for (size_t i = 0; i < n; i++) {
+        bench_print_comparison(stdout, &cmp[i]);
+        regressions += cmp[i].regression;
+        improvements += cmp[i].improvement;
+    }
+    printf("%zu compared (%zu without a baseline entry): %zu regressions, %zu improvements "
+           "(threshold %.1f%%, alpha %.3g)\n", n, count - n, regressions, improvements, 100.0 * threshold, alpha);
+    free(cmp);
+    return regressions ? EXIT_REGRESSION : 0;
+}
+
+int main(int argc, char *argv[]) {
+    BenchOptions opts = bench_default_options();
+    const char *json_path = NULL;
+    const char *baseline_path = NULL;
+    double threshold = 0.05, alpha = 0.01;
+
+    BenchEnvironment env;
+    bench_environment(&env, BENCH_BUILD_FLAGS);
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        bool takes_value = true;
+        if (strcmp(arg, "--list") == 0) {
+            for (size_t c = 0; c < BENCH_CASE_COUNT; c++) printf("%s\n", bench_cases[c].name);
+            return 0;
+        } else if (strcmp(arg, "--counters") == 0) {
+            opts.counters = true;
+            takes_value = false;
+        } else if (!val) {
+            usage(argv[0]);
+            return 1;
+        } else if (strcmp(arg, "--compare") == 0) {
+            if (i + 2 >= argc) {
+                usage(argv[0]);
+                return 1;
+            }
+            BenchReport *base = bench_load_json(argv[i + 1]);
+            BenchReport *cur = bench_load_json(argv[i + 2]);
+            int status = 1;
+            if (!base || !cur) fprintf(stderr, "Cannot read %s\n", base ? argv[i + 2] : argv[i + 1]);
+            else status = compare_runs(base, &cur->env, cur->results, cur->count, threshold, alpha);
+            bench_report_free(base);
+            bench_report_free(cur);
+            return status;
+        } else if (strcmp(arg, "--filter") == 0) {
+            opts.filter = val;
+        } else if (strcmp(arg, "--sizes") == 0) {
+            if (!bench_parse_sizes(val, opts.sizes)) {
+                fprintf(stderr, "Invalid size list: %s\n", val);
+                return 1;
+            }
+        } else if (strcmp(arg, "--reps") == 0) {
+            opts.repetitions = (unsigned int)strtoul(val, NULL, 10);
+        } else if (strcmp(arg, "--warmup") == 0) {
+            opts.warmup = (unsigned int)strtoul(val, NULL, 10);
+        } else if (strcmp(arg, "--min-time-us") == 0) {
+            opts.min_sample_ns = strtod(val, NULL) * 1000.0;
+        } else if (strcmp(arg, "--seed") == 0) {
+            opts.seed = (unsigned int)strtoul(val, NULL, 10);
+        } else if (strcmp(arg, "--json") == 0) {
+            json_path = val;
+        } else if (strcmp(arg, "--baseline") == 0) {
+            baseline_path = val;
+        } else if (strcmp(arg, "--threshold") == 0) {
+            threshold = strtod(val, NULL) / 100.0;
+        } else if (strcmp(arg, "--alpha") == 0) {
+            alpha = strtod(val, NULL);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+        if (takes_value) i++;
+    }
+    if (opts.repetitions == 0) opts.repetitions = 1;
+
+    // Read first: a bad baseline should fail before minutes of measuring
+    BenchReport *baseline = NULL;
+    if (baseline_path && !(baseline = bench_load_json(baseline_path))) {
+        fprintf(stderr, "Cannot read baseline %s\n", baseline_path);
+        return 1;
+    }
+
+    BenchResult *results = calloc(BENCH_CASE_COUNT * BENCH_MAX_SIZES, sizeof(BenchResult));
+    if (!results) return 1;
+    size_t count = 0;
+
+    // The table goes to stderr when JSON takes stdout
+    FILE *table = (json_path && strcmp(json_path, "-") == 0) ? stderr : stdout;
+    print_environment(table, "environment", &env);
+    bench_print_header(table);
+    for (size_t c = 0; c < BENCH_CASE_COUNT; c++) {
+        const BenchCase *bc = &bench_cases[c];
+        if (!bench_selected(bc, &opts)) continue;
+        const size_t *sizes = opts.sizes[0] ? opts.sizes : bc->sizes;
+        for (size_t s = 0; s < BENCH_MAX_SIZES && sizes[s]; s++) {
+            if (bc->max_size && sizes[s] > bc->max_size) continue;
+            if (!bench_run_case(bc, sizes[s], &opts, &results[count])) {
+                fprintf(stderr, "%s: setup failed for size %zu\n", bc->name, sizes[s]);
+                continue;
+            }
+            bench_print_result(table, &results[count]);
+            fflush(table);
+            count++;
+        }
+    }
+    if (opts.counters && count > 0 && !results[0].has_counters) {
+        fprintf(stderr, "Hardware counters unavailable (perf_event_open failed)\n");
+    }
+
+    int status = 0;
+    if (json_path) {
+        FILE *out = strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+        if (!out || !bench_write_json(out, results, count, &opts, &env)) {
+            fprintf(stderr, "Cannot write %s\n", json_path);
+            status = 1;
+        }
+        if (out && out != stdout && fclose(out) != 0) status = 1;
+    }
+    if (baseline) {
+        int compared = compare_runs(baseline, &env, results, count, threshold, alpha);
+        if (compared) status = compared;
+        bench_report_free(baseline);
+    }
+
+    for (size_t i = 0; i < count; i++) bench_result_free(&results[i]);
+    free(results);
+    return status;
+}
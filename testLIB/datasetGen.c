@@ -0,0 +1,388 @@
+#include "datasetGen.h"
+#include "csvNumber.h"
+#include "parallel.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ROW_MAX_CHARS (16 * CSV_DOUBLE_MAX_CHARS)   // Longest row of any kind
+#define CHUNKS_PER_THREAD 2                         // Chunks formatted per thread before writing
+
+DatasetOptions dataset_default_options(void) {
+    DatasetOptions o;
+    memset(&o, 0, sizeof(o));
+    o.kind = DATASET_TEST;
+    o.distribution = DATASET_INTEGER;
+    o.rows = 10000;
+    o.seed = 1;
+    o.scale = 100.0;
+    o.cols = 1024;
+    o.header = true;
+    return o;
+}
+
+bool dataset_parse_kind(const char *name, DatasetKind *kind) {
+    static const char *const names[] = {"test", "points", "mesh", "matrix"};
+    for (int i = 0; i < 4; i++) {
+        if (strcmp(name, names[i]) == 0) {
+            *kind = (DatasetKind)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool dataset_parse_distribution(const char *name, DatasetDistribution *dist) {
+    static const char *const names[] = {"uniform", "normal", "integer"};
+    for (int i = 0; i < 3; i++) {
+        if (strcmp(name, names[i]) == 0) {
+            *dist = (DatasetDistribution)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *dataset_validate(const DatasetOptions *opts) {
+    if (!(opts->coplanar >= 0.0 && opts->zero >= 0.0 && opts->huge >= 0.0) ||
+        opts->coplanar + opts->zero + opts->huge > 1.0) {
+        return "degenerate fractions must be in [0, 1] and sum to at most 1";
+    }
+    if (!(opts->scale > 0.0) || !isfinite(opts->scale)) return "scale must be positive";
+    if (opts->distribution == DATASET_INTEGER && opts->scale > 1e15) return "integer scale must be at most 1e15";
+    if (opts->kind == DATASET_MATRIX && opts->cols == 0) return "matrix width must be positive";
+    if (opts->precision < 0 || opts->precision > 17) return "precision must be 0..17";
+    return NULL;
+}
+
+// --- Random Streams ---
+
+typedef struct {
+    uint64_t s[4];
+} Rng;
+
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// xoshiro256**
+static uint64_t rng_next(Rng *r) {
+    uint64_t result = rotl(r->s[1] * 5, 7) * 9;
+    uint64_t t = r->s[1] << 17;
+    r->s[2] ^= r->s[0];
+    r->s[3] ^= r->s[1];
+    r->s[1] ^= r->s[2];
+    r->s[0] ^= r->s[3];
+    r->s[2] ^= t;
+    r->s[3] = rotl(r->s[3], 45);
+    return result;
+}
+
+// Stream of one chunk: depends only on (seed, chunk)
+static void rng_seed(Rng *r, uint64_t seed, uint64_t chunk) {
+    uint64_t x = seed ^ splitmix64(&chunk);
+    for (int i = 0; i < 4; i++) r->s[i] = splitmix64(&x);
+}
+
+// [0, 1)
+static double rng_unit(Rng *r) {
+    return (double)(rng_next(r) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double rng_value(Rng *r, const DatasetOptions *o) {
+    switch (o->distribution) {
+        case DATASET_NORMAL: {
+            // Box-Muller; 1 - u keeps the logarithm finite
+            double u = 1.0 - rng_unit(r), v = rng_unit(r);
+            return o->scale * sqrt(-2.0 * log(u)) * cos(6.283185307179586 * v);
+        }
+        case DATASET_INTEGER: {
+            uint64_t span = (uint64_t)floor(o->scale) * 2 + 1;
+            return (double)(rng_next(r) % span) - floor(o->scale);
+        }
+        default:
+            return o->scale * (2.0 * rng_unit(r) - 1.0);
+    }
+}
+
+typedef enum { ROW_NORMAL, ROW_COPLANAR, ROW_ZERO, ROW_HUGE } RowShape;
+
+static RowShape rng_shape(Rng *r, const DatasetOptions *o) {
+    if (o->coplanar + o->zero + o->huge <= 0.0) return ROW_NORMAL;
+    double u = rng_unit(r);
+    if (u < o->zero) return ROW_ZERO;
+    if (u < o->zero + o->coplanar) return ROW_COPLANAR;
+    if (u < o->zero + o->coplanar + o->huge) return ROW_HUGE;
+    return ROW_NORMAL;
+}
+
+static void rng_vector(Rng *r, const DatasetOptions *o, RowShape shape, double v[3]) {
+    for (int k = 0; k < 3; k++) {
+        v[k] = (shape == ROW_HUGE) ? DATASET_HUGE_SCALE * (2.0 * rng_unit(r) - 1.0) : rng_value(r, o);
+    }
+}
+
+// Small whole coefficients keep integer data integral
+static double rng_coefficient(Rng *r, const DatasetOptions *o) {
+    if (o->distribution == DATASET_INTEGER) return (double)(rng_next(r) % 7) - 3.0;
+    return 2.0 * rng_unit(r) - 1.0;
+}
+
+// --- Formatting ---
+
+static char *put_double(char *p, double v, int precision) {
+    return p + csv_format_double(v, precision, p);
+}
+
+static char *put_fields(char *p, const double *v, size_t n, int precision) {
+    for (size_t i = 0; i < n; i++) {
+        if (i) *p++ = ',';
+        p = put_double(p, v[i], precision);
+    }
+    return p;
+}
+
+static char *put_row(char *p, const double *v, size_t n, int precision) {
+    p = put_fields(p, v, n, precision);
+    *p++ = '\n';
+    return p;
+}
+
+// Rows whose last column is derived: inputs at 'precision', the result in full
+static char *put_derived_row(char *p, const double *v, size_t n, int precision) {
+    p = put_fields(p, v, n - 1, precision);
+    *p++ = ',';
+    p = put_double(p, v[n - 1], 0);
+    *p++ = '\n';
+    return p;
+}
+
+// The value a reader parses back from the printed text. Derived columns are
+// computed from these, so a file written at reduced precision agrees with itself.
+static double as_printed(double v, int precision) {
+    if (precision == 0) return v;   // Shortest round-trip: already exact
+    char text[CSV_DOUBLE_MAX_CHARS];
+    int n = csv_format_double(v, precision, text);
+    double back = v;
+    csv_parse_double(text, text + n, &back);
+    return back;
+}
+
+// Scaled so that huge rows (squares past DBL_MAX) still get a finite length
+static double norm3(const double v[3]) {
+    double m = fmax(fabs(v[0]), fmax(fabs(v[1]), fabs(v[2])));
+    if (m < 1e150) return sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    double x = v[0] / m, y = v[1] / m, z = v[2] / m;
+    return m * sqrt(x * x + y * y + z * z);
+}
+
+static void cross3(const double a[3], const double b[3], double out[3]) {
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+// V1..V3 with magnitudes, then the parallelepiped volume |V1 . (V2 x V3)| of the
+// components as printed (in full precision)
+static char *format_test_row(char *p, Rng *r, const DatasetOptions *o, RowShape shape) {
+    double v[3][3];
+    for (int i = 0; i < 3; i++) rng_vector(r, o, shape == ROW_HUGE ? ROW_HUGE : ROW_NORMAL, v[i]);
+
+    double volume;
+    if (shape == ROW_ZERO) {
+        memset(v[rng_next(r) % 3], 0, sizeof(v[0]));    // Which vector is zero is random too
+        volume = 0.0;
+    } else if (shape == ROW_COPLANAR) {
+        double a = rng_coefficient(r, o), b = rng_coefficient(r, o);
+        for (int k = 0; k < 3; k++) v[2][k] = a * v[0][k] + b * v[1][k];
+        volume = 0.0;   // Exactly, whatever rounding the triple product would show
+    }
+    for (int i = 0; i < 3; i++)
+        for (int k = 0; k < 3; k++) v[i][k] = as_printed(v[i][k], o->precision);
+    // Rounded coplanar rows are only nearly coplanar: their volume is computed too
+    if (shape == ROW_NORMAL || shape == ROW_HUGE || (shape == ROW_COPLANAR && o->precision != 0)) {
+        double c[3];
+        cross3(v[1], v[2], c);
+        volume = fabs(v[0][0] * c[0] + v[0][1] * c[1] + v[0][2] * c[2]);
+    }
+
+    double row[13];
+    for (int i = 0; i < 3; i++) {
+        row[4 * i] = v[i][0];
+        row[4 * i + 1] = v[i][1];
+        row[4 * i + 2] = v[i][2];
+        row[4 * i + 3] = norm3(v[i]);
+    }
+    row[12] = volume;
+    return put_derived_row(p, row, 13, o->precision);
+}
+
+static char *format_point_row(char *p, Rng *r, const DatasetOptions *o, RowShape shape) {
+    double v[3] = {0.0, 0.0, 0.0};
+    if (shape != ROW_ZERO) rng_vector(r, o, shape, v);
+    if (shape == ROW_COPLANAR) v[2] = 0.0;
+    return put_row(p, v, 3, o->precision);
+}
+
+static char *format_mesh_row(char *p, Rng *r, const DatasetOptions *o, RowShape shape) {
+    double t[10];
+    memset(t, 0, sizeof(t));
+    if (shape != ROW_ZERO) {
+        rng_vector(r, o, shape, t);
+        rng_vector(r, o, shape, t + 3);
+        rng_vector(r, o, shape, t + 6);
+    }
+    double e1[3], e2[3], n[3];
+    double s = (shape == ROW_COPLANAR) ? rng_coefficient(r, o) : 0.0;
+    for (int k = 0; k < 3; k++) {
+        e1[k] = t[3 + k] - t[k];
+        if (shape == ROW_COPLANAR) t[6 + k] = t[k] + s * e1[k];    // C on the line AB
+    }
+    for (int k = 0; k < 9; k++) t[k] = as_printed(t[k], o->precision);
+    for (int k = 0; k < 3; k++) {
+        e1[k] = t[3 + k] - t[k];
+        e2[k] = t[6 + k] - t[k];
+    }
+    cross3(e1, e2, n);
+    bool area = shape == ROW_NORMAL || shape == ROW_HUGE || (shape == ROW_COPLANAR && o->precision != 0);
+    t[9] = area ? 0.5 * norm3(n) : 0.0;
+    return put_derived_row(p, t, 10, o->precision);
+}
+
+static char *format_matrix_row(char *p, uint64_t index, Rng *r, const DatasetOptions *o, RowShape shape) {
+    double v[5];
+    v[0] = (double)(index / o->cols);
+    v[1] = (double)(index % o->cols);
+    for (int k = 0; k < 3; k++) {
+        switch (shape) {
+            case ROW_ZERO: v[2 + k] = 0.0; break;
+            case ROW_HUGE: v[2 + k] = 65535.0; break;   // Saturated unsigned short
+            default: v[2 + k] = (double)(rng_next(r) % 256); break;
+        }
+    }
+    if (shape == ROW_COPLANAR) v[3] = v[4] = v[2];
+    return put_row(p, v, 5, 0);
+}
+
+size_t dataset_format_chunk(const DatasetOptions *opts, uint64_t chunk, char **buf, size_t *cap,
+                            DatasetStats *stats) {
+    uint64_t first = chunk * DATASET_CHUNK_ROWS;
+    if (first >= opts->rows) return 0;
+    uint64_t rows = opts->rows - first < DATASET_CHUNK_ROWS ? opts->rows - first : DATASET_CHUNK_ROWS;
+
+    Rng r;
+    rng_seed(&r, opts->seed, chunk);
+    size_t len = 0;
+    uint64_t degenerate = 0;
+    for (uint64_t i = 0; i < rows; i++) {
+        if (*cap - len < ROW_MAX_CHARS) {
+            size_t grown = *cap ? *cap * 2 : (size_t)rows * 64 + ROW_MAX_CHARS;
+            char *b = realloc(*buf, grown);
+            if (!b) return 0;
+            *buf = b;
+            *cap = grown;
+        }
+        RowShape shape = rng_shape(&r, opts);
+        degenerate += shape != ROW_NORMAL;
+        char *p = *buf + len;
+        switch (opts->kind) {
+            case DATASET_TEST: p = format_test_row(p, &r, opts, shape); break;
+            case DATASET_POINTS: p = format_point_row(p, &r, opts, shape); break;
+            case DATASET_MESH: p = format_mesh_row(p, &r, opts, shape); break;
+            case DATASET_MATRIX: p = format_matrix_row(p, first + i, &r, opts, shape); break;
+        }
+        len = (size_t)(p - *buf);
+    }
+    if (stats) {
+        stats->rows += rows;
+        stats->bytes += len;
+        stats->degenerate += degenerate;
+    }
+    return len;
+}
+
+// --- Parallel Writer ---
+
+typedef struct {
+    const DatasetOptions *opts;
+    uint64_t first_chunk;
+    char **buf;             // One per slot, reused across batches
+    size_t *cap;
+    size_t *len;
+    DatasetStats *stats;    // One per slot
+    bool *failed;
+} Batch;
+
+static void format_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    Batch *b = (Batch *)ctx;
+    (void)worker;
+    for (size_t s = begin; s < end; s++) {
+        b->len[s] = dataset_format_chunk(b->opts, b->first_chunk + s, &b->buf[s], &b->cap[s], &b->stats[s]);
+        b->failed[s] = b->len[s] == 0;
+    }
+}
+
+static const char *header_line(DatasetKind kind) {
+    switch (kind) {
+        case DATASET_TEST:
+            return "V1_X,V1_Y,V1_Z,V1_MAG,V2_X,V2_Y,V2_Z,V2_MAG,V3_X,V3_Y,V3_Z,V3_MAG,EXPECTED_VOLUME\n";
+        case DATASET_POINTS: return "X,Y,Z\n";
+        case DATASET_MESH: return "A_X,A_Y,A_Z,B_X,B_Y,B_Z,C_X,C_Y,C_Z,AREA\n";
+        default: return "ROW,COL,R,G,B\n";
+    }
+}
+
+bool dataset_write(FILE *out, const DatasetOptions *opts, DatasetStats *stats) {
+    if (!out || !opts || dataset_validate(opts)) return false;
+    DatasetStats total = {0, 0, 0};
+
+    bool ok = true;
+    if (opts->header) {
+        const char *h = header_line(opts->kind);
+        ok = fputs(h, out) >= 0;
+        total.bytes += strlen(h);
+    }
+
+    unsigned int threads = parallel_resolve_threads(opts->threads);
+    size_t slots = (size_t)threads * CHUNKS_PER_THREAD;
+    uint64_t chunks = (opts->rows + DATASET_CHUNK_ROWS - 1) / DATASET_CHUNK_ROWS;
+    Batch b;
+    b.opts = opts;
+    b.buf = calloc(slots, sizeof(char *));
+    b.cap = calloc(slots, sizeof(size_t));
+    b.len = calloc(slots, sizeof(size_t));
+    b.stats = calloc(slots, sizeof(DatasetStats));
+    b.failed = calloc(slots, sizeof(bool));
+    ok = ok && b.buf && b.cap && b.len && b.stats && b.failed;
+
+    for (uint64_t c = 0; ok && c < chunks; c += slots) {
+        size_t n = (chunks - c < slots) ? (size_t)(chunks - c) : slots;
+        b.first_chunk = c;
+        parallel_for(n, threads, format_range, &b);
+        for (size_t s = 0; ok && s < n; s++) {
+            ok = !b.failed[s] && fwrite(b.buf[s], 1, b.len[s], out) == b.len[s];
+        }
+    }
+    if (ok && fflush(out) != 0) ok = false;
+
+    for (size_t s = 0; b.stats && s < slots; s++) {
+        total.rows += b.stats[s].rows;
+        total.bytes += b.stats[s].bytes;
+        total.degenerate += b.stats[s].degenerate;
+    }
+    for (size_t s = 0; b.buf && s < slots; s++) free(b.buf[s]);
+    free(b.buf);
+    free(b.cap);
+    free(b.len);
+    free(b.stats);
+    free(b.failed);
+    if (stats) *stats = total;
+    return ok;
+}
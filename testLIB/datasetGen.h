@@ -0,0 +1,84 @@
+#ifndef DATASET_GEN_H
+#define DATASET_GEN_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// --- Synthetic Dataset Generator ---
+//
+// Rows are produced in fixed chunks of DATASET_CHUNK_ROWS. Chunk k draws from
+// its own random stream, seeded from (seed, k), so every chunk can be built on
+// any thread and the file is byte-identical for any thread count.
+
+#define DATASET_CHUNK_ROWS 65536
+#define DATASET_HUGE_SCALE 1e100    // Magnitude of "huge" rows (volumes stay finite)
+
+typedef enum {
+    DATASET_TEST,       // 13-column test layout: V1..V3 with magnitudes, EXPECTED_VOLUME
+    DATASET_POINTS,     // X,Y,Z
+    DATASET_MESH,       // Triangle soup: A,B,C vertices and AREA
+    DATASET_MATRIX      // ROW,COL,R,G,B pixels of a matrix 'cols' wide
+} DatasetKind;
+
+typedef enum {
+    DATASET_UNIFORM,    // Uniform in [-scale, scale]
+    DATASET_NORMAL,     // Gaussian, standard deviation 'scale'
+    DATASET_INTEGER     // Whole numbers in [-scale, scale]: exact expected values
+} DatasetDistribution;
+
+typedef struct {
+    DatasetKind kind;
+    DatasetDistribution distribution;
+    uint64_t rows;
+    uint64_t seed;
+    double scale;
+    // Fractions of degenerate rows (0..1, summing to at most 1)
+    double coplanar;    // test: V3 in the V1,V2 plane; points: z = 0; mesh: collinear; matrix: gray
+    double zero;        // Zero vector / point / triangle / black pixel
+    double huge;        // Components near DATASET_HUGE_SCALE; matrix: saturated pixel
+    unsigned int cols;  // Matrix width
+    int precision;      // Significant digits of the generated values (0 = shortest round-trip);
+                        // volumes and areas are computed from, and printed exactly for, the rounded values
+    unsigned int threads;   // 0 = default thread count
+    bool header;
+} DatasetOptions;
+
+typedef struct {
+    uint64_t rows;
+    uint64_t bytes;
+    uint64_t degenerate;
+} DatasetStats;
+
+/**
+ * @brief 10 000 rows of the test layout, integer components in [-100, 100], seed 1.
+ */
+DatasetOptions dataset_default_options(void);
+
+bool dataset_parse_kind(const char *name, DatasetKind *kind);
+bool dataset_parse_distribution(const char *name, DatasetDistribution *dist);
+
+/**
+ * @brief Checks the options (fractions, scale, matrix width).
+ * @return NULL if valid, otherwise a message
+ */
+const char *dataset_validate(const DatasetOptions *opts);
+
+/**
+ * @brief Formats chunk 'chunk' (rows chunk*DATASET_CHUNK_ROWS onwards) into *buf,
+ * growing it as needed. Does not include the header.
+ * @return Bytes written, or 0 if out of memory (or the chunk is past the end)
+ */
+size_t dataset_format_chunk(const DatasetOptions *opts, uint64_t chunk, char **buf, size_t *cap,
+                            DatasetStats *stats);
+
+/**
+ * @brief Writes the header (if enabled) and every row to 'out', formatting
+ * chunks on worker threads and writing them in order.
+ * @param stats Optional totals
+ * @return false on an invalid option, allocation or write error
+ */
+bool dataset_write(FILE *out, const DatasetOptions *opts, DatasetStats *stats);
+
+#endif // DATASET_GEN_H
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "datasetGen.h"
+#include "benchHarness.h"
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --kind test|points|mesh|matrix   Layout (default test: 13 columns with expected volume)\n"
+            "  --rows N                         Data rows (default 10000; 1e9 accepted)\n"
+            "  --seed N                         Same seed, same file (default 1)\n"
+            "  --dist uniform|normal|integer    Component distribution (default integer)\n"
+            "  --scale X                        Range / standard deviation (default 100)\n"
+            "  --coplanar P --zero P --huge P   Fractions of degenerate rows\n"
+            "  --cols N                         Matrix width (default 1024)\n"
+            "  --precision N                    Significant digits of the inputs (default 0 = exact;\n"
+            "                                   derived columns are exact for the printed inputs)\n"
+            "  --threads N                      Worker threads (default CALC_THREADS / CPUs)\n"
+            "  --no-header                      Omit the header row\n"
+            "  -o FILE                          Output file (default stdout)\n", prog);
+}
+
+// Whole number, plain or in exponent form (1e9)
+static bool parse_count(const char *text, uint64_t *out) {
+    char *end;
+    double v = strtod(text, &end);
+    if (end == text || *end || !(v >= 0.0) || v > 9e18 || v != floor(v)) return false;
+    *out = (uint64_t)v;
+    return true;
+}
+
+static bool parse_fraction(const char *text, double *out) {
+    char *end;
+    *out = strtod(text, &end);
+    return end != text && !*end;
+}
+
+int main(int argc, char *argv[]) {
+    DatasetOptions opts = dataset_default_options();
+    const char *path = "-";
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--no-header") == 0) {
+            opts.header = false;
+            continue;
+        }
+        const char *val = (i + 1 < argc) ? argv[++i] : NULL;
+        uint64_t n = 0;
+        bool ok = val != NULL;
+        if (!ok) {
+        } else if (strcmp(arg, "--kind") == 0) {
+            ok = dataset_parse_kind(val, &opts.kind);
+        } else if (strcmp(arg, "--dist") == 0) {
+            ok = dataset_parse_distribution(val, &opts.distribution);
+        } else if (strcmp(arg, "--rows") == 0) {
+            ok = parse_count(val, &opts.rows);
+        } else if (strcmp(arg, "--seed") == 0) {
+            ok = parse_count(val, &opts.seed);
+        } else if (strcmp(arg, "--scale") == 0) {
+            ok = parse_fraction(val, &opts.scale);
+        } else if (strcmp(arg, "--coplanar") == 0) {
+            ok = parse_fraction(val, &opts.coplanar);
+        } else if (strcmp(arg, "--zero") == 0) {
+            ok = parse_fraction(val, &opts.zero);
+        } else if (strcmp(arg, "--huge") == 0) {
+            ok = parse_fraction(val, &opts.huge);
+        } else if (strcmp(arg, "--cols") == 0) {
+            ok = parse_count(val, &n) && n > 0 && n <= 65535;
+            opts.cols = (unsigned int)n;
+        } else if (strcmp(arg, "--precision") == 0) {
+            ok = parse_count(val, &n) && n <= 17;
+            opts.precision = (int)n;
+        } else if (strcmp(arg, "--threads") == 0) {
+            ok = parse_count(val, &n) && n <= 1024;
+            opts.threads = (unsigned int)n;
+        } else if (strcmp(arg, "-o") == 0) {
+            path = val;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            if (val) fprintf(stderr, "Invalid value for %s: %s\n", arg, val);
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    const char *problem = dataset_validate(&opts);
+    if (problem) {
+        fprintf(stderr, "Invalid options: %s\n", problem);
+        return 1;
+    }
+
+    FILE *out = strcmp(path, "-") == 0 ? stdout : fopen(path, "wb");
+    if (!out) {
+        perror(path);
+        return 1;
+    }
+
+    DatasetStats stats;
+    uint64_t t0 = bench_now_ns();
+    bool ok = dataset_write(out, &opts, &stats);
+    if (out != stdout && fclose(out) != 0) ok = false;
+    double seconds = (double)(bench_now_ns() - t0) / 1e9;
+    if (!ok) {
+        fprintf(stderr, "Error writing %s\n", path);
+        return 1;
+    }
+    fprintf(stderr, "%llu rows (%llu degenerate), %.1f MB in %.2f s\n",
+            (unsigned long long)stats.rows, (unsigned long long)stats.degenerate,
+            (double)stats.bytes / 1e6, seconds);
+    return 0;
+}
@@ -1,35 +1,79 @@
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "testerFile.h"
 #include "csvHandler.h"
 #include "vectorOps.h"
 
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Usage: %s [path/to/csv_file.csv] [options]\n"
+            "  --summary        Group summaries only\n"
+            "  --failures       Only failed and unparsable cases\n"
+            "  --json FILE      JSON report with per-group timings (- = stdout)\n"
+            "  --junit FILE     JUnit XML report (- = stdout)\n"
+            "  --threads N      Worker threads (default CALC_THREADS / CPUs)\n", prog);
+}
+
 int main(int argc, char *argv[]) {
-    printf("=== SYSTEM INTEGRATION TEST ===\n");
-    
     // Default file if none provided
     const char *test_file = "full_test_suite.csv";
-    
-    // If user provided a file argument, use that instead
-    if (argc > 1) {
-        test_file = argv[1];
+    TestReportOptions report = test_report_default_options();
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        if (strcmp(arg, "--summary") == 0) {
+            report.detail = TEST_REPORT_SUMMARY;
+        } else if (strcmp(arg, "--failures") == 0) {
+            report.detail = TEST_REPORT_FAILURES;
+        } else if ((strcmp(arg, "--json") == 0 || strcmp(arg, "--junit") == 0) && i + 1 < argc) {
+            report.format = strcmp(arg, "--json") == 0 ? TEST_REPORT_JSON : TEST_REPORT_JUNIT;
+            report.path = argv[++i];
+        } else if (strcmp(arg, "--threads") == 0 && i + 1 < argc) {
+            char *end;
+            long n = strtol(argv[++i], &end, 10);
+            if (*end || n < 0 || n > 1024) {
+                usage(argv[0]);
+                return 1;
+            }
+            report.threads = (unsigned int)n;
+        } else if (arg[0] == '-' && arg[1] == '-') {
+            usage(argv[0]);
+            return 1;
+        } else {
+            // If user provided a file argument, use that instead
+            test_file = arg;
+        }
     }
 
-    printf("Loading test file: %s\n", test_file);
+    // Machine-readable reports on stdout get the whole stream
+    bool banner = report.format == TEST_REPORT_TEXT || (report.path && strcmp(report.path, "-") != 0);
+    if (banner) {
+        printf("=== SYSTEM INTEGRATION TEST ===\n");
+        printf("Loading test file: %s\n", test_file);
+    }
 
-    // 1. Open CSV
-    CsvFile *csv = csv_open(test_file);
-    if (!csv) {
+    // 1. Load the suite once
+    TestSuite *suite = test_suite_load(test_file);
+    if (!suite) {
         fprintf(stderr, "FATAL: Could not open '%s'.\n", test_file);
-        fprintf(stderr, "Usage: ./system_test [path/to/csv_file.csv]\n");
+        usage(argv[0]);
         return 1;
     }
 
-    // 2. Run Tests
-    run_volume_tests(csv, volumeParallelepiped, "System Volume Check", 1.0);
-    run_cross_product_tests(csv, crossProduct);
-    run_scalar_product_tests(csv, scalaricProduct);
+    // 2. Run every operation over it and write the report
+    const TestOperation ops[] = {
+        test_volume_operation(volumeParallelepiped, "System Volume Check", 1.0),
+        test_cross_operation(crossProduct),
+        test_scalar_operation(scalaricProduct)
+    };
+    bool ok = run_tests_report(suite, ops, sizeof(ops) / sizeof(ops[0]), &report);
 
-    csv_close(csv);
-    printf("=== SYSTEM TEST COMPLETE ===\n");
+    test_suite_free(suite);
+    if (!ok) {
+        fprintf(stderr, "Error writing the report\n");
+        return 1;
+    }
+    if (banner) printf("=== SYSTEM TEST COMPLETE ===\n");
     return 0;
-}
\ No newline at end of file
+}
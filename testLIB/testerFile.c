@@ -1,24 +1,37 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <math.h> 
+#include <math.h>
+#include <stdarg.h>
+#include <time.h>
 #include "vectorOps.h"
 #include "csvHandler.h"
+#include "csvCache.h"
 #include "testerFile.h"
+#include "parallel.h"
+#include "csvWriter.h"
 
-// --- Define Test Case Struct ---
-typedef struct {
-    vector v1;
-    vector v2;
-    vector v3;
-    double expected_volume;
-} TestCase;
+// --- Test File Schema ---
+// The 10 values a test case needs; the *_MAG columns are never converted
+static const char *const TEST_CASE_COLUMNS[TEST_SUITE_VALUES] = {
+    "V1_X", "V1_Y", "V1_Z", "V2_X", "V2_Y", "V2_Z", "V3_X", "V3_Y", "V3_Z", "EXPECTED_VOLUME"
+};
+// Positions in the 13-column layout, for files whose header uses other names
+#define TEST_CASE_LAYOUT_COLS 13
+static const size_t TEST_CASE_POSITIONS[TEST_SUITE_VALUES] = {0, 1, 2, 4, 5, 6, 8, 9, 10, 12};
+
+#define EXPECTED_COLUMN 9
+
+// Result slots per test case for each kind of operation
+#define VOLUME_SLOTS 2      // volume, 1 if expected ~0 but the vectors are not coplanar
+#define CROSS_SLOTS 5       // x, y, z, result . V1, result . V2
+#define SCALAR_SLOTS 3      // V1.V2, V1.V3, V2.V3
 
 // --- Helper Prototypes ---
-static bool map_4_fields_to_vector(CsvFile *file, vector *v_out);
-static bool read_test_case_row(CsvFile *file, TestCase *test_case);
 static bool vectors_are_coplanar(vector v1, vector v2, vector v3, double tolerance);
-static void free_test_case(TestCase *tc);
+static void run_file_tests(CsvFile *csv, const TestOperation *ops, size_t op_count);
 
 // Helper function to check if three vectors are coplanar
 static bool vectors_are_coplanar(vector v1, vector v2, vector v3, double tolerance) {
@@ -26,244 +39,684 @@ static bool vectors_are_coplanar(vector v1, vector v2, vector v3, double toleran
     if (!cross) return false;
 
     double scalar_triple = scalaricProduct(cross, v3);
-    
+
     // Clean up temporary vector from crossProduct
-    dcnstVector(cross); 
-    
+    dcnstVector(cross);
+
     return fabs(scalar_triple) < tolerance;
 }
 
-// Function to read all 13 fields of a single test case line
-static bool read_test_case_row(CsvFile *file, TestCase *test_case) {
-    char *field_str;
+// --- Loading ---
 
-    // --- Read V1 (4 fields) ---
-    if (!map_4_fields_to_vector(file, &test_case->v1)) return false;
+static TestSuite *suite_alloc(size_t count) {
+    TestSuite *s = calloc(1, sizeof(TestSuite));
+    if (!s) return NULL;
+    s->count = count;
+    s->storage = malloc(sizeof(double) * TEST_SUITE_VALUES * (count ? count : 1));
+    s->valid = calloc(count ? count : 1, sizeof(bool));
+    if (!s->storage || !s->valid) {
+        test_suite_free(s);
+        return NULL;
+    }
+    for (int c = 0; c < TEST_SUITE_VALUES; c++) s->columns[c] = (double *)s->storage + (size_t)c * count;
+    return s;
+}
 
-    // --- Read V2 (4 fields) ---
-    if (!map_4_fields_to_vector(file, &test_case->v2)) {
-        dcnstVector(test_case->v1); // Cleanup partial read
-        return false;
+TestSuite *test_suite_load(const char *filename) {
+    if (!filename) return NULL;
+
+    // By name first, then by position
+    CsvParseOptions opts = csv_default_options();
+    opts.columns = TEST_CASE_COLUMNS;
+    opts.column_count = TEST_SUITE_VALUES;
+    const size_t *source = NULL;
+    CsvTable *t = csv_load_table(filename, &opts);
+    if (!t) {
+        if (csv_detect_file(filename) == CSV_COMP_NONE) {
+            FILE *probe = fopen(filename, "r");
+            if (!probe) return NULL; // Missing: nothing more to try
+            fclose(probe);
+        }
+        opts.columns = NULL;
+        opts.column_count = 0;
+        opts.max_cols = TEST_CASE_LAYOUT_COLS;
+        t = csv_load_table(filename, &opts);
+        if (!t) return NULL;
+        source = TEST_CASE_POSITIONS;
     }
 
-    // --- Read V3 (4 fields) ---
-    if (!map_4_fields_to_vector(file, &test_case->v3)) {
-        dcnstVector(test_case->v1);
-        dcnstVector(test_case->v2);
-        return false;
+    // A positional table too narrow for the layout has no usable rows
+    bool usable = !source || t->cols == TEST_CASE_LAYOUT_COLS;
+    size_t count = usable ? t->rows + t->error_count : t->error_count;
+    TestSuite *s = suite_alloc(count);
+    if (!s) {
+        csv_table_free(t);
+        return NULL;
     }
-    
-    // --- Read Expected Volume (1 field) ---
-    field_str = csv_get_field(file);
-    if (field_str == NULL) {
-        free_test_case(test_case);
-        return false;
+
+    // Interleave the skipped rows (record numbers count the header as 1) with the parsed ones
+    size_t row = 0, err = 0;
+    for (size_t i = 0; i < count; i++) {
+        bool bad = !usable || (err < t->error_count && (size_t)(t->error_lines[err] - 2) == i);
+        if (bad) {
+            if (usable) err++;
+            s->error_count++;
+            for (int c = 0; c < TEST_SUITE_VALUES; c++) s->columns[c][i] = 0.0;
+            continue;
+        }
+        for (int c = 0; c < TEST_SUITE_VALUES; c++) {
+            s->columns[c][i] = t->columns[source ? source[c] : (size_t)c][row];
+        }
+        s->valid[i] = true;
+        row++;
     }
-    test_case->expected_volume = atof(field_str);
 
-    return true;
+    csv_table_free(t);
+    return s;
+}
+
+void test_suite_free(TestSuite *suite) {
+    if (!suite) return;
+    free(suite->storage);
+    free(suite->valid);
+    free(suite);
 }
 
-// Helper to free vectors in a test case
-static void free_test_case(TestCase *tc) {
-    dcnstVector(tc->v1);
-    dcnstVector(tc->v2);
-    dcnstVector(tc->v3);
+// --- Operations ---
+
+TestOperation test_volume_operation(VolumeOperation operation, const char *name, double k) {
+    TestOperation op;
+    memset(&op, 0, sizeof(op));
+    op.kind = TEST_OP_VOLUME;
+    op.name = name;
+    op.k = k;
+    op.volume = operation;
+    return op;
 }
 
-// Helper function to map 4 sequential fields into one vector struct
-// Allocates memory for the vector!
-static bool map_4_fields_to_vector(CsvFile *file, vector *v_out) {
-    char *field_str;
-    if (!file || !v_out) return false;
+TestOperation test_cross_operation(CrossOperation operation) {
+    TestOperation op;
+    memset(&op, 0, sizeof(op));
+    op.kind = TEST_OP_CROSS;
+    op.name = "Cross Product";
+    op.cross = operation;
+    return op;
+}
 
-    // Create a new 3D vector
-    *v_out = cnstVector(3);
-    if (*v_out == NULL) return false;
+TestOperation test_scalar_operation(BinaryVectorOperation operation) {
+    TestOperation op;
+    memset(&op, 0, sizeof(op));
+    op.kind = TEST_OP_SCALAR;
+    op.name = "Scalar Product";
+    op.scalar = operation;
+    return op;
+}
+
+static size_t result_slots(TestOperationKind kind) {
+    return (kind == TEST_OP_VOLUME) ? VOLUME_SLOTS : (kind == TEST_OP_CROSS) ? CROSS_SLOTS : SCALAR_SLOTS;
+}
 
-    // 1. Read X, Y, Z components
-    for (int i = 0; i < 3; i++) {
-        field_str = csv_get_field(file);
-        if (field_str == NULL) {
-            dcnstVector(*v_out); // Cleanup
-            return false;
+// Runs one operation on one test case; 'out' receives its result slots
+static bool compute_case(const TestOperation *op, vector v[3], double expected, double *out) {
+    switch (op->kind) {
+        case TEST_OP_VOLUME:
+            out[0] = op->volume(v, op->k);
+            // Validation: if expected volume is ~0, vectors should be coplanar
+            out[1] = (fabs(expected / op->k) < 0.001 && !vectors_are_coplanar(v[0], v[1], v[2], 0.001)) ? 1.0 : 0.0;
+            return true;
+        case TEST_OP_CROSS: {
+            vector result = op->cross(v[0], v[1]);
+            if (!result) return false;
+            for (int i = 0; i < 3; i++) out[i] = result->val[i];
+            // Verify perpendicularity (dot product should be ~0)
+            out[3] = scalaricProduct(result, v[0]);
+            out[4] = scalaricProduct(result, v[1]);
+            dcnstVector(result);
+            return true;
         }
-        (*v_out)->val[i] = atof(field_str);
-    }
-    
-    // 4. Read Magnitude (Ignored in ADT, but must be consumed from CSV)
-    field_str = csv_get_field(file);
-    if (field_str == NULL) {
-        dcnstVector(*v_out);
-        return false;
+        case TEST_OP_SCALAR:
+            out[0] = op->scalar(v[0], v[1]);
+            out[1] = op->scalar(v[0], v[2]);
+            out[2] = op->scalar(v[1], v[2]);
+            return true;
     }
-    // We do not store magnitude manually in the new ADT
+    return false;
+}
+
+// --- Reports ---
+// Rows are formatted by worker threads into per-worker buffers, block by block,
+// and written in row order: the report is the same for any thread count.
+// Everything goes through one CsvWriter, so output is written in large blocks.
+
+#define REPORT_BLOCK_ROWS 65536     // Rows formatted before their text is written
+
+typedef struct {
+    char *data;
+    size_t len;
+    size_t cap;
+    bool failed;
+} TextBuffer;
+
+typedef struct {
+    int passed;
+    int failed;
+    int errors;
+} TestTally;
+
+typedef enum { CASE_PASS, CASE_FAIL, CASE_ERROR, CASE_DONE } CaseStatus;   // DONE: no expectation to check
+
+typedef struct {
+    const TestSuite *suite;
+    const TestOperation *ops;
+    size_t op_count;
+    const TestReportOptions *opts;
+    const size_t *offset;   // First result slot of each operation
+    double *results;
+    bool *ok;
+    TestTally *totals;      // Per operation
+    double *seconds;        // Compute time per operation
+    CsvWriter *out;
+    TextBuffer line;        // Titles and summaries
+    // Per-operation stage
+    size_t op;
+    size_t block_start;
+    TextBuffer *text;       // One per worker
+    TestTally *tally;       // One per worker
+} TestRun;
 
-    return true;
+static void text_printf(TextBuffer *b, const char *fmt, ...) {
+    if (b->failed) return;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(b->data + b->len, b->cap - b->len, fmt, args);
+        va_end(args);
+        if (n < 0) break;
+        if ((size_t)n < b->cap - b->len) {
+            b->len += (size_t)n;
+            return;
+        }
+        size_t cap = b->cap ? b->cap : 4096;
+        while (cap - b->len <= (size_t)n) cap *= 2;
+        char *grown = realloc(b->data, cap);
+        if (!grown) break;
+        b->data = grown;
+        b->cap = cap;
+    }
+    b->failed = true;
 }
 
-// --- Test Runner Functions ---
+// JSON has no inf/nan
+static void text_number(TextBuffer *b, double v) {
+    if (isfinite(v)) text_printf(b, "%.17g", v);
+    else text_printf(b, "null");
+}
 
-void run_volume_tests(CsvFile *csv, VolumeOperation operation, const char *test_name, double k_value) {
-    TestCase current_test;
-    int test_count = 0;
-    int passed_count = 0;
-    int failed_count = 0;
-    int error_count = 0;
-    
-    printf("\n=== Testing %s (k=%.1f) ===\n", test_name, k_value);
-    if (k_value == 6.0) {
-        printf("Note: CSV contains parallelepiped volumes. Expected = Parallelepiped / 6\n");
-    }
-
-    // Rewind file and skip header
-    rewind(csv->file_ptr);
-    csv->current_line_number = 0;
-    if (!csv_read_line(csv)) {
-        printf("ERROR: Cannot read CSV header\n");
-        return;
+// Escaped for a JSON string or an XML attribute
+static void text_escaped(TextBuffer *b, const char *s, bool xml) {
+    for (; *s; s++) {
+        unsigned char ch = (unsigned char)*s;
+        if (xml && ch == '&') text_printf(b, "&amp;");
+        else if (xml && ch == '<') text_printf(b, "&lt;");
+        else if (xml && ch == '>') text_printf(b, "&gt;");
+        else if (xml && ch == '"') text_printf(b, "&quot;");
+        else if (!xml && (ch == '"' || ch == '\\')) text_printf(b, "\\%c", ch);
+        else if (ch < 0x20) text_printf(b, xml ? "&#%u;" : "\\u%04x", ch);
+        else text_printf(b, "%c", ch);
     }
+}
 
-    while (csv_read_line(csv)) {
-        test_count++;
-        
-        if (read_test_case_row(csv, &current_test)) {
-            vector vectors[3] = {current_test.v1, current_test.v2, current_test.v3};
-            double calculated_volume = operation(vectors, k_value);
-            
-            // Adjust expected volume based on k value
-            double expected_volume = current_test.expected_volume / k_value;
-            
-            // Validation: if expected volume is ~0, vectors should be coplanar
-            if (fabs(expected_volume) < 0.001) {
-                if (!vectors_are_coplanar(current_test.v1, current_test.v2, current_test.v3, 0.001)) {
-                    printf("Test %d: WARNING - Expected volume ~0 but vectors not coplanar\n", test_count);
-                }
-            }
-            
-            // Compare the result (0.1% tolerance)
-            double tolerance = 0.001; 
-            if (fabs(calculated_volume - expected_volume) < tolerance) {
-                printf("Test %d: PASS (Volume: %.3lf)\n", test_count, calculated_volume);
-                passed_count++;
-            } else {
-                printf("Test %d: FAIL! (Calculated: %.3lf, Expected: %.3lf, Diff: %.6lf)\n", 
-                       test_count, calculated_volume, expected_volume, 
-                       fabs(calculated_volume - expected_volume));
-                failed_count++;
-            }
+// Sends the line buffer to the writer
+static void emit_line(TestRun *run) {
+    if (run->line.failed) {
+        static const char oom[] = "ERROR: Out of memory formatting the report\n";
+        csv_writer_text(run->out, oom, sizeof(oom) - 1);
+        run->line.failed = false;
+    } else {
+        csv_writer_text(run->out, run->line.data, run->line.len);
+    }
+    run->line.len = 0;
+}
 
-            // Cleanup memory for this iteration
-            free_test_case(&current_test);
+static CaseStatus case_status(const TestRun *run, const TestOperation *op, size_t i, const double *res, bool ok) {
+    if (!ok) return CASE_ERROR;
+    if (op->kind != TEST_OP_VOLUME) return CASE_DONE;
+    // Adjust expected volume based on k value; 0.1% tolerance
+    double expected_volume = run->suite->columns[EXPECTED_COLUMN][i] / op->k;
+    return fabs(res[0] - expected_volume) < 0.001 ? CASE_PASS : CASE_FAIL;
+}
 
-        } else {
-            printf("Test %d: ERROR - Could not parse all 13 fields from the row.\n", test_count);
-            error_count++;
+static void print_title(TextBuffer *out, const TestOperation *op) {
+    if (op->kind == TEST_OP_VOLUME) {
+        text_printf(out, "\n=== Testing %s (k=%.1f) ===\n", op->name, op->k);
+        if (op->k == 6.0) {
+            text_printf(out, "Note: CSV contains parallelepiped volumes. Expected = Parallelepiped / 6\n");
         }
+    } else {
+        text_printf(out, "\n=== Testing %s ===\n", op->name);
+    }
+}
+
+// --- Text rows ---
+
+static void format_volume(TextBuffer *out, const TestSuite *s, const TestOperation *op, size_t i,
+                          const double *res, CaseStatus status) {
+    int test = (int)i + 1;
+    if (status == CASE_ERROR) {
+        text_printf(out, "Test %d: ERROR - Could not parse all 13 fields from the row.\n", test);
+        return;
     }
-    
-    printf("\n--- %s Summary ---\n", test_name);
-    printf("Total Tests: %d | Passed: %d | Failed: %d | Errors: %d\n", 
-           test_count, passed_count, failed_count, error_count);
-    
-    if (passed_count == test_count && test_count > 0) {
-        printf("✓ All tests passed!\n");
-    } else if (failed_count > 0) {
-        printf("✗ Some tests failed. Review output above.\n");
+    double calculated_volume = res[0];
+    double expected_volume = s->columns[EXPECTED_COLUMN][i] / op->k;
+    if (res[1] != 0.0) {
+        text_printf(out, "Test %d: WARNING - Expected volume ~0 but vectors not coplanar\n", test);
+    }
+    if (status == CASE_PASS) {
+        text_printf(out, "Test %d: PASS (Volume: %.3lf)\n", test, calculated_volume);
+    } else {
+        text_printf(out, "Test %d: FAIL! (Calculated: %.3lf, Expected: %.3lf, Diff: %.6lf)\n",
+                    test, calculated_volume, expected_volume,
+                    fabs(calculated_volume - expected_volume));
     }
-    printf("\n");
 }
 
-void run_scalar_product_tests(CsvFile *csv, BinaryVectorOperation operation) {
-    TestCase current_test;
-    int test_count = 0;
-    int error_count = 0;
-    
-    printf("\n=== Testing Scalar Product ===\n");
-
-    rewind(csv->file_ptr);
-    csv->current_line_number = 0;
-    if (!csv_read_line(csv)) {
-        printf("ERROR: Cannot read CSV header\n");
+static void format_cross(TextBuffer *out, size_t i, const double *r, CaseStatus status) {
+    int test = (int)i + 1;
+    if (status == CASE_ERROR) {
+        text_printf(out, "Test %d: ERROR - Could not parse test case\n", test);
+        return;
+    }
+    // Calculate magnitude locally for display (since it's not stored anymore)
+    double mag = sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+    text_printf(out, "Test %d: V1 x V2 = [%.3lf, %.3lf, %.3lf] (mag: %.3lf)\n", test, r[0], r[1], r[2], mag);
+    if (fabs(r[3]) > 0.001 || fabs(r[4]) > 0.001) {
+        text_printf(out, "        WARNING: Result not perpendicular (V1.result=%.3lf, V2.result=%.3lf)\n", r[3], r[4]);
+    }
+}
+
+static void format_scalar(TextBuffer *out, size_t i, const double *r, CaseStatus status) {
+    int test = (int)i + 1;
+    if (status == CASE_ERROR) {
+        text_printf(out, "Test %d: ERROR - Could not parse test case\n", test);
         return;
     }
+    text_printf(out, "Test %d: V1 . V2 = %.3lf\n", test, r[0]);
+    text_printf(out, "        V1 . V3 = %.3lf\n", r[1]);
+    text_printf(out, "        V2 . V3 = %.3lf\n", r[2]);
+}
+
+// --- JSON and JUnit rows ---
 
-    while (csv_read_line(csv)) {
-        test_count++;
-        
-        if (read_test_case_row(csv, &current_test)) {
-            // Test V1 · V2
-            double result_v1_v2 = operation(current_test.v1, current_test.v2);
-            printf("Test %d: V1 . V2 = %.3lf\n", test_count, result_v1_v2);
-            
-            // Test V1 · V3
-            double result_v1_v3 = operation(current_test.v1, current_test.v3);
-            printf("        V1 . V3 = %.3lf\n", result_v1_v3);
-            
-            // Test V2 · V3
-            double result_v2_v3 = operation(current_test.v2, current_test.v3);
-            printf("        V2 . V3 = %.3lf\n", result_v2_v3);
-
-            free_test_case(&current_test);
+static const char *const STATUS_NAMES[] = {"pass", "fail", "error", "ok"};
 
+// Every case starts with ','; the writer drops the first one of each group
+static void format_json_case(TextBuffer *out, const TestSuite *s, const TestOperation *op, size_t i,
+                             const double *r, CaseStatus status) {
+    text_printf(out, ",\n        {\"test\": %zu, \"status\": \"%s\"", i + 1, STATUS_NAMES[status]);
+    if (status != CASE_ERROR) {
+        switch (op->kind) {
+            case TEST_OP_VOLUME:
+                text_printf(out, ", \"calculated\": ");
+                text_number(out, r[0]);
+                text_printf(out, ", \"expected\": ");
+                text_number(out, s->columns[EXPECTED_COLUMN][i] / op->k);
+                if (r[1] != 0.0) text_printf(out, ", \"warning\": \"vectors not coplanar\"");
+                break;
+            case TEST_OP_CROSS:
+                text_printf(out, ", \"result\": [");
+                for (int k = 0; k < 3; k++) {
+                    if (k) text_printf(out, ", ");
+                    text_number(out, r[k]);
+                }
+                text_printf(out, "]");
+                if (fabs(r[3]) > 0.001 || fabs(r[4]) > 0.001) text_printf(out, ", \"warning\": \"result not perpendicular\"");
+                break;
+            case TEST_OP_SCALAR:
+                text_printf(out, ", \"v1_v2\": ");
+                text_number(out, r[0]);
+                text_printf(out, ", \"v1_v3\": ");
+                text_number(out, r[1]);
+                text_printf(out, ", \"v2_v3\": ");
+                text_number(out, r[2]);
+                break;
+        }
+    }
+    text_printf(out, "}");
+}
+
+static void format_junit_case(TextBuffer *out, const TestSuite *s, const TestOperation *op, size_t i,
+                              const double *r, CaseStatus status) {
+    text_printf(out, "    <testcase classname=\"");
+    text_escaped(out, op->name, true);
+    text_printf(out, "\" name=\"Test %zu\"", i + 1);
+    if (status == CASE_FAIL) {
+        double expected = s->columns[EXPECTED_COLUMN][i] / op->k;
+        text_printf(out, "><failure message=\"Calculated %.6g, expected %.6g\"/></testcase>\n", r[0], expected);
+    } else if (status == CASE_ERROR) {
+        text_printf(out, "><error message=\"Could not parse test case\"/></testcase>\n");
+    } else {
+        text_printf(out, "/>\n");
+    }
+}
+
+static void format_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    TestRun *run = (TestRun *)ctx;
+    const TestSuite *s = run->suite;
+    const TestOperation *op = &run->ops[run->op];
+    const size_t slots = result_slots(op->kind);
+    const double *res = run->results + run->offset[run->op] * s->count;
+    const bool *ok = run->ok + run->op * s->count;
+    const TestReportOptions *o = run->opts;
+    TextBuffer *out = &run->text[worker];
+
+    for (size_t i = run->block_start + begin; i < run->block_start + end; i++) {
+        const double *r = res + i * slots;
+        CaseStatus status = case_status(run, op, i, r, ok[i]);
+        if (o->detail == TEST_REPORT_FAILURES && status != CASE_FAIL && status != CASE_ERROR) continue;
+        if (o->format == TEST_REPORT_JSON) {
+            format_json_case(out, s, op, i, r, status);
+        } else if (o->format == TEST_REPORT_JUNIT) {
+            format_junit_case(out, s, op, i, r, status);
         } else {
-            printf("Test %d: ERROR - Could not parse test case\n", test_count);
-            error_count++;
+            switch (op->kind) {
+                case TEST_OP_VOLUME: format_volume(out, s, op, i, r, status); break;
+                case TEST_OP_CROSS: format_cross(out, i, r, status); break;
+                case TEST_OP_SCALAR: format_scalar(out, i, r, status); break;
+            }
         }
     }
-    
-    printf("\n--- Scalar Product Summary ---\n");
-    printf("Total test cases processed: %d | Errors: %d\n\n", test_count, error_count);
 }
 
-void run_cross_product_tests(CsvFile *csv, CrossOperation operation) {
-    TestCase current_test;
-    int test_count = 0;
-    int error_count = 0;
-    
-    printf("\n=== Testing Cross Product ===\n");
-
-    rewind(csv->file_ptr);
-    csv->current_line_number = 0;
-    if (!csv_read_line(csv)) {
-        printf("ERROR: Cannot read CSV header\n");
+static void print_summary(TextBuffer *out, const TestOperation *op, const TestTally *t, int test_count) {
+    if (op->kind != TEST_OP_VOLUME) {
+        text_printf(out, "\n--- %s Summary ---\n", op->name);
+        text_printf(out, "Total test cases processed: %d | Errors: %d\n\n", test_count, t->errors);
         return;
     }
 
-    while (csv_read_line(csv)) {
-        test_count++;
-        
-        if (read_test_case_row(csv, &current_test)) {
-            // Test V1 × V2
-            vector result = operation(current_test.v1, current_test.v2);
-            
-            // Calculate magnitude locally for display (since it's not stored anymore)
-            double mag = 0;
-            for(int i=0; i<result->dim; i++) mag += result->val[i]*result->val[i];
-            mag = sqrt(mag);
-
-            printf("Test %d: V1 x V2 = [%.3lf, %.3lf, %.3lf] (mag: %.3lf)\n", 
-                   test_count, result->val[0], result->val[1], 
-                   result->val[2], mag);
-            
-            // Verify perpendicularity (dot product should be ~0)
-            double dot_v1 = scalaricProduct(result, current_test.v1);
-            double dot_v2 = scalaricProduct(result, current_test.v2);
-            
-            if (fabs(dot_v1) > 0.001 || fabs(dot_v2) > 0.001) {
-                printf("        WARNING: Result not perpendicular (V1.result=%.3lf, V2.result=%.3lf)\n",
-                       dot_v1, dot_v2);
+    text_printf(out, "\n--- %s Summary ---\n", op->name);
+    text_printf(out, "Total Tests: %d | Passed: %d | Failed: %d | Errors: %d\n",
+                test_count, t->passed, t->failed, t->errors);
+
+    if (t->passed == test_count && test_count > 0) {
+        text_printf(out, "✓ All tests passed!\n");
+    } else if (t->failed > 0) {
+        text_printf(out, "✗ Some tests failed. Review output above.\n");
+    }
+    text_printf(out, "\n");
+}
+
+static const char *const KIND_NAMES[] = {"volume", "cross", "scalar"};
+
+static void print_group_open(TestRun *run, size_t op) {
+    const TestOperation *o = &run->ops[op];
+    const TestTally *t = &run->totals[op];
+    TextBuffer *b = &run->line;
+    switch (run->opts->format) {
+        case TEST_REPORT_JSON:
+            text_printf(b, "%s\n    {\"name\": \"", op ? "," : "");
+            text_escaped(b, o->name, false);
+            text_printf(b, "\", \"kind\": \"%s\", ", KIND_NAMES[o->kind]);
+            if (o->kind == TEST_OP_VOLUME) text_printf(b, "\"k\": %.17g, ", o->k);
+            text_printf(b, "\"tests\": %zu, \"passed\": %d, \"failed\": %d, \"errors\": %d, \"time\": %.6f",
+                        run->suite->count, t->passed, t->failed, t->errors, run->seconds[op]);
+            if (run->opts->detail != TEST_REPORT_SUMMARY) text_printf(b, ",\n     \"cases\": [");
+            break;
+        case TEST_REPORT_JUNIT:
+            text_printf(b, "  <testsuite name=\"");
+            text_escaped(b, o->name, true);
+            text_printf(b, "\" tests=\"%zu\" failures=\"%d\" errors=\"%d\" time=\"%.6f\">\n",
+                        run->suite->count, t->failed, t->errors, run->seconds[op]);
+            break;
+        default:
+            print_title(b, o);
+            break;
+    }
+    emit_line(run);
+}
+
+static void print_group_close(TestRun *run, size_t op, bool any_case) {
+    TextBuffer *b = &run->line;
+    switch (run->opts->format) {
+        case TEST_REPORT_JSON:
+            if (run->opts->detail != TEST_REPORT_SUMMARY) text_printf(b, "%s]", any_case ? "\n     " : "");
+            text_printf(b, "}");
+            break;
+        case TEST_REPORT_JUNIT:
+            text_printf(b, "  </testsuite>\n");
+            break;
+        default:
+            print_summary(b, &run->ops[op], &run->totals[op], (int)run->suite->count);
+            break;
+    }
+    emit_line(run);
+}
+
+static void report_operation(TestRun *run, size_t op, unsigned int threads) {
+    const size_t count = run->suite->count;
+    bool any_case = false;
+    run->op = op;
+    print_group_open(run, op);
+
+    for (size_t start = 0; run->opts->detail != TEST_REPORT_SUMMARY && start < count; start += REPORT_BLOCK_ROWS) {
+        size_t rows = (count - start < REPORT_BLOCK_ROWS) ? count - start : REPORT_BLOCK_ROWS;
+        run->block_start = start;
+        for (unsigned int w = 0; w < threads; w++) run->text[w].len = 0;
+        parallel_for(rows, threads, format_range, run);
+
+        // Range w precedes range w + 1: concatenating keeps row order
+        for (unsigned int w = 0; w < threads; w++) {
+            TextBuffer *t = &run->text[w];
+            if (t->failed) {
+                run->line.failed = true;
+                emit_line(run);
+                t->failed = false;
+            } else if (t->len) {
+                size_t skip = (run->opts->format == TEST_REPORT_JSON && !any_case) ? 1 : 0;
+                csv_writer_text(run->out, t->data + skip, t->len - skip);
+                any_case = true;
             }
+        }
+    }
+    print_group_close(run, op, any_case);
+}
 
-            dcnstVector(result); // Free result vector
-            free_test_case(&current_test); // Free input vectors
+// --- Engine ---
 
-        } else {
-            printf("Test %d: ERROR - Could not parse test case\n", test_count);
-            error_count++;
+// One operation on rows [begin, end); each row's vectors live on the stack
+static void compute_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    TestRun *run = (TestRun *)ctx;
+    const TestSuite *suite = run->suite;
+    const TestOperation *op = &run->ops[run->op];
+    double *results = run->results + run->offset[run->op] * suite->count;
+    bool *ok = run->ok + run->op * suite->count;
+    const size_t slots = result_slots(op->kind);
+    TestTally *tally = &run->tally[worker];
+
+    double a[3], b[3], c[3];
+    struct vector_struct sv[3] = {{3, a, NULL}, {3, b, NULL}, {3, c, NULL}};
+    vector v[3] = {&sv[0], &sv[1], &sv[2]};
+    for (size_t i = begin; i < end; i++) {
+        for (int k = 0; k < 3; k++) {
+            a[k] = suite->columns[k][i];
+            b[k] = suite->columns[3 + k][i];
+            c[k] = suite->columns[6 + k][i];
+        }
+        double *out = results + i * slots;
+        ok[i] = suite->valid[i] && compute_case(op, v, suite->columns[EXPECTED_COLUMN][i], out);
+        switch (case_status(run, op, i, out, ok[i])) {
+            case CASE_PASS: tally->passed++; break;
+            case CASE_FAIL: tally->failed++; break;
+            case CASE_ERROR: tally->errors++; break;
+            case CASE_DONE: break;
+        }
+    }
+}
+
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Computes every operation, timing each and counting its outcomes
+static void compute_operations(TestRun *run, unsigned int threads) {
+    for (size_t o = 0; o < run->op_count; o++) {
+        run->op = o;
+        memset(run->tally, 0, sizeof(TestTally) * threads);
+        double t0 = now_seconds();
+        parallel_for(run->suite->count, threads, compute_range, run);
+        run->seconds[o] = now_seconds() - t0;
+        for (unsigned int w = 0; w < threads; w++) {
+            run->totals[o].passed += run->tally[w].passed;
+            run->totals[o].failed += run->tally[w].failed;
+            run->totals[o].errors += run->tally[w].errors;
         }
     }
-    
-    printf("\n--- Cross Product Summary ---\n");
-    printf("Total test cases processed: %d | Errors: %d\n\n", test_count, error_count);
-}
\ No newline at end of file
+}
+
+static void print_report(TestRun *run, unsigned int threads) {
+    TestTally all = {0, 0, 0};
+    double seconds = 0.0;
+    for (size_t o = 0; o < run->op_count; o++) {
+        all.passed += run->totals[o].passed;
+        all.failed += run->totals[o].failed;
+        all.errors += run->totals[o].errors;
+        seconds += run->seconds[o];
+    }
+    size_t tests = run->suite->count * run->op_count;
+
+    if (run->opts->format == TEST_REPORT_JSON) {
+        text_printf(&run->line, "{\n  \"groups\": [");
+    } else if (run->opts->format == TEST_REPORT_JUNIT) {
+        text_printf(&run->line, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+        text_printf(&run->line, "<testsuites tests=\"%zu\" failures=\"%d\" errors=\"%d\" time=\"%.6f\">\n",
+                    tests, all.failed, all.errors, seconds);
+    }
+    emit_line(run);
+
+    for (size_t o = 0; o < run->op_count; o++) report_operation(run, o, threads);
+
+    if (run->opts->format == TEST_REPORT_JSON) {
+        text_printf(&run->line, "\n  ],\n  \"tests\": %zu, \"passed\": %d, \"failed\": %d, \"errors\": %d, \"time\": %.6f\n}\n",
+                    tests, all.passed, all.failed, all.errors, seconds);
+    } else if (run->opts->format == TEST_REPORT_JUNIT) {
+        text_printf(&run->line, "</testsuites>\n");
+    }
+    emit_line(run);
+}
+
+// Report for a file that could not be read
+static void print_unreadable(TestRun *run) {
+    TextBuffer *b = &run->line;
+    if (run->opts->format == TEST_REPORT_JSON) {
+        text_printf(b, "{\"error\": \"Cannot read CSV header\"}\n");
+    } else if (run->opts->format == TEST_REPORT_JUNIT) {
+        text_printf(b, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites tests=\"0\" failures=\"0\" errors=\"1\">\n");
+        text_printf(b, "  <testsuite name=\"load\" tests=\"1\" failures=\"0\" errors=\"1\">\n");
+        text_printf(b, "    <testcase classname=\"load\" name=\"Read test file\"><error message=\"Cannot read CSV header\"/></testcase>\n");
+        text_printf(b, "  </testsuite>\n</testsuites>\n");
+    } else {
+        for (size_t o = 0; o < run->op_count; o++) {
+            print_title(b, &run->ops[o]);
+            text_printf(b, "ERROR: Cannot read CSV header\n");
+        }
+    }
+    emit_line(run);
+}
+
+TestReportOptions test_report_default_options(void) {
+    TestReportOptions o;
+    memset(&o, 0, sizeof(o));
+    o.detail = TEST_REPORT_ALL;
+    o.format = TEST_REPORT_TEXT;
+    return o;
+}
+
+bool run_tests_report(const TestSuite *suite, const TestOperation ops[], size_t op_count,
+                      const TestReportOptions *opts) {
+    TestReportOptions defaults = test_report_default_options();
+    if (!opts) opts = &defaults;
+    CsvWriter *out = csv_writer_open(opts->path ? opts->path : "-", ',');
+    if (!out) return false;
+
+    TestRun run;
+    memset(&run, 0, sizeof(run));
+    run.suite = suite;
+    run.ops = ops;
+    run.op_count = op_count;
+    run.opts = opts;
+    run.out = out;
+    if (!suite) {
+        print_unreadable(&run);
+        free(run.line.data);
+        csv_writer_close(out);
+        return false;
+    }
+    unsigned int threads = parallel_resolve_threads(opts->threads);
+
+    // One results array and one success flag per test case and operation
+    size_t *offset = malloc(sizeof(size_t) * (op_count ? op_count : 1));
+    size_t slots = 0;
+    for (size_t o = 0; offset && o < op_count; o++) {
+        offset[o] = slots;
+        slots += result_slots(ops[o].kind);
+    }
+    run.offset = offset;
+    run.results = malloc(sizeof(double) * (slots ? slots : 1) * (suite->count ? suite->count : 1));
+    run.ok = malloc(sizeof(bool) * (op_count ? op_count : 1) * (suite->count ? suite->count : 1));
+    run.totals = calloc(op_count ? op_count : 1, sizeof(TestTally));
+    run.seconds = calloc(op_count ? op_count : 1, sizeof(double));
+    run.text = calloc(threads, sizeof(TextBuffer));
+    run.tally = calloc(threads, sizeof(TestTally));
+
+    bool ok = offset && run.results && run.ok && run.totals && run.seconds && run.text && run.tally;
+    if (ok) {
+        compute_operations(&run, threads);
+        print_report(&run, threads);
+    } else {
+        text_printf(&run.line, "ERROR: Out of memory for %zu test cases\n", suite->count);
+        emit_line(&run);
+    }
+
+    for (unsigned int w = 0; run.text && w < threads; w++) free(run.text[w].data);
+    free(run.text);
+    free(run.tally);
+    free(run.totals);
+    free(run.seconds);
+    free(run.line.data);
+    free(offset);
+    free(run.results);
+    free(run.ok);
+    return csv_writer_close(out) && ok;
+}
+
+void run_all_tests(const TestSuite *suite, const TestOperation ops[], size_t op_count, unsigned int threads) {
+    TestReportOptions opts = test_report_default_options();
+    opts.threads = threads;
+    run_tests_report(suite, ops, op_count, &opts);
+}
+
+// --- Test Runner Functions ---
+
+// Loads the file behind 'csv' once and runs 'ops' over it
+static void run_file_tests(CsvFile *csv, const TestOperation *ops, size_t op_count) {
+    TestSuite *suite = (csv && csv->path) ? test_suite_load(csv->path) : NULL;
+    run_all_tests(suite, ops, op_count, 0);
+    test_suite_free(suite);
+}
+
+void run_volume_tests(CsvFile *csv, VolumeOperation operation, const char *test_name, double k_value) {
+    TestOperation op = test_volume_operation(operation, test_name, k_value);
+    run_file_tests(csv, &op, 1);
+}
+
+void run_scalar_product_tests(CsvFile *csv, BinaryVectorOperation operation) {
+    TestOperation op = test_scalar_operation(operation);
+    run_file_tests(csv, &op, 1);
+}
+
+void run_cross_product_tests(CsvFile *csv, CrossOperation operation) {
+    TestOperation op = test_cross_operation(operation);
+    run_file_tests(csv, &op, 1);
+}
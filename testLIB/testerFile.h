@@ -14,7 +14,7 @@ typedef vector (*CrossOperation)(vector v1, vector v2);
 
 /**
  * @brief Runs volume calculation tests on CSV data
- * @param csv Opened CSV file pointer
+ * @param csv Opened CSV file (its path is loaded with test_suite_load)
  * @param operation Function pointer to volume calculation function
  * @param test_name Name of the test for display
  * @param k_value The k constant for volume calculation (1.0 for parallelepiped, 6.0 for pyramid)
@@ -23,16 +23,110 @@ void run_volume_tests(CsvFile *csv, VolumeOperation operation, const char *test_
 
 /**
  * @brief Runs scalar product tests on CSV data
- * @param csv Opened CSV file pointer
+ * @param csv Opened CSV file (its path is loaded with test_suite_load)
  * @param operation Function pointer to scalar product function
  */
 void run_scalar_product_tests(CsvFile *csv, BinaryVectorOperation operation);
 
 /**
  * @brief Runs cross product tests on CSV data
- * @param csv Opened CSV file pointer
+ * @param csv Opened CSV file (its path is loaded with test_suite_load)
  * @param operation Function pointer to cross product function
  */
 void run_cross_product_tests(CsvFile *csv, CrossOperation operation);
 
+// --- Parse-Once Test Engine ---
+
+#define TEST_SUITE_VALUES 10    // V1_X..V3_Z and EXPECTED_VOLUME
+
+typedef enum {
+    TEST_OP_VOLUME = 0,
+    TEST_OP_CROSS,
+    TEST_OP_SCALAR
+} TestOperationKind;
+
+/**
+ * @brief One operation to check against every test case (see the test_*_operation helpers).
+ */
+typedef struct {
+    TestOperationKind kind;
+    const char *name;               // Report title (volume tests)
+    double k;                       // Volume divisor
+    VolumeOperation volume;
+    CrossOperation cross;
+    BinaryVectorOperation scalar;
+} TestOperation;
+
+/**
+ * @brief A test file loaded once: every value in one contiguous block,
+ * column by column, rows in file order (rows that failed to parse included).
+ */
+typedef struct {
+    size_t count;                           // Test cases
+    size_t error_count;                     // Rows that could not be parsed
+    double *columns[TEST_SUITE_VALUES];     // columns[c][row]
+    bool *valid;                            // valid[row]: the row parsed
+    void *storage;
+} TestSuite;
+
+/**
+ * @brief Loads a test file (plain, compressed or via its binary cache) with the
+ * parallel parser. Columns are found by header name, else by position in the
+ * 13-column layout.
+ * @return Suite (free with test_suite_free), or NULL if the file cannot be read
+ */
+TestSuite *test_suite_load(const char *filename);
+
+void test_suite_free(TestSuite *suite);
+
+TestOperation test_volume_operation(VolumeOperation operation, const char *name, double k);
+TestOperation test_cross_operation(CrossOperation operation);
+TestOperation test_scalar_operation(BinaryVectorOperation operation);
+
+// --- Reports ---
+
+typedef enum {
+    TEST_REPORT_ALL = 0,        // Every test case
+    TEST_REPORT_FAILURES,       // Only failed and unparsable cases
+    TEST_REPORT_SUMMARY         // Group summaries only
+} TestReportDetail;
+
+typedef enum {
+    TEST_REPORT_TEXT = 0,       // Human-readable (the run_*_tests format)
+    TEST_REPORT_JSON,           // One document: groups with counts, times and cases
+    TEST_REPORT_JUNIT           // JUnit XML, one <testsuite> per operation
+} TestReportFormat;
+
+typedef struct {
+    TestReportDetail detail;
+    TestReportFormat format;
+    const char *path;           // Output file (NULL or "-" = stdout)
+    unsigned int threads;       // Worker threads (0 = default thread count)
+} TestReportOptions;
+
+/**
+ * @brief Full text report on stdout with the default thread count.
+ */
+TestReportOptions test_report_default_options(void);
+
+/**
+ * @brief Runs every operation over the suite, timing each one, then writes
+ * one report group per operation through a buffered writer.
+ * Rows are split across worker threads for both computing and formatting;
+ * cases are emitted in row order, identical for every thread count. Text
+ * reports carry no timings, so they are reproducible.
+ * @param suite Loaded suite; NULL reports that the file could not be read
+ * @param opts NULL = test_report_default_options()
+ * @return false if the suite is NULL, memory runs out or the output cannot be written
+ */
+bool run_tests_report(const TestSuite *suite, const TestOperation ops[], size_t op_count,
+                      const TestReportOptions *opts);
+
+/**
+ * @brief Full text report on stdout (see run_tests_report), in the same
+ * format as the run_*_tests functions.
+ * @param threads Worker threads (0 = default thread count)
+ */
+void run_all_tests(const TestSuite *suite, const TestOperation ops[], size_t op_count, unsigned int threads);
+
 #endif // TESTER_FILE_H
\ No newline at end of file
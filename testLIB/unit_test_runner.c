@@ -1,8 +1,41 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <assert.h>
 #include <math.h>
 #include "vectorOps.h"
 #include "modular.h"      // Assumed existing
+#include "vectorStats.h"
+#include "fastMath.h"
+#include "spatialOrder.h"
+#include "halfspace.h"
+#include "reduce.h"
+#include "calculus.h"
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <pthread.h>
+#include <time.h>
+#include "csvHandler.h"
+#include "csvMap.h"
+#include "csvParallel.h"
+#include "csvPipeline.h"
+#include "ringQueue.h"
+#include "csvCache.h"
+#include "csvNumber.h"
+#include "csvSchema.h"
+#include "csvWriter.h"
+#include "csvCompress.h"
+#include "csvTail.h"
+#include "csvIngest.h"
+#include "csvResultCache.h"
+#include "testerFile.h"
+#include "benchHarness.h"
+#include "datasetGen.h"
+#include "matrice.h"
+#include "matriceImage.h"
 
 #define EPSILON_TEST 0.001
 
@@ -58,10 +91,1600 @@ void test_vector_module() {
     printf("PASSED\n");
 }
 
+void test_vector_stats_module() {
+    printf("[TEST] Vector Stats Module... ");
+
+    // Points spread along (1,1,0) with a little noise in z
+    vectorSet set = cnstVectorSet();
+    for (int i = 0; i < 100; i++) {
+        vector v = cnstVector(3);
+        v->val[0] = i; v->val[1] = i + 1; v->val[2] = (i % 2) ? 0.1 : -0.1;
+        addToSet(set, v);
+    }
+
+    vecStats one = statsVectorSet(set, 1);
+    vecStats many = statsVectorSet(set, 4);
+    assert(one.count == 100 && many.count == 100);
+    assert(fabs(one.mean[0] - 49.5) < EPSILON_TEST);
+    assert(fabs(one.mean[1] - 50.5) < EPSILON_TEST);
+    assert(fabs(one.min[1] - 1.0) < EPSILON_TEST && fabs(one.max[0] - 99.0) < EPSILON_TEST);
+
+    // Merged per-thread accumulators agree with a single pass
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            assert(fabs(one.m2[i][j] - many.m2[i][j]) < 1e-6 * (1.0 + fabs(one.m2[i][j])));
+
+    // Principal axis is (1,1,0)/sqrt(2)
+    double var[3], axes[3][3];
+    getPrincipalAxes(&one, var, axes);
+    assert(var[0] >= var[1] && var[1] >= var[2]);
+    assert(fabs(fabs(axes[0][0]) - sqrt(0.5)) < EPSILON_TEST);
+    assert(fabs(fabs(axes[0][1]) - sqrt(0.5)) < EPSILON_TEST);
+    assert(fabs(axes[0][2]) < EPSILON_TEST);
+
+    // Eigen solver on a diagonal matrix with a repeated eigenvalue
+    double A[3][3] = {{2, 0, 0}, {0, 5, 0}, {0, 0, 2}};
+    eigenSym3(A, var, axes);
+    assert(fabs(var[0] - 5) < EPSILON_TEST && fabs(var[1] - 2) < EPSILON_TEST && fabs(var[2] - 2) < EPSILON_TEST);
+    assert(fabs(fabs(axes[0][1]) - 1) < EPSILON_TEST);
+
+    // Oriented box: long side ~ 99*sqrt(2)/2, thin side ~ 0.1
+    size_t n;
+    double *xyz = vectorSetToPoints(set, &n);
+    orientedBox box = getOrientedBox(xyz, n, &one, 2);
+    assert(fabs(box.halfExtent[0] - 99.0 * sqrt(2.0) / 2.0) < EPSILON_TEST);
+    assert(fabs(box.center[0] - 49.5) < EPSILON_TEST);
+    free(xyz);
+
+    dcnstrVectorSet(set);
+    printf("PASSED\n");
+}
+
+void test_fast_math_module() {
+    printf("[TEST] Fast Math Module... ");
+
+    // Documented bound: acos absolute error < 3e-8
+    for (double x = -1.0; x <= 1.0; x += 1.0 / 1024) {
+        assert(fabs(fastAcos(x) - acos(x)) < 3e-8);
+    }
+
+    vector v1 = cnstVector(3);
+    v1->val[0] = 3; v1->val[1] = 4; v1->val[2] = 0;
+    vector v2 = cnstVector(3);
+    v2->val[0] = 0; v2->val[1] = 0; v2->val[2] = 2;
+
+    assert(fabs(getAngleRadMode(v1, v2, MATH_FAST) - getAngleRad(v1, v2)) < 1e-6);
+
+    // Batch kernels agree between modes
+    double a[6] = {1, 0, 0, 1, 1, 0}, b[6] = {0, 1, 0, 1, 1, 1};
+    double precise[2], fast[2];
+    mathContext ctx = {MATH_FAST, 2};
+    angleBatch(a, b, 2, precise, NULL);
+    angleBatch(a, b, 2, fast, &ctx);
+    assert(fabs(precise[0] - fast[0]) < 1e-6 && fabs(precise[1] - fast[1]) < 1e-6);
+    normalizeBatch(b, 2, &ctx);
+    assert(fabs(b[3] * b[3] + b[4] * b[4] + b[5] * b[5] - 1.0) < 1e-9);
+
+    dcnstVector(v1);
+    dcnstVector(v2);
+    printf("PASSED\n");
+}
+
+void test_spatial_order_module() {
+    printf("[TEST] Spatial Order Module... ");
+
+    assert(mortonKey3(1, 0, 0) == 4 && mortonKey3(0, 1, 0) == 2 && mortonKey3(0, 0, 1) == 1);
+    assert(mortonKey3(0x1FFFFF, 0x1FFFFF, 0x1FFFFF) == 0x7FFFFFFFFFFFFFFFULL);
+
+    // The first 512 Hilbert indices fill the 8x8x8 corner cube, each step to a face neighbour
+    int cell_of[512][3];
+    for (int x = 0; x < 8; x++)
+        for (int y = 0; y < 8; y++)
+            for (int z = 0; z < 8; z++) {
+                uint64_t h = hilbertKey3(x, y, z);
+                assert(h < 512);
+                cell_of[h][0] = x; cell_of[h][1] = y; cell_of[h][2] = z;
+            }
+    for (int h = 1; h < 512; h++) {
+        int d = abs(cell_of[h][0] - cell_of[h - 1][0]) + abs(cell_of[h][1] - cell_of[h - 1][1]) +
+                abs(cell_of[h][2] - cell_of[h - 1][2]);
+        assert(d == 1);
+    }
+
+    // Large enough batch to exercise the multi-threaded radix sort
+    size_t n = 50000;
+    double *xyz = malloc(sizeof(double) * 3 * n);
+    srand(7);
+    for (size_t i = 0; i < 3 * n; i++) xyz[i] = (double)rand() / RAND_MAX * 100.0 - 50.0;
+
+    uint64_t *keys = malloc(sizeof(uint64_t) * n);
+    assert(computeCurveKeys(xyz, n, CURVE_HILBERT, keys, 4));
+    size_t *perm = spatialOrder(xyz, n, CURVE_HILBERT, 4);
+    char *seen = calloc(n, 1);
+    for (size_t i = 0; i < n; i++) {
+        assert(perm[i] < n && !seen[perm[i]]);
+        seen[perm[i]] = 1;
+        if (i > 0) assert(keys[perm[i - 1]] <= keys[perm[i]]);
+    }
+
+    double first[3] = {xyz[3 * perm[0]], xyz[3 * perm[0] + 1], xyz[3 * perm[0] + 2]};
+    assert(applyPermutation(xyz, n, perm));
+    assert(xyz[0] == first[0] && xyz[1] == first[1] && xyz[2] == first[2]);
+
+    free(xyz); free(keys); free(perm); free(seen);
+
+    // Relinking a set keeps every node
+    vectorSet set = cnstVectorSet();
+    for (int i = 0; i < 20; i++) {
+        vector v = cnstVector(3);
+        v->val[0] = (i * 7) % 20; v->val[1] = i; v->val[2] = 0;
+        addToSet(set, v);
+    }
+    sortVectorSetSpatial(set, CURVE_MORTON, 1);
+    unsigned int count = 0;
+    for (vector v = set->head; v; v = v->next) count++;
+    assert(count == set->count);
+    dcnstrVectorSet(set);
+
+    printf("PASSED\n");
+}
+
+// Builds a plain through (px,py,pz) keeping the side opposite (nx,ny,nz)
+static plain *make_halfspace(double nx, double ny, double nz, double px, double py, double pz) {
+    vector n = cnstVector(3), p = cnstVector(3);
+    n->val[0] = nx; n->val[1] = ny; n->val[2] = nz;
+    p->val[0] = px; p->val[1] = py; p->val[2] = pz;
+    plain *pl = getPlain(n, p);
+    dcnstVector(n);
+    dcnstVector(p);
+    return pl;
+}
+
+static void free_halfspace(plain *pl) {
+    dcnstVector(pl->normal);
+    dcnstVector(pl->point);
+    free(pl);
+}
+
+void test_halfspace_module() {
+    printf("[TEST] Half-space Module... ");
+
+    // Box [0,2]x[0,3]x[0,4] plus a redundant plane and a corner cut x+y+z <= 8
+    plain *planes[8] = {
+        make_halfspace(-1, 0, 0, 0, 0, 0), make_halfspace(1, 0, 0, 2, 0, 0),
+        make_halfspace(0, -1, 0, 0, 0, 0), make_halfspace(0, 1, 0, 0, 3, 0),
+        make_halfspace(0, 0, -1, 0, 0, 0), make_halfspace(0, 0, 1, 0, 0, 4),
+        make_halfspace(1, 0, 0, 5, 0, 0),  make_halfspace(1, 1, 1, 8, 0, 0)
+    };
+
+    polytope box = intersectHalfspaces(planes, 7);
+    assert(box.status == POLY_OK);
+    assert(box.vertexCount == 8);
+    assert(fabs(box.volume - 24.0) < 1e-9);
+
+    // Cutting the (2,3,4) corner with x+y+z <= 8 removes a tetrahedron with legs 1: 24 - 1/6
+    polytope cut = intersectHalfspaces(planes, 8);
+    assert(cut.status == POLY_OK && cut.vertexCount == 10);
+    assert(fabs(cut.volume - (24.0 - 1.0 / 6.0)) < 1e-9);
+
+    // Missing the top plane: unbounded
+    plain *open_box[5] = {planes[0], planes[1], planes[2], planes[3], planes[4]};
+    polytope open = intersectHalfspaces(open_box, 5);
+    assert(open.status == POLY_UNBOUNDED);
+
+    // x >= 0 and x <= -1: empty
+    plain *conflict = make_halfspace(1, 0, 0, -1, 0, 0);
+    plain *empty_set[6] = {planes[2], planes[3], planes[4], planes[5], planes[0], conflict};
+    polytope none = intersectHalfspaces(empty_set, 6);
+    assert(none.status == POLY_EMPTY && none.volume == 0.0);
+
+    // Batch gives the same answers
+    halfspaceProblem batch[3] = {{planes, 7, {0}}, {planes, 8, {0}}, {open_box, 5, {0}}};
+    intersectHalfspacesBatch(batch, 3, 2);
+    assert(fabs(batch[0].result.volume - box.volume) < 1e-12);
+    assert(fabs(batch[1].result.volume - cut.volume) < 1e-12);
+    assert(batch[2].result.status == POLY_UNBOUNDED);
+
+    for (int i = 0; i < 3; i++) freePolytope(&batch[i].result);
+    freePolytope(&box); freePolytope(&cut); freePolytope(&open); freePolytope(&none);
+    for (int i = 0; i < 8; i++) free_halfspace(planes[i]);
+    free_halfspace(conflict);
+    printf("PASSED\n");
+}
+
+static double square(double x) { return x * x; }
+
+void test_reproducible_reduce_module() {
+    printf("[TEST] Reproducible Reduce Module... ");
+
+    // Values with wildly different magnitudes make the sum order-sensitive
+    size_t n = 100003;
+    double *vals = malloc(sizeof(double) * n);
+    srand(11);
+    for (size_t i = 0; i < n; i++) {
+        vals[i] = ((double)rand() / RAND_MAX - 0.5) * pow(10.0, rand() % 12);
+    }
+    double s1 = reproducible_sum(vals, n, 1);
+    double s3 = reproducible_sum(vals, n, 3);
+    double s8 = reproducible_sum(vals, n, 8);
+    assert(memcmp(&s1, &s3, sizeof(double)) == 0 && memcmp(&s1, &s8, sizeof(double)) == 0);
+    free(vals);
+
+    // Batch totals over vector triples
+    size_t triples = 3000;
+    vector *vecs = malloc(sizeof(vector) * 3 * triples);
+    for (size_t i = 0; i < 3 * triples; i++) {
+        vecs[i] = cnstVector(3);
+        for (int k = 0; k < 3; k++) vecs[i]->val[k] = (double)rand() / RAND_MAX * 10.0 - 5.0;
+    }
+    double v1 = totalVolumeParallelepiped(vecs, triples, 1.0, 1);
+    double v8 = totalVolumeParallelepiped(vecs, triples, 1.0, 8);
+    assert(memcmp(&v1, &v8, sizeof(double)) == 0);
+    double p1 = totalScalaricProduct(vecs, vecs + triples, triples, 1);
+    double p8 = totalScalaricProduct(vecs, vecs + triples, triples, 8);
+    assert(memcmp(&p1, &p8, sizeof(double)) == 0);
+    for (size_t i = 0; i < 3 * triples; i++) dcnstVector(vecs[i]);
+    free(vecs);
+
+    // Integral of x^2 over [0, 3] = 9
+    double i1 = intergal_parallel(square, 0.0, 3.0, 1);
+    double i8 = intergal_parallel(square, 0.0, 3.0, 8);
+    assert(memcmp(&i1, &i8, sizeof(double)) == 0);
+    assert(fabs(i1 - 9.0) < 0.001);
+
+    printf("PASSED\n");
+}
+
+static bool field_is(CsvField f, const char *text) {
+    return f.len == strlen(text) && memcmp(f.ptr, text, f.len) == 0;
+}
+
+void test_csv_map_module() {
+    printf("[TEST] CSV Map Module... ");
+
+    const char *path = "unit_test_map.csv";
+    FILE *f = fopen(path, "w");
+    assert(f);
+    fprintf(f, "A,B,C\r\n1,\"x, \"\"y\"\"\nz\",3\n,,\n");
+    for (int i = 0; i < 3000; i++) fprintf(f, "%d,", i); // Longer than MAX_LINE_LENGTH
+    fprintf(f, "end");
+    fclose(f);
+
+    CsvMap *map = csv_map_open(path);
+    assert(map && map->size > 0);
+
+    CsvCursor a, b;
+    CsvField fld;
+    csv_cursor_init(&a, map->data, map->size, ',');
+    csv_cursor_init(&b, map->data, map->size, ',');
+
+    // Two cursors interleaved over the same mapping
+    assert(csv_cursor_next_line(&a) && csv_cursor_next_line(&b));
+    assert(csv_cursor_next_field(&a, &fld) && field_is(fld, "A"));
+    assert(csv_cursor_next_field(&b, &fld) && field_is(fld, "A"));
+    assert(csv_cursor_next_field(&a, &fld) && field_is(fld, "B"));
+    assert(csv_cursor_skip_fields(&a, 5) == 1); // Only C was left, without the \r
+
+    // Quoted field with delimiter, escaped quotes and a newline stays one record
+    assert(csv_cursor_next_line(&a) && a.line_number == 2);
+    assert(csv_cursor_next_field(&a, &fld) && field_is(fld, "1"));
+    assert(csv_cursor_next_field(&a, &fld) && fld.quoted && field_is(fld, "x, \"\"y\"\"\nz"));
+    assert(csv_cursor_next_field(&a, &fld) && field_is(fld, "3"));
+    assert(!csv_cursor_next_field(&a, &fld));
+
+    // Empty fields are reported
+    assert(csv_cursor_next_line(&a));
+    assert(csv_cursor_skip_fields(&a, 10) == 3);
+
+    // No line length limit
+    assert(csv_cursor_next_line(&a));
+    assert(csv_cursor_skip_fields(&a, 3000) == 3000);
+    assert(csv_cursor_next_field(&a, &fld) && field_is(fld, "end"));
+    assert(!csv_cursor_next_line(&a));
+    csv_map_close(map);
+
+    // The stdio reader no longer shares tokeniser state between files
+    CsvFile *c1 = csv_open(path), *c2 = csv_open(path);
+    assert(csv_read_line(c1) && csv_read_line(c2));
+    assert(strcmp(csv_get_field(c1), "A") == 0);
+    assert(strcmp(csv_get_field(c2), "A") == 0);
+    assert(strcmp(csv_get_field(c1), "B") == 0);
+    assert(strcmp(csv_get_field(c2), "B") == 0);
+    csv_close(c1);
+    csv_close(c2);
+
+    remove(path);
+    printf("PASSED\n");
+}
+
+void test_csv_parallel_module() {
+    printf("[TEST] CSV Parallel Module... ");
+
+    // ~2.5 MB so the body is split into several ranges; every 997th row holds
+    // a quoted newline (a record spanning two lines that is not numeric)
+    size_t rows = 100000, cap = rows * 40, len = 0;
+    char *buf = malloc(cap);
+    len += sprintf(buf + len, "X,Y,\"Z\",MAG\n");
+    for (size_t r = 0; r < rows; r++) {
+        if (r % 997 == 5) len += sprintf(buf + len, "\"1\n2\",0,0,0\n");
+        else len += sprintf(buf + len, "%zu,%zu.5,\"-%zu\",1e-3\n", r, r, r);
+    }
+
+    CsvParseOptions opts = csv_default_options();
+    opts.threads = 1;
+    CsvTable *serial = csv_parse_buffer_parallel(buf, len, &opts);
+    opts.threads = 4;
+    CsvTable *parallel = csv_parse_buffer_parallel(buf, len, &opts);
+
+    assert(serial && parallel);
+    assert(serial->cols == 4 && strcmp(serial->names[2], "Z") == 0);
+    assert(serial->rows == parallel->rows && serial->error_count == parallel->error_count);
+    assert(serial->rows + serial->error_count == rows);
+    for (size_t c = 0; c < 4; c++) {
+        assert(memcmp(serial->columns[c], parallel->columns[c], sizeof(double) * serial->rows) == 0);
+    }
+    // Row 5 is record 7 (header is record 1), and it spans two physical lines
+    assert(parallel->error_lines[0] == 7 && parallel->error_lines[1] == 7 + 997);
+    assert(parallel->columns[1][parallel->rows - 1] == (double)(rows - 1) + 0.5);
+    assert(parallel->columns[2][3] == -3.0);
+
+    // Projection of the first columns only
+    opts.max_cols = 2;
+    CsvTable *two = csv_parse_buffer_parallel(buf, len, &opts);
+    assert(two->cols == 2 && two->rows == serial->rows);
+
+    csv_table_free(serial);
+    csv_table_free(parallel);
+    csv_table_free(two);
+    free(buf);
+    printf("PASSED\n");
+}
+
+static void *ring_test_consumer(void *arg) {
+    RingQueue *q = (RingQueue *)arg;
+    size_t expected = 1;
+    for (;;) {
+        size_t v = (size_t)ring_pop(q);
+        if (v == 0) break;
+        if (v != expected++) return NULL;   // Out of order
+    }
+    return q;
+}
+
+static void *ring_test_late_producer(void *arg) {
+    struct timespec pause = {0, 300 * 1000000L};
+    nanosleep(&pause, NULL);
+    ring_push((RingQueue *)arg, (void *)(size_t)42);
+    return NULL;
+}
+
+void test_ring_queue_module() {
+    printf("[TEST] Ring Queue Module... ");
+    RingQueue q;
+    assert(ring_init(&q, 3) && q.mask == 3);
+
+    // A tiny queue forces both sides to block and park
+    pthread_t consumer;
+    assert(pthread_create(&consumer, NULL, ring_test_consumer, &q) == 0);
+    for (size_t i = 1; i <= 200000; i++) ring_push(&q, (void *)i);
+    ring_push(&q, NULL);
+    void *result = NULL;
+    pthread_join(consumer, &result);
+    assert(result == &q);
+
+    // A stalled pop sleeps instead of spinning
+    pthread_t producer;
+    clock_t cpu = clock();
+    assert(pthread_create(&producer, NULL, ring_test_late_producer, &q) == 0);
+    assert((size_t)ring_pop(&q) == 42);
+    pthread_join(producer, NULL);
+    assert((double)(clock() - cpu) / CLOCKS_PER_SEC < 0.1);
+
+    void *item;
+    assert(!ring_try_pop(&q, &item));
+    ring_destroy(&q);
+    printf("PASSED\n");
+}
+
+void test_csv_pipeline_module() {
+    printf("[TEST] CSV Pipeline Module... ");
+
+    // Row r: V1 = (r,0,0), V2 = (0,2,0), V3 = (0,0,3) -> volume 6r; row 7 is malformed
+    FILE *in = tmpfile();
+    FILE *out = tmpfile();
+    assert(in && out);
+    fprintf(in, "X1,Y1,Z1,M1,X2,Y2,Z2,M2,X3,Y3,Z3,M3\n");
+    for (int r = 0; r < 40; r++) {
+        if (r == 7) fprintf(in, "7,0,0,7,oops\n");
+        else fprintf(in, "%d,0,0,%d,0,2,0,2,0,0,3,3\n", r, r);
+    }
+    rewind(in);
+
+    PipelineOptions opts = csv_pipeline_default_options();
+    opts.workers = 3;
+    opts.batch_rows = 4;
+    opts.queue_depth = 1;
+    PipelineStats stats;
+    assert(csv_pipeline_run(in, out, &opts, &stats));
+    assert(stats.rows_in == 40 && stats.rows_out == 39 && stats.rows_bad == 1);
+
+    // Results come back in input order despite round-robin workers
+    char line[128];
+    rewind(out);
+    assert(fgets(line, sizeof(line), out) && strcmp(line, "VOLUME\n") == 0);
+    for (int r = 0; r < 40; r++) {
+        if (r == 7) continue;
+        assert(fgets(line, sizeof(line), out));
+        assert(atof(line) == 6.0 * r);
+    }
+    assert(!fgets(line, sizeof(line), out));
+
+    // Plane distance only needs V1, so the short row 7 is valid here: |x - 1|
+    plain *pl = make_halfspace(1, 0, 0, 1, 0, 0);
+    FILE *dist = tmpfile();
+    rewind(in);
+    opts.op = PIPE_PLANE_DISTANCE;
+    opts.plane = pl;
+    assert(csv_pipeline_run(in, dist, &opts, &stats) && stats.rows_bad == 0);
+    rewind(dist);
+    assert(fgets(line, sizeof(line), dist) && strcmp(line, "DISTANCE\n") == 0);
+    for (int r = 0; r < 40; r++) {
+        assert(fgets(line, sizeof(line), dist) && atof(line) == fabs(r - 1.0));
+    }
+    free_halfspace(pl);
+    fclose(dist);
+
+    fclose(in);
+    fclose(out);
+    printf("PASSED\n");
+}
+
+void test_csv_cache_module() {
+    printf("[TEST] CSV Cache Module... ");
+
+    const char *csv_path = "unit_test_cache.csv";
+    FILE *f = fopen(csv_path, "w");
+    assert(f);
+    fprintf(f, "X,Y,Z,MAG\n");
+    for (int r = 0; r < 500; r++) {
+        if (r == 3) fprintf(f, "bad,row,,\n");
+        else fprintf(f, "%d,%d.25,-%d,0.1\n", r, r, r);
+    }
+    fclose(f);
+
+    CsvParseOptions opts = csv_default_options();
+    char *cache_path = csv_cache_default_path(csv_path);
+    assert(strcmp(cache_path, "unit_test_cache.csv.cache") == 0);
+    remove(cache_path);
+    assert(csv_cache_load_fresh(csv_path, &opts, false) == NULL);
+
+    // Round trip: identical values, names and error lines, columns aligned in the mapping
+    assert(csv_cache_convert(csv_path, NULL, &opts, CSV_COL_F64));
+    CsvTable *parsed = csv_parse_parallel(csv_path, &opts);
+    CsvTable *cached = csv_cache_load_fresh(csv_path, &opts, false);
+    assert(parsed && cached && cached->map);
+    assert(cached->rows == parsed->rows && cached->cols == 4);
+    assert(strcmp(cached->names[1], "Y") == 0);
+    assert(cached->error_count == 1 && cached->error_lines[0] == parsed->error_lines[0]);
+    for (size_t c = 0; c < 4; c++) {
+        assert(((uintptr_t)cached->columns[c] % CSV_CACHE_ALIGN) == 0);
+        assert(memcmp(cached->columns[c], parsed->columns[c], sizeof(double) * parsed->rows) == 0);
+    }
+    csv_table_free(cached);
+
+    // Other options: a projection is not exact here because the full parse skipped a row
+    opts.max_cols = 2;
+    assert(csv_cache_load_fresh(csv_path, &opts, false) == NULL);
+    opts.max_cols = 0;
+
+    // A same-size edit within the same second is stale: the nanoseconds differ
+    struct timespec times[2] = {{1700000000, 100}, {1700000000, 100}};
+    assert(utimensat(AT_FDCWD, csv_path, times, 0) == 0);
+    assert(csv_cache_convert(csv_path, NULL, &opts, CSV_COL_F64));
+    f = fopen(csv_path, "r+");
+    assert(f);
+    fprintf(f, "A");
+    fclose(f);
+    times[0].tv_nsec = times[1].tv_nsec = 200;
+    assert(utimensat(AT_FDCWD, csv_path, times, 0) == 0);
+    assert(csv_cache_load_fresh(csv_path, &opts, false) == NULL);
+
+    // f32 columns are widened on load (row 3 was skipped), but only served when asked for
+    assert(csv_cache_convert(csv_path, NULL, &opts, CSV_COL_F32));
+    assert(csv_cache_load_fresh(csv_path, &opts, false) == NULL);
+    cached = csv_cache_load_fresh(csv_path, &opts, true);
+    assert(cached && cached->columns[1][10] == 11.25);
+    csv_table_free(cached);
+
+    // The checksum catches a flipped byte
+    cached = csv_cache_load(cache_path, true);
+    assert(cached);
+    csv_table_free(cached);
+
+    f = fopen(cache_path, "r+b");
+    fseek(f, -1, SEEK_END);
+    fputc(0x7F, f);
+    fclose(f);
+    assert(csv_cache_load(cache_path, true) == NULL);
+
+    csv_table_free(parsed);
+    remove(cache_path);
+    remove(csv_path);
+    free(cache_path);
+    printf("PASSED\n");
+}
+
+void test_csv_schema_module() {
+    printf("[TEST] CSV Schema Module... ");
+
+    // Fast parser agrees with strtod bit for bit, on and off the fast path
+    const char *nums[] = {"0.1", "-2.5e-3", "123456789.123456789", "1e22", "12e30", "4.9e-324",
+                          "1.7976931348623157e308", "0.30000000000000004", "+7", ".5", "-0"};
+    for (size_t i = 0; i < sizeof(nums) / sizeof(nums[0]); i++) {
+        double fast, ref = strtod(nums[i], NULL);
+        const char *end = nums[i] + strlen(nums[i]);
+        assert(csv_parse_double(nums[i], end, &fast) == end);
+        assert(memcmp(&fast, &ref, sizeof(double)) == 0);
+    }
+    double d;
+    assert(csv_parse_double("abc", "abc" + 3, &d) == NULL);
+    const char *partial = "3.5e+";
+    assert(csv_parse_double(partial, partial + 5, &d) == partial + 3 && d == 3.5); // Dangling exponent
+
+    // Columns found by name (any order, any case); unused fields are not converted
+    const char *header = "id, Z ,junk,x,Y";
+    const char *const names[] = {"X", "Y", "Z"};
+    CsvProjection proj;
+    assert(csv_projection_from_header(&proj, header, strlen(header), ',', names, 3));
+    assert(proj.last == 4 && proj.source[0] == 3 && proj.source[2] == 1);
+
+    double xyz[3];
+    const char *row = "row7,3.5,not a number,1,-2";
+    assert(csv_projection_read_record(&proj, row, strlen(row), xyz));
+    assert(xyz[0] == 1.0 && xyz[1] == -2.0 && xyz[2] == 3.5);
+    assert(!csv_projection_read_record(&proj, "row8,3.5,,1", 11, xyz)); // Y missing
+    csv_projection_free(&proj);
+
+    const char *const missing[] = {"X", "W"};
+    assert(!csv_projection_from_header(&proj, header, strlen(header), ',', missing, 2));
+
+    // Parallel parser with a named projection
+    const char *data = "id,Z,junk,X,Y\na,3,?,1,2\nb,6,?,4,5\n";
+    CsvParseOptions opts = csv_default_options();
+    opts.columns = names;
+    opts.column_count = 3;
+    CsvTable *t = csv_parse_buffer_parallel(data, strlen(data), &opts);
+    assert(t && t->cols == 3 && t->rows == 2 && t->error_count == 0);
+    assert(strcmp(t->names[0], "X") == 0 && t->columns[0][1] == 4.0 && t->columns[2][0] == 3.0);
+    csv_table_free(t);
+    opts.columns = missing;
+    opts.column_count = 2;
+    assert(csv_parse_buffer_parallel(data, strlen(data), &opts) == NULL);
+
+    printf("PASSED\n");
+}
+
+void test_csv_writer_module() {
+    printf("[TEST] CSV Writer Module... ");
+
+    // Shortest round-trip digits, %g layout
+    char buf[CSV_DOUBLE_MAX_CHARS];
+    struct { double v; int prec; const char *text; } cases[] = {
+        {0.1, 0, "0.1"}, {1.0 / 3.0, 0, "0.3333333333333333"}, {1e22, 0, "1e+22"},
+        {123456.0, 0, "123456"}, {1e-5, 0, "1e-05"}, {-0.0, 0, "-0"},
+        {5e-324, 0, "5e-324"}, {1.7976931348623157e308, 0, "1.7976931348623157e+308"},
+        {0.1 + 0.2, 0, "0.30000000000000004"}, {2.0 / 3.0, 3, "0.667"},
+        {99.96, 3, "100"}, {2.5, 1, "2"}, {1234567.0, 3, "1.23e+06"}, {0.5, 6, "0.5"}
+    };
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        int n = csv_format_double(cases[i].v, cases[i].prec, buf);
+        assert(n == (int)strlen(buf) && strcmp(buf, cases[i].text) == 0);
+    }
+
+    // Random doubles parse back bit for bit
+    unsigned long long state = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 20000; i++) {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        double v, back;
+        memcpy(&v, &state, sizeof(v));
+        if (isnan(v) || isinf(v)) continue;
+        int n = csv_format_double(v, 0, buf);
+        assert(csv_parse_double(buf, buf + n, &back) == buf + n && back == v);
+    }
+
+    // Rows, quoting, column batches
+    FILE *f = tmpfile();
+    CsvWriter *w = csv_writer_from_file(f, ',');
+    const char *const names[] = {"A", "B,C", "say \"hi\""};
+    csv_writer_header(w, names, 3);
+    const double row[] = {1.5, -2.0, 1e100};
+    csv_writer_row(w, row, 3);
+    const double c0[] = {1, 2}, c1[] = {0.25, 0.5};
+    const double *const cols[] = {c0, c1};
+    csv_writer_columns(w, cols, 2, 2);
+    csv_writer_long(w, -42);
+    csv_writer_end_row(w);
+    assert(csv_writer_close(w));
+
+    char text[256];
+    rewind(f);
+    size_t len = fread(text, 1, sizeof(text) - 1, f);
+    text[len] = '\0';
+    assert(strcmp(text, "A,\"B,C\",\"say \"\"hi\"\"\"\n1.5,-2,1e+100\n1,0.25\n2,0.5\n-42\n") == 0);
+    fclose(f);
+
+    printf("PASSED\n");
+}
+
+// Reads the whole stream and checks it is 'expect'
+static void check_stream(const char *path, CsvCompression kind, const char *expect) {
+    assert(csv_detect_file(path) == kind);
+    CsvStream *s = csv_stream_open(path);
+    assert(s && csv_stream_kind(s) == kind);
+    static char text[1 << 16];
+    size_t len = fread(text, 1, sizeof(text), csv_stream_file(s));
+    assert(len == strlen(expect) && memcmp(text, expect, len) == 0);
+    assert(csv_stream_close(s));
+}
+
+void test_csv_compress_module() {
+    printf("[TEST] CSV Compress Module... ");
+
+    const unsigned char gz[] = {0x1F, 0x8B, 0x08}, zst[] = {0x28, 0xB5, 0x2F, 0xFD}, txt[] = "X,Y";
+    assert(csv_detect_compression(gz, 3) == CSV_COMP_GZIP);
+    assert(csv_detect_compression(zst, 4) == CSV_COMP_ZSTD);
+    assert(csv_detect_compression(txt, 3) == CSV_COMP_NONE);
+    assert(csv_detect_compression(gz, 1) == CSV_COMP_NONE);
+
+    const char *csv_path = "unit_test_compress.csv";
+    static char expect[1 << 16];
+    size_t len = 0;
+    len += (size_t)sprintf(expect + len, "X,Y,Z\n");
+    for (int r = 0; r < 1000; r++) len += (size_t)sprintf(expect + len, "%d,%d.5,-%d\n", r, r, r);
+    FILE *f = fopen(csv_path, "w");
+    assert(f && fwrite(expect, 1, len, f) == len);
+    fclose(f);
+    check_stream(csv_path, CSV_COMP_NONE, expect);
+
+    CsvParseOptions opts = csv_default_options();
+    CsvTable *plain = csv_parse_parallel(csv_path, &opts);
+    assert(plain && plain->rows == 1000);
+
+    // Every format gives the same lines, rewinds and parses to the same table
+    struct { const char *cmd, *path; CsvCompression kind; } formats[] = {
+        {"gzip -c unit_test_compress.csv > unit_test_compress.csv.gz", "unit_test_compress.csv.gz", CSV_COMP_GZIP},
+        {"zstd -qc unit_test_compress.csv > unit_test_compress.csv.zst", "unit_test_compress.csv.zst", CSV_COMP_ZSTD}
+    };
+    for (size_t i = 0; i < sizeof(formats) / sizeof(formats[0]); i++) {
+        if (system(formats[i].cmd) != 0) { // Tool not installed
+            remove(formats[i].path);
+            continue;
+        }
+        check_stream(formats[i].path, formats[i].kind, expect);
+
+        CsvFile *csv = csv_open(formats[i].path);
+        assert(csv);
+        assert(csv_read_line(csv) && strcmp(csv->line_buffer, "X,Y,Z") == 0);
+        assert(csv_read_line(csv) && strcmp(csv->line_buffer, "0,0.5,-0") == 0);
+        assert(csv_rewind(csv) && csv->current_line_number == 0);
+        assert(csv_read_line(csv) && strcmp(csv->line_buffer, "X,Y,Z") == 0);
+        csv_close(csv); // Closing mid-stream is not an error
+
+        CsvTable *t = csv_parse_parallel(formats[i].path, &opts);
+        assert(t && t->rows == plain->rows && t->cols == plain->cols);
+        for (size_t c = 0; c < t->cols; c++) {
+            assert(memcmp(t->columns[c], plain->columns[c], sizeof(double) * t->rows) == 0);
+        }
+        csv_table_free(t);
+
+        // The vector reader parses the inflated buffer and agrees with the plain file
+        vectorSet packed = csv_read_vector_set(formats[i].path), flat = csv_read_vector_set(csv_path);
+        assert(packed && flat && packed->count == 1000 && packed->count == flat->count);
+        for (vector a = packed->head, b = flat->head; a && b; a = a->next, b = b->next) {
+            assert(memcmp(a->val, b->val, sizeof(double) * 3) == 0);
+        }
+        dcnstrVectorSet(packed);
+        dcnstrVectorSet(flat);
+
+        // A truncated file is reported on close
+        static char raw[1 << 16];
+        f = fopen(formats[i].path, "rb");
+        size_t size = f ? fread(raw, 1, sizeof(raw), f) : 0;
+        assert(f && size > 16);
+        fclose(f);
+        const char *cut_path = "unit_test_compress.cut";
+        f = fopen(cut_path, "wb");
+        assert(f && fwrite(raw, 1, size / 2, f) == size / 2);
+        fclose(f);
+        CsvStream *s = csv_stream_open(cut_path);
+        assert(s);
+        while (fread(raw, 1, sizeof(raw), csv_stream_file(s)) > 0) {}
+        assert(!csv_stream_close(s));
+        remove(cut_path);
+        remove(formats[i].path);
+    }
+
+    csv_table_free(plain);
+    remove(csv_path);
+    printf("PASSED\n");
+}
+
+// Collects the rows a tail delivers
+typedef struct { char text[1024]; size_t len; size_t rows; long first_line; } TailSeen;
+
+static bool collect_tail_rows(const char *rows, size_t len, size_t count, long first_line, void *ctx) {
+    TailSeen *seen = (TailSeen *)ctx;
+    if (seen->rows == 0) seen->first_line = first_line;
+    assert(seen->len + len < sizeof(seen->text));
+    memcpy(seen->text + seen->len, rows, len);
+    seen->len += len;
+    seen->text[seen->len] = '\0';
+    seen->rows += count;
+    return true;
+}
+
+static void append_text(const char *path, const char *mode, const char *text) {
+    FILE *f = fopen(path, mode);
+    assert(f && fputs(text, f) != EOF);
+    fclose(f);
+}
+
+void test_csv_tail_module() {
+    printf("[TEST] CSV Tail Module... ");
+
+    const char *csv_path = "unit_test_tail.csv";
+    char *state_path = csv_tail_default_state_path(csv_path);
+    assert(strcmp(state_path, "unit_test_tail.csv.tail") == 0);
+    remove(csv_path);
+    remove(state_path);
+
+    // Nothing there yet; then a partial last line is held back
+    CsvTail *t = csv_tail_open(csv_path, state_path, true);
+    TailSeen seen = {{0}, 0, 0, 0};
+    assert(t && csv_tail_poll(t, collect_tail_rows, &seen) == 0);
+    append_text(csv_path, "w", "X,Y,Z\n1,1,1\n2,2,2\n3,3");
+    assert(csv_tail_poll(t, collect_tail_rows, &seen) == 2);
+    assert(seen.first_line == 2 && strcmp(seen.text, "1,1,1\n2,2,2\n") == 0);
+    assert(strcmp(t->header, "X,Y,Z") == 0);
+
+    // The writer finishes the line: only the new rows arrive, woken by the change
+    csv_tail_wait(t, 0);
+    append_text(csv_path, "a", ",3\n4,4,4\n");
+    assert(csv_tail_wait(t, 1000));
+    seen.len = seen.rows = 0;
+    assert(csv_tail_poll(t, collect_tail_rows, &seen) == 2);
+    assert(seen.first_line == 4 && strcmp(seen.text, "3,3,3\n4,4,4\n") == 0);
+    csv_tail_close(t);
+
+    // A restart resumes from the saved offset
+    t = csv_tail_open(csv_path, state_path, true);
+    seen.len = seen.rows = 0;
+    assert(t && csv_tail_poll(t, collect_tail_rows, &seen) == 0);
+    append_text(csv_path, "a", "5,5,5\n");
+    assert(csv_tail_poll(t, collect_tail_rows, &seen) == 1);
+    assert(seen.first_line == 6 && strcmp(seen.text, "5,5,5\n") == 0 && strcmp(t->header, "X,Y,Z") == 0);
+
+    // Truncated: read again from the start
+    append_text(csv_path, "w", "X,Y,Z\n9,9,9\n");
+    seen.len = seen.rows = 0;
+    assert(csv_tail_poll(t, collect_tail_rows, &seen) == 1);
+    assert(seen.first_line == 2 && strcmp(seen.text, "9,9,9\n") == 0);
+    csv_tail_close(t);
+
+    // Pipeline: results are appended, the result header comes once
+    append_text(csv_path, "w", "X1,Y1,Z1,M1,X2,Y2,Z2,M2,X3,Y3,Z3,M3\n1,0,0,1,0,2,0,2,0,0,3,3\n");
+    remove(state_path);
+    t = csv_tail_open(csv_path, state_path, true);
+    FILE *out = tmpfile();
+    PipelineStats stats = {0, 0, 0, 0};
+    assert(t && out && csv_tail_pipeline(t, out, NULL, &stats) == 1);
+    append_text(csv_path, "a", "2,0,0,2,0,2,0,2,0,0,3,3\nbad\n");
+    assert(csv_tail_pipeline(t, out, NULL, &stats) == 2);
+    assert(csv_tail_pipeline(t, out, NULL, &stats) == 0);
+    assert(stats.rows_in == 3 && stats.rows_out == 2 && stats.rows_bad == 1);
+
+    char text[64];
+    rewind(out);
+    size_t len = fread(text, 1, sizeof(text) - 1, out);
+    text[len] = '\0';
+    assert(strcmp(text, "VOLUME\n6\n12\n") == 0);
+    fclose(out);
+    csv_tail_close(t);
+
+    remove(csv_path);
+    remove(state_path);
+    free(state_path);
+    printf("PASSED\n");
+}
+
+void test_csv_ingest_module() {
+    printf("[TEST] CSV Ingest Module... ");
+
+    // Three files of different sizes (one larger than a read request), plus a missing one
+    const char *paths[] = {"b.unit_ingest", "a.unit_ingest", "missing.unit_ingest", "c.unit_ingest"};
+    const size_t rows[] = {10, 70000, 0, 3};
+    for (size_t i = 0; i < 4; i++) {
+        if (i == 2) continue;
+        FILE *f = fopen(paths[i], "w");
+        assert(f);
+        fprintf(f, "A,B\n");
+        for (size_t r = 0; r < rows[i]; r++) fprintf(f, "%zu,%zu.5\n", r, i);
+        if (i == 3) fprintf(f, "x,oops\n");
+        fclose(f);
+    }
+
+    for (int mode = 0; mode < 2; mode++) {
+        CsvIngestOptions opts = csv_ingest_default_options();
+        opts.use_io_uring = (mode == 0);
+        opts.threads = 2;
+        opts.queue_depth = 2;
+        opts.memory_limit = 1; // One file at a time: reading waits for the parsers
+
+        CsvIngestResult *r = csv_ingest_files(paths, 4, &opts);
+        assert(r && r->count == 4 && r->failed == 1);
+        assert(r->files[2].table == NULL && r->files[2].error == ENOENT);
+        for (size_t i = 0; i < 4; i++) {
+            if (i == 2) continue;
+            const CsvTable *t = r->files[i].table;
+            assert(strcmp(r->files[i].path, paths[i]) == 0);
+            assert(t && t->rows == rows[i] && t->cols == 2);
+            assert(t->columns[0][rows[i] - 1] == (double)(rows[i] - 1) && t->columns[1][0] == i + 0.5);
+        }
+        assert(r->rows == 70013 && r->bad_rows == 1);
+
+        // Aggregate: rows in file order
+        CsvTable *all = csv_ingest_combine(r);
+        assert(all && all->rows == 70013 && all->cols == 2 && strcmp(all->names[1], "B") == 0);
+        assert(all->columns[1][9] == 0.5 && all->columns[1][10] == 1.5 && all->columns[1][70012] == 3.5);
+        csv_table_free(all);
+        csv_ingest_free(r);
+    }
+
+    // Directory scan: matching names only, sorted
+    CsvIngestResult *r = csv_ingest_directory(".", ".unit_ingest", NULL);
+    assert(r && r->count == 3 && r->failed == 0);
+    assert(strcmp(r->files[0].path, "./a.unit_ingest") == 0 && strcmp(r->files[2].path, "./c.unit_ingest") == 0);
+    csv_ingest_free(r);
+
+    // A compressed file is left to the decompressor instead of being read first
+    if (system("gzip -c a.unit_ingest > a.unit_ingest.gz") == 0) {
+        const char *packed[] = {"a.unit_ingest.gz", "c.unit_ingest"};
+        for (int mode = 0; mode < 2; mode++) {
+            CsvIngestOptions opts = csv_ingest_default_options();
+            opts.use_io_uring = (mode == 0);
+            r = csv_ingest_files(packed, 2, &opts);
+            assert(r && r->failed == 0 && r->rows == 70003);
+            assert(r->files[0].table->columns[1][69999] == 1.5);
+            csv_ingest_free(r);
+        }
+    }
+    remove("a.unit_ingest.gz");
+
+    for (size_t i = 0; i < 4; i++) remove(paths[i]);
+    printf("PASSED\n");
+}
+
+// Runs the volume pipeline over 'text' and returns the output (caller frees)
+static char *run_cached_pipeline(const char *text, double k, CsvResultCache *cache, PipelineStats *stats) {
+    FILE *in = tmpfile(), *out = tmpfile();
+    assert(in && out && fputs(text, in) != EOF);
+    rewind(in);
+    PipelineOptions opts = csv_pipeline_default_options();
+    opts.k = k;
+    opts.batch_rows = 64;
+    opts.cache = cache;
+    assert(csv_pipeline_run(in, out, &opts, stats));
+
+    long len = ftell(out);
+    char *result = malloc((size_t)len + 1);
+    rewind(out);
+    assert(result && fread(result, 1, (size_t)len, out) == (size_t)len);
+    result[len] = '\0';
+    fclose(in);
+    fclose(out);
+    return result;
+}
+
+void test_csv_result_cache_module() {
+    printf("[TEST] CSV Result Cache Module... ");
+
+    const char *dir = "unit_test_results/nested";
+    assert(system("rm -rf unit_test_results") == 0);
+    CsvResultCache *cache = csv_result_cache_open(dir);
+    assert(cache);
+
+    // Keys depend on data and parameters
+    double k1 = 1.0, k6 = 6.0;
+    CsvResultKey a = csv_result_key("1,2,3\n", 6, &k1, sizeof(k1));
+    CsvResultKey b = csv_result_key("1,2,3\n", 6, &k1, sizeof(k1));
+    CsvResultKey c = csv_result_key("1,2,3\n", 6, &k6, sizeof(k6));
+    CsvResultKey d = csv_result_key("1,2,4\n", 6, &k1, sizeof(k1));
+    assert(a.lo == b.lo && a.hi == b.hi);
+    assert(a.lo != c.lo && a.hi != c.hi && a.lo != d.lo && a.hi != d.hi);
+
+    // Round trip, miss for unknown keys
+    CsvResultEntry e;
+    const uint32_t bad[] = {2, 5};
+    assert(!csv_result_cache_get(cache, a, &e));
+    assert(csv_result_cache_put(cache, a, "6\n12\n", 5, bad, 2));
+    assert(csv_result_cache_get(cache, a, &e));
+    assert(e.len == 5 && memcmp(e.data, "6\n12\n", 5) == 0 && e.bad_count == 2 && e.bad_rows[1] == 5);
+    csv_result_entry_free(&e);
+    assert(!csv_result_cache_get(cache, c, &e));
+
+    // Pipeline: a rerun is served from the cache; an inserted row only recomputes nearby batches
+    size_t cap = 1 << 20, len = 0;
+    char *text = malloc(cap), *edited = malloc(cap);
+    assert(text && edited);
+    len += (size_t)sprintf(text, "X1,Y1,Z1,M1,X2,Y2,Z2,M2,X3,Y3,Z3,M3\n");
+    size_t middle = 0;
+    for (int r = 0; r < 3000; r++) {
+        if (r == 1500) middle = len;
+        if (r == 10) len += (size_t)sprintf(text + len, "bad row\n");
+        else len += (size_t)sprintf(text + len, "%d,0,0,%d,0,%d,0,2,0,0,3,3\n", r, r, r % 7 + 1);
+    }
+    memcpy(edited, text, middle);
+    size_t elen = middle + (size_t)sprintf(edited + middle, "5,0,0,5,0,5,0,5,0,0,5,5\n");
+    memcpy(edited + elen, text + middle, len - middle + 1);
+
+    PipelineStats s1, s2, s3, s4, plain;
+    char *first = run_cached_pipeline(text, 1.0, cache, &s1);
+    char *again = run_cached_pipeline(text, 1.0, cache, &s2);
+    assert(s1.rows_cached == 0 && s2.rows_cached == s2.rows_in && s2.rows_bad == 1);
+    assert(strcmp(first, again) == 0);
+
+    char *delta = run_cached_pipeline(edited, 1.0, cache, &s3);
+    char *expect = run_cached_pipeline(edited, 1.0, NULL, &plain);
+    assert(strcmp(delta, expect) == 0 && s3.rows_bad == 1);
+    assert(s3.rows_cached > s3.rows_in * 9 / 10 && s3.rows_cached < s3.rows_in);
+
+    // Another k is another key
+    char *pyramid = run_cached_pipeline(text, 6.0, cache, &s4);
+    assert(s4.rows_cached == 0 && strcmp(pyramid, first) != 0);
+
+    free(first); free(again); free(delta); free(expect); free(pyramid);
+    free(text);
+    free(edited);
+    csv_result_cache_close(cache);
+    assert(system("rm -rf unit_test_results") == 0);
+    printf("PASSED\n");
+}
+
+void test_tester_suite_module() {
+    printf("[TEST] Test Suite Loader Module... ");
+
+    // By name, columns in any order; unparsable rows keep their place
+    const char *path = "unit_test_suite.csv";
+    FILE *f = fopen(path, "w");
+    assert(f);
+    fprintf(f, "EXPECTED_VOLUME,V3_Z,V3_Y,V3_X,V2_Z,V2_Y,V2_X,V1_Z,V1_Y,V1_X\n");
+    fprintf(f, "24,4,0,0,0,3,0,0,0,2\n");
+    fprintf(f, "oops\n");
+    fprintf(f, "1,1,0,0,0,1,0,0,0,1\n");
+    fclose(f);
+
+    TestSuite *s = test_suite_load(path);
+    assert(s && s->count == 3 && s->error_count == 1);
+    assert(s->valid[0] && !s->valid[1] && s->valid[2]);
+    assert(s->columns[0][0] == 2.0 && s->columns[4][0] == 3.0 && s->columns[8][0] == 4.0 && s->columns[9][0] == 24.0);
+    assert(s->columns[9][2] == 1.0);
+    assert(s->columns[1] == s->columns[0] + s->count); // One contiguous block
+    test_suite_free(s);
+
+    // Other header names: positions of the 13-column layout
+    f = fopen(path, "w");
+    assert(f);
+    fprintf(f, "A,B,C,D,E,F,G,H,I,J,K,L,M\n1,0,0,1,0,1,0,1,0,0,1,1,1\n");
+    fclose(f);
+    s = test_suite_load(path);
+    assert(s && s->count == 1 && s->valid[0] && s->columns[6][0] == 0.0 && s->columns[8][0] == 1.0 && s->columns[9][0] == 1.0);
+    test_suite_free(s);
+
+    remove(path);
+    assert(test_suite_load("unit_test_missing.csv") == NULL);
+    printf("PASSED\n");
+}
+
+void test_tester_parallel_module() {
+    printf("[TEST] Parallel Test Report Module... ");
+
+    // More rows than one report block, with failures and bad rows scattered through
+    const char *path = "unit_test_parallel.csv";
+    FILE *f = fopen(path, "w");
+    assert(f);
+    fprintf(f, "V1_X,V1_Y,V1_Z,V2_X,V2_Y,V2_Z,V3_X,V3_Y,V3_Z,EXPECTED_VOLUME\n");
+    for (int i = 0; i < 70000; i++) {
+        if (i % 997 == 0) fprintf(f, "bad\n");
+        else fprintf(f, "%d,0,0,0,%d,0,0,0,1,%d\n", i % 7 + 1, i % 5 + 1, (i % 7 + 1) * (i % 5 + 1) + (i % 101 == 0));
+    }
+    fclose(f);
+
+    TestSuite *s = test_suite_load(path);
+    assert(s && s->count == 70000);
+    TestOperation ops[] = {
+        test_volume_operation(volumeParallelepiped, "Volume", 1.0),
+        test_cross_operation(crossProduct),
+        test_scalar_operation(scalaricProduct)
+    };
+
+    // Same bytes for every thread count
+    char *reports[3] = {NULL, NULL, NULL};
+    size_t lengths[3] = {0, 0, 0};
+    unsigned int threads[3] = {1, 3, 8};
+    for (int t = 0; t < 3; t++) {
+        fflush(stdout);
+        int saved = dup(fileno(stdout));
+        FILE *capture = tmpfile();
+        assert(saved >= 0 && capture);
+        dup2(fileno(capture), fileno(stdout));
+        run_all_tests(s, ops, sizeof(ops) / sizeof(ops[0]), threads[t]);
+        fflush(stdout);
+        dup2(saved, fileno(stdout));
+        close(saved);
+
+        lengths[t] = (size_t)ftell(capture);
+        reports[t] = malloc(lengths[t] + 1);
+        assert(reports[t]);
+        rewind(capture);
+        assert(fread(reports[t], 1, lengths[t], capture) == lengths[t]);
+        reports[t][lengths[t]] = '\0';
+        fclose(capture);
+    }
+    assert(lengths[0] > 0 && lengths[0] == lengths[1] && lengths[0] == lengths[2]);
+    assert(memcmp(reports[0], reports[1], lengths[0]) == 0 && memcmp(reports[0], reports[2], lengths[0]) == 0);
+    assert(strstr(reports[0], "Test 1: ERROR") && strstr(reports[0], "Test 70000: "));
+    assert(strstr(reports[0], "Errors: 71\n"));
+
+    for (int t = 0; t < 3; t++) free(reports[t]);
+    test_suite_free(s);
+    remove(path);
+    printf("PASSED\n");
+}
+
+void test_matrice_module() {
+    printf("[TEST] Matrice Storage Module... ");
+
+    // Both layouts: one aligned buffer, every row aligned
+    MatriceLayout layouts[2] = {MATRICE_INTERLEAVED, MATRICE_PLANAR};
+    for (int l = 0; l < 2; l++) {
+        matrice *m = matrice_create(5, 7, layouts[l]);
+        assert(m && m->rows == 5 && m->cols == 7 && m->layout == layouts[l]);
+        assert((uintptr_t)m->data % MATRICE_ALIGN == 0 && (m->stride * sizeof(unsigned short)) % MATRICE_ALIGN == 0);
+        for (unsigned int i = 0; i < 5; i++)
+            for (unsigned int j = 0; j < 7; j++) {
+                pix p = {(unsigned short)(i * 10 + j), (unsigned short)(i + 100), (unsigned short)(j + 200)};
+                matrice_set(m, i, j, p);
+            }
+        pix q = matrice_get(m, 3, 4);
+        assert(q.R == 34 && q.G == 103 && q.B == 204);
+
+        // Compatibility accessor and row views match the layout
+        if (layouts[l] == MATRICE_INTERLEAVED) {
+            assert(matrice_pixel(m, 3, 4)->R == 34 && matrice_row(m, 3)[4].B == 204);
+            assert(matrice_pixel(m, 5, 0) == NULL && matrice_channel_row(m, 0, 0) == NULL);
+        } else {
+            assert(matrice_pixel(m, 3, 4) == NULL && matrice_channel_row(m, 1, 3)[4] == 103);
+        }
+
+        matrice *other = matrice_convert(m, layouts[1 - l]);
+        assert(other && other->layout == layouts[1 - l]);
+        q = matrice_get(other, 4, 6);
+        assert(q.R == 46 && q.G == 104 && q.B == 206);
+        free_matrice(other);
+
+        matrice *r = remove_row(m, 1);
+        matrice *c = remove_col(m, 2);
+        assert(r && r->rows == 4 && matrice_get(r, 1, 0).R == 20);
+        assert(c && c->cols == 6 && matrice_get(c, 0, 2).R == 3 && matrice_get(c, 4, 1).B == 201);
+        free_matrice(r);
+        free_matrice(c);
+        free_matrice(m);
+    }
+
+    // Same seed, same pixels
+    matrice *a = generateMatrice(4, 4, 7);
+    matrice *b = generateMatrice(4, 4, 7);
+    assert(a && b && memcmp(matrice_row(a, 3), matrice_row(b, 3), 4 * sizeof(pix)) == 0);
+    pix corner = matrice_get(a, 0, 3);
+    transposeMatriceInPlace(a);
+    assert(matrice_get(a, 3, 0).R == corner.R && matrice_get(a, 3, 0).B == corner.B);
+    free_matrice(a);
+    free_matrice(b);
+
+    // | 3 1 |
+    // | 2 4 | = 10 in every channel
+    matrice *m = matrice_create(2, 2, MATRICE_INTERLEAVED);
+    unsigned short v[4] = {3, 1, 2, 4};
+    for (int k = 0; k < 4; k++) {
+        pix p = {v[k], v[k], v[k]};
+        matrice_set(m, (unsigned int)k / 2, (unsigned int)k % 2, p);
+    }
+    pix *d = Det(m);
+    assert(d && d->R == 10 && d->G == 10 && d->B == 10);
+    free_pixel(d);
+    free_matrice(m);
+
+    // Kernels agree: exact, modulo 2^16 and LU (zero pivot forces a row swap)
+    long long ex[9] = {0, 2, 1, 3, -1, 4, 5, 2, 0}, det = 0;
+    unsigned short wr[9];
+    double lu[9];
+    for (int k = 0; k < 9; k++) { wr[k] = (unsigned short)ex[k]; lu[k] = (double)ex[k]; }
+    assert(det_bareiss(ex, 3, &det) && det == 51);
+    assert(det_ushort(wr, 3) == 51);
+    assert(fabs(det_lu(lu, 3) - 51.0) < 1e-9);
+    long long neg[4] = {1, 2, 3, 4};
+    unsigned short negw[4] = {1, 2, 3, 4};
+    assert(det_bareiss(neg, 2, &det) && det == -2 && det_ushort(negw, 2) == 65534);
+
+    // 40 x 40 diagonal of 3s: 3^40 overflows 64 bits, Det wraps like unsigned short
+    m = matrice_create(40, 40, MATRICE_PLANAR);
+    unsigned short expected = 1;
+    for (unsigned int i = 0; i < 40; i++) {
+        pix p = {3, 1, (unsigned short)(i == 7 ? 0 : 2)};
+        matrice_set(m, i, i, p);
+        expected = (unsigned short)(expected * 3u);
+    }
+    d = Det(m);
+    assert(d && d->R == expected && d->G == 1 && d->B == 0);
+    assert(fabs(matrice_det_real(m, 0) / pow(3.0, 40) - 1.0) < 1e-12);
+    free_pixel(d);
+    free_matrice(m);
+    printf("PASSED\n");
+}
+
+void test_matrice_transpose_module() {
+    printf("[TEST] Matrice Transpose Module... ");
+
+    // Any shape, both layouts: in place, out of place, across either diagonal
+    unsigned short shapes[4][2] = {{1, 9}, {7, 3}, {40, 70}, {33, 33}};
+    MatriceLayout layouts[2] = {MATRICE_INTERLEAVED, MATRICE_PLANAR};
+    for (int s = 0; s < 4; s++) {
+        for (int l = 0; l < 2; l++) {
+            unsigned short rows = shapes[s][0], cols = shapes[s][1];
+            matrice *m = matrice_create(rows, cols, layouts[l]);
+            assert(m);
+            rand_fill_matrice(m, 11 + s);
+            matrice *t = transposeMatrice(m, NULL, 0);
+            matrice *a = transposeMatrice(m, NULL, 1);
+            matrice *p = matrice_convert(m, layouts[1 - l]);
+            assert(t && a && p && t->rows == cols && t->cols == rows);
+            transposeMatriceInPlace(p);
+            assert(p->rows == cols && p->cols == rows);
+            for (unsigned int i = 0; i < rows; i++) {
+                for (unsigned int j = 0; j < cols; j++) {
+                    pix v = matrice_get(m, i, j);
+                    pix x = matrice_get(t, j, i), y = matrice_get(p, j, i);
+                    pix z = matrice_get(a, cols - 1u - j, rows - 1u - i);
+                    assert(x.R == v.R && x.G == v.G && x.B == v.B);
+                    assert(y.R == v.R && y.G == v.G && y.B == v.B);
+                    assert(z.R == v.R && z.G == v.G && z.B == v.B);
+                }
+            }
+            // In place across the anti-diagonal gives the same pixels
+            assert(transposeMatrice(p, p, 0) == p && transposeMatrice(p, p, 1) == p);
+            for (unsigned int i = 0; i < a->rows; i++)
+                for (unsigned int j = 0; j < a->cols; j++)
+                    assert(matrice_get(p, i, j).G == matrice_get(a, i, j).G);
+            free_matrice(t);
+            free_matrice(a);
+            free_matrice(p);
+            free_matrice(m);
+        }
+    }
+
+    // Large enough to split across threads: same result as one thread
+    matrice *big = generateMatrice(700, 500, 3);
+    matrice *one = matrice_create(500, 700, MATRICE_INTERLEAVED);
+    matrice *many = matrice_create(500, 700, MATRICE_PLANAR);
+    assert(big && one && many);
+    assert(matrice_transpose_into(big, one, false, 1) && matrice_transpose_into(big, many, false, 4));
+    for (unsigned int i = 0; i < 500; i += 7)
+        for (unsigned int j = 0; j < 700; j++)
+            assert(matrice_get(one, i, j).B == matrice_get(many, i, j).B && matrice_get(one, i, j).R == matrice_get(big, j, i).R);
+    assert(!matrice_transpose_into(big, big, false, 1));
+    assert(transposeMatrice(big, one, 0) == one && transposeMatrice(one, one, 0) == one);
+    assert(transposeMatrice(big, one, 0) == NULL);   // Wrong shape now
+    free_matrice(big);
+    free_matrice(one);
+    free_matrice(many);
+    printf("PASSED\n");
+}
+
+void test_matrice_image_module() {
+    printf("[TEST] Matrice PPM/PGM Module... ");
+    const char *path = "unit_test_image.ppm";
+
+    // 8-bit and 16-bit PPM round trips, read back in both layouts
+    unsigned int maxvals[2] = {255, 1000};
+    for (int k = 0; k < 2; k++) {
+        matrice *m = matrice_create(37, 53, MATRICE_PLANAR);
+        assert(m);
+        for (unsigned int i = 0; i < 37; i++)
+            for (unsigned int j = 0; j < 53; j++) {
+                pix p = {(unsigned short)((i * 53 + j) % (maxvals[k] + 1)), (unsigned short)(i * 3), (unsigned short)(j * 4)};
+                matrice_set(m, i, j, p);
+            }
+        assert(matrice_write_pnm(m, path, 3, maxvals[k]));
+
+        PnmImage img;
+        assert(pnm_open(path, &img));
+        assert(img.width == 53 && img.height == 37 && img.channels == 3 && img.maxval == maxvals[k]);
+        assert(img.sample_bytes == (k ? 2u : 1u) && img.row_bytes == 53u * 3u * img.sample_bytes);
+        assert(img.pixels[img.row_bytes * 2 + img.sample_bytes * 6 - 1] == 4);   // Row 2, pixel 1, low byte of B
+        pnm_close(&img);
+
+        for (int l = 0; l < 2; l++) {
+            unsigned int maxval = 0;
+            matrice *back = matrice_read_pnm(path, l ? MATRICE_PLANAR : MATRICE_INTERLEAVED, &maxval);
+            assert(back && back->rows == 37 && back->cols == 53 && maxval == maxvals[k]);
+            for (unsigned int i = 0; i < 37; i++)
+                for (unsigned int j = 0; j < 53; j++) {
+                    pix a = matrice_get(m, i, j), b = matrice_get(back, i, j);
+                    assert(a.R == b.R && a.G == b.G && a.B == b.B);
+                }
+            free_matrice(back);
+        }
+        free_matrice(m);
+    }
+
+    // PGM: luma out, R = G = B in; samples above maxval are clamped
+    matrice *m = matrice_create(2, 2, MATRICE_INTERLEAVED);
+    pix px[4] = {{100, 100, 100}, {255, 0, 0}, {0, 0, 255}, {300, 300, 300}};
+    for (int k = 0; k < 4; k++) matrice_set(m, (unsigned int)k / 2, (unsigned int)k % 2, px[k]);
+    assert(matrice_write_pnm(m, path, 1, 255));
+    matrice *g = matrice_read_pnm(path, MATRICE_INTERLEAVED, NULL);
+    assert(g && matrice_get(g, 0, 0).G == 100 && matrice_get(g, 0, 1).R == 76 && matrice_get(g, 1, 0).B == 29);
+    assert(matrice_get(g, 1, 1).R == 255);
+    free_matrice(g);
+    free_matrice(m);
+
+    // Comments in the header; truncated or foreign files are rejected
+    FILE *f = fopen(path, "wb");
+    assert(f);
+    fprintf(f, "P5 # gray\n# size\n3 1\n# max\n255\n%c%c%c", 1, 2, 3);
+    fclose(f);
+    g = matrice_read_pnm(path, MATRICE_PLANAR, NULL);
+    assert(g && g->cols == 3 && g->rows == 1 && matrice_get(g, 0, 2).G == 3);
+    free_matrice(g);
+    f = fopen(path, "wb");
+    assert(f);
+    fprintf(f, "P6\n4 4\n255\nshort");
+    fclose(f);
+    PnmImage img;
+    assert(!pnm_open(path, &img) && !matrice_read_pnm(path, MATRICE_INTERLEAVED, NULL));
+    assert(!pnm_open("unit_test_missing.ppm", &img));
+    assert(!matrice_write_pnm(NULL, path, 3, 255));
+
+    // Large enough for several decoding threads
+    matrice *big = generateMatrice(600, 500, 5);
+    assert(big && matrice_write_pnm(big, path, 3, 255));
+    matrice *back = matrice_read_pnm(path, MATRICE_INTERLEAVED, NULL);
+    assert(back && memcmp(matrice_row(back, 599), matrice_row(big, 599), 500 * sizeof(pix)) == 0);
+    free_matrice(back);
+    free_matrice(big);
+    remove(path);
+    printf("PASSED\n");
+}
+
+static char *read_whole_file(const char *path) {
+    FILE *f = fopen(path, "rb");
+    assert(f);
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    rewind(f);
+    char *text = malloc((size_t)len + 1);
+    assert(text && fread(text, 1, (size_t)len, f) == (size_t)len);
+    text[len] = '\0';
+    fclose(f);
+    return text;
+}
+
+void test_tester_report_module() {
+    printf("[TEST] Test Report Modes Module... ");
+
+    // One pass, one failure, one unparsable row
+    const char *path = "unit_test_report.csv";
+    const char *out = "unit_test_report.out";
+    FILE *f = fopen(path, "w");
+    assert(f);
+    fprintf(f, "V1_X,V1_Y,V1_Z,V2_X,V2_Y,V2_Z,V3_X,V3_Y,V3_Z,EXPECTED_VOLUME\n");
+    fprintf(f, "2,0,0,0,3,0,0,0,4,24\nbad\n1,0,0,0,1,0,0,0,1,5\n");
+    fclose(f);
+    TestSuite *s = test_suite_load(path);
+    assert(s && s->count == 3);
+    TestOperation ops[] = {
+        test_volume_operation(volumeParallelepiped, "Vol <&>", 1.0),
+        test_scalar_operation(scalaricProduct)
+    };
+    size_t n = sizeof(ops) / sizeof(ops[0]);
+
+    TestReportOptions o = test_report_default_options();
+    o.path = out;
+    o.threads = 2;
+    o.detail = TEST_REPORT_FAILURES;
+    assert(run_tests_report(s, ops, n, &o));
+    char *text = read_whole_file(out);
+    assert(!strstr(text, "Test 1:") && strstr(text, "Test 2: ERROR") && strstr(text, "Test 3: FAIL!"));
+    assert(strstr(text, "Passed: 1 | Failed: 1 | Errors: 1"));
+    free(text);
+
+    o.detail = TEST_REPORT_SUMMARY;
+    assert(run_tests_report(s, ops, n, &o));
+    text = read_whole_file(out);
+    assert(!strstr(text, "Test 2:") && strstr(text, "--- Scalar Product Summary ---"));
+    free(text);
+
+    o.detail = TEST_REPORT_ALL;
+    o.format = TEST_REPORT_JSON;
+    assert(run_tests_report(s, ops, n, &o));
+    text = read_whole_file(out);
+    assert(strstr(text, "\"name\": \"Vol <&>\", \"kind\": \"volume\""));
+    assert(strstr(text, "\"cases\": [\n        {\"test\": 1, \"status\": \"pass\""));
+    assert(strstr(text, "{\"test\": 2, \"status\": \"error\"}"));
+    assert(strstr(text, "\"tests\": 6, \"passed\": 1, \"failed\": 1, \"errors\": 2"));
+    free(text);
+
+    o.format = TEST_REPORT_JUNIT;
+    assert(run_tests_report(s, ops, n, &o));
+    text = read_whole_file(out);
+    assert(strstr(text, "<testsuites tests=\"6\" failures=\"1\" errors=\"2\""));
+    assert(strstr(text, "<testsuite name=\"Vol &lt;&amp;&gt;\" tests=\"3\" failures=\"1\" errors=\"1\""));
+    assert(strstr(text, "name=\"Test 3\"><failure message=\"Calculated 1, expected 5\"/>"));
+    assert(strstr(text, "</testsuites>\n"));
+    free(text);
+
+    // Unreadable suite: still a well-formed report
+    assert(!run_tests_report(NULL, ops, n, &o));
+    text = read_whole_file(out);
+    assert(strstr(text, "<error message=\"Cannot read CSV header\"/>"));
+    free(text);
+
+    test_suite_free(s);
+    remove(path);
+    remove(out);
+    printf("PASSED\n");
+}
+
+static size_t bench_test_run(void *state) {
+    size_t *calls = (size_t *)state;
+    (*calls)++;
+    bench_sink = (double)*calls;
+    return 10;
+}
+
+static void *bench_test_setup(size_t size, unsigned int seed) {
+    (void)seed;
+    size_t *calls = calloc(1, sizeof(size_t));
+    return size > 100 ? NULL : calls;   // Oversized inputs fail setup
+}
+
+void test_bench_harness_module() {
+    printf("[TEST] Benchmark Harness Module... ");
+
+    size_t sizes[BENCH_MAX_SIZES];
+    assert(bench_parse_sizes("10,1e3,64", sizes));
+    assert(sizes[0] == 10 && sizes[1] == 1000 && sizes[2] == 64 && sizes[3] == 0);
+    assert(!bench_parse_sizes("", sizes) && !bench_parse_sizes("10,,5", sizes));
+    assert(!bench_parse_sizes("0", sizes) && !bench_parse_sizes("1.5", sizes) && !bench_parse_sizes("1,2,3,4,5,6,7,8", sizes));
+
+    BenchCase c = {"test/counter", bench_test_setup, bench_test_run, free, {5, 0}, 0};
+    BenchOptions opts = bench_default_options();
+    opts.repetitions = 7;
+    opts.warmup = 2;
+    opts.min_sample_ns = 1000.0;
+    assert(bench_selected(&c, &opts));
+    opts.filter = "count";
+    assert(bench_selected(&c, &opts));
+    opts.filter = "modular";
+    assert(!bench_selected(&c, &opts));
+
+    BenchResult r;
+    assert(bench_run_case(&c, 5, &opts, &r));
+    assert(r.repetitions == 7 && r.items == 10 && r.calls_per_sample >= 1 && r.size == 5);
+    for (unsigned int i = 1; i < r.repetitions; i++) assert(r.samples[i - 1] <= r.samples[i]);
+    assert(r.min <= r.p10 && r.p10 <= r.median && r.median <= r.p90 && r.p90 <= r.max);
+    assert(r.median == r.samples[3]);
+    assert(!bench_run_case(&c, 1000, &opts, &r) && r.size == 5);
+
+    FILE *f = tmpfile();
+    assert(f && bench_write_json(f, &r, 1, &opts, NULL));
+    long len = ftell(f);
+    char *json = malloc((size_t)len + 1);
+    assert(json);
+    rewind(f);
+    assert(fread(json, 1, (size_t)len, f) == (size_t)len);
+    json[len] = '\0';
+    fclose(f);
+    assert(strstr(json, "\"name\": \"test/counter\"") && strstr(json, "\"samples_ns\": ["));
+    assert(json[0] == '{' && json[len - 2] == '}');
+    free(json);
+
+    // Mann-Whitney: complete separation of 10 vs 10 gives z = 49.5 / sqrt(175)
+    double lo[10], hi[10];
+    for (int i = 0; i < 10; i++) {
+        lo[i] = 100.0 + i;
+        hi[i] = 200.0 + i;
+    }
+    assert(fabs(bench_mann_whitney(lo, 10, hi, 10) - 0.5 * erfc(49.5 / sqrt(175.0) / sqrt(2.0))) < 1e-12);
+    assert(bench_mann_whitney(hi, 10, lo, 10) > 0.99);
+    assert(bench_mann_whitney(lo, 10, lo, 10) > 0.4);
+    assert(bench_mann_whitney(lo, 1, lo, 1) == 1.0);   // All tied
+
+    // Result files round-trip, then a slower run is flagged as a regression
+    BenchEnvironment env;
+    bench_environment(&env, "-O2 \"quoted\"");
+    assert(env.cpu[0] && env.simd[0] && env.threads >= 1 && strcmp(env.flags, "-O2 \"quoted\"") == 0);
+    const char *path = "unit_test_bench.json";
+    f = fopen(path, "w");
+    assert(f && bench_write_json(f, &r, 1, &opts, &env));
+    fclose(f);
+    BenchReport *base = bench_load_json(path);
+    assert(base && base->count == 1 && bench_environment_matches(&base->env, &env));
+    assert(strcmp(base->results[0].name, "test/counter") == 0 && base->results[0].size == 5);
+    assert(base->results[0].repetitions == 7 && fabs(base->results[0].median - r.median) <= 1e-5 * r.median);
+
+    BenchResult slow = r;
+    double slow_samples[7];
+    for (int i = 0; i < 7; i++) slow_samples[i] = r.samples[i] * 1.5 + 1.0;
+    slow.samples = slow_samples;
+    slow.median = r.median * 1.5 + 1.0;
+    BenchComparison cmp[2];
+    assert(bench_compare(base, &slow, 1, 0.05, 0.01, cmp) == 1);
+    assert(cmp[0].regression && !cmp[0].improvement && cmp[0].change > 0.4);
+    assert(bench_compare(base, &r, 1, 0.05, 0.01, cmp) == 1 && !cmp[0].regression);
+    slow.size = 6;      // No baseline entry
+    assert(bench_compare(base, &slow, 1, 0.05, 0.01, cmp) == 0);
+    bench_report_free(base);
+
+    f = fopen(path, "w");
+    assert(f);
+    fprintf(f, "{\"benchmarks\": [{\"name\": \"x\", \"samples_ns\": [1, 2}");
+    fclose(f);
+    assert(bench_load_json(path) == NULL && bench_load_json("unit_test_missing.json") == NULL);
+    remove(path);
+
+    bench_result_free(&r);
+    printf("PASSED\n");
+}
+
+// Whole contents of a stream written by dataset_write
+static char *dataset_test_output(const DatasetOptions *opts, size_t *len) {
+    FILE *f = tmpfile();
+    assert(f && dataset_write(f, opts, NULL));
+    *len = (size_t)ftell(f);
+    char *text = malloc(*len + 1);
+    assert(text);
+    rewind(f);
+    assert(fread(text, 1, *len, f) == *len);
+    text[*len] = '\0';
+    fclose(f);
+    return text;
+}
+
+void test_dataset_gen_module() {
+    printf("[TEST] Dataset Generator Module... ");
+
+    DatasetOptions opts = dataset_default_options();
+    opts.rows = DATASET_CHUNK_ROWS * 2 + 123;
+    opts.coplanar = 0.1;
+    opts.zero = 0.05;
+    opts.huge = 0.01;
+    assert(dataset_validate(&opts) == NULL);
+
+    // Same seed, same bytes, whatever the thread count
+    size_t len1, len3;
+    opts.threads = 1;
+    char *one = dataset_test_output(&opts, &len1);
+    opts.threads = 3;
+    char *three = dataset_test_output(&opts, &len3);
+    assert(len1 == len3 && memcmp(one, three, len1) == 0);
+
+    // Each chunk stands alone: chunk 1 is the matching slice of the file
+    char *buf = NULL;
+    size_t cap = 0;
+    DatasetStats st = {0, 0, 0};
+    size_t c0 = dataset_format_chunk(&opts, 0, &buf, &cap, &st);
+    size_t header = (size_t)(strchr(one, '\n') - one) + 1;
+    assert(c0 > 0 && memcmp(one + header, buf, c0) == 0);
+    size_t c1 = dataset_format_chunk(&opts, 1, &buf, &cap, &st);
+    assert(c1 > 0 && memcmp(one + header + c0, buf, c1) == 0);
+    assert(st.rows == 2 * DATASET_CHUNK_ROWS && st.degenerate > 0);
+    assert(dataset_format_chunk(&opts, 3, &buf, &cap, NULL) == 0);
+    free(buf);
+    free(three);
+
+    opts.seed = 2;
+    opts.threads = 1;
+    three = dataset_test_output(&opts, &len3);
+    assert(len1 != len3 || memcmp(one, three, len1) != 0);
+    free(three);
+    free(one);
+
+    // The test layout loads as a suite; zero rows expect volume 0
+    opts = dataset_default_options();
+    opts.rows = 500;
+    opts.zero = 1.0;
+    FILE *f = fopen("unit_test_dataset.csv", "w");
+    assert(f && dataset_write(f, &opts, NULL));
+    fclose(f);
+    TestSuite *suite = test_suite_load("unit_test_dataset.csv");
+    assert(suite && suite->count == 500 && suite->error_count == 0);
+    for (size_t i = 0; i < suite->count; i++) assert(suite->columns[9][i] == 0.0);
+    test_suite_free(suite);
+
+    // Reduced precision: the expected volumes match the components as printed
+    opts = dataset_default_options();
+    opts.rows = 3000;
+    opts.distribution = DATASET_UNIFORM;
+    opts.precision = 4;
+    opts.coplanar = 0.2;
+    f = fopen("unit_test_dataset.csv", "w");
+    assert(f && dataset_write(f, &opts, NULL));
+    fclose(f);
+    suite = test_suite_load("unit_test_dataset.csv");
+    assert(suite && suite->count == 3000 && suite->error_count == 0);
+    for (size_t i = 0; i < suite->count; i++) {
+        double a[3], b[3], c[3];
+        for (int k = 0; k < 3; k++) {
+            a[k] = suite->columns[k][i];
+            b[k] = suite->columns[3 + k][i];
+            c[k] = suite->columns[6 + k][i];
+        }
+        struct vector_struct sv[3] = {{3, a, NULL}, {3, b, NULL}, {3, c, NULL}};
+        vector v[3] = {&sv[0], &sv[1], &sv[2]};
+        assert(fabs(volumeParallelepiped(v, 1.0) - suite->columns[9][i]) < 0.001);
+    }
+    test_suite_free(suite);
+    remove("unit_test_dataset.csv");
+
+    // Matrix rows count pixels row by row
+    opts = dataset_default_options();
+    opts.kind = DATASET_MATRIX;
+    opts.rows = 6;
+    opts.cols = 4;
+    opts.header = false;
+    one = dataset_test_output(&opts, &len1);
+    assert(strncmp(one, "0,0,", 4) == 0 && strstr(one, "\n1,1,"));
+    free(one);
+
+    DatasetKind kind;
+    DatasetDistribution dist;
+    assert(dataset_parse_kind("mesh", &kind) && kind == DATASET_MESH && !dataset_parse_kind("cube", &kind));
+    assert(dataset_parse_distribution("normal", &dist) && dist == DATASET_NORMAL);
+    opts.coplanar = 0.7;
+    opts.zero = 0.7;
+    assert(dataset_validate(&opts) != NULL);
+    printf("PASSED\n");
+}
+
 int main() {
     printf("=== UNIT TEST RUNNER ===\n");
     test_modular_module();
     test_vector_module();
+    test_vector_stats_module();
+    test_fast_math_module();
+    test_spatial_order_module();
+    test_halfspace_module();
+    test_reproducible_reduce_module();
+    test_csv_map_module();
+    test_csv_parallel_module();
+    test_ring_queue_module();
+    test_csv_pipeline_module();
+    test_csv_cache_module();
+    test_csv_schema_module();
+    test_csv_writer_module();
+    test_csv_compress_module();
+    test_csv_tail_module();
+    test_csv_ingest_module();
+    test_csv_result_cache_module();
+    test_tester_suite_module();
+    test_tester_parallel_module();
+    test_matrice_module();
+    test_matrice_transpose_module();
+    test_matrice_image_module();
+    test_tester_report_module();
+    test_bench_harness_module();
+    test_dataset_gen_module();
     printf("ALL MODULE UNIT TESTS PASSED.\n");
     return 0;
 }
\ No newline at end of file
@@ -1,4 +1,4 @@
-#include "ui.h"
+#include "UI.h"
 
 // --- Helper Functions (Internal) ---
 
@@ -77,7 +77,7 @@ void display_about(void) {
     printf("=============================================\n");
     printf("|              About This Program           |\n");
     printf("=============================================\n\n");
-    printf("Vector & Volume Calculator v2.0 (ADT Version)\n");
+    printf("Vector & Volume Calculator v" CALC_LIB_VERSION " (ADT Version)\n");
     printf("---------------------------------------------\n");
     printf("Modules:\n");
     printf(" * vectorOps: Dynamic Vector ADT & Geometry\n");
@@ -112,7 +112,7 @@ void run_tester_module(void) {
         return;
     }
 
-    printf("\n1. Parallelepiped (k=1)\n2. Pyramid (k=6)\n3. Cross Product\n4. Scalar Product\n5. All\n0. Back\n");
+    printf("\n1. Parallelepiped (k=1)\n2. Pyramid (k=6)\n3. Cross Product\n4. Scalar Product\n5. All\n6. Build Binary Cache\n7. Process New Rows (tail)\n0. Back\n");
     test_choice = get_user_choice();
 
     if (test_choice == 0) { csv_close(csv); return; }
@@ -122,12 +122,35 @@ void run_tester_module(void) {
         case 2: run_volume_tests(csv, volumeParallelepiped, "Pyramid", 6.0); break;
         case 3: run_cross_product_tests(csv, crossProduct); break;
         case 4: run_scalar_product_tests(csv, scalaricProduct); break;
-        case 5: 
-            run_volume_tests(csv, volumeParallelepiped, "Parallelepiped", 1.0);
-            run_volume_tests(csv, volumeParallelepiped, "Pyramid", 6.0);
-            run_cross_product_tests(csv, crossProduct);
-            run_scalar_product_tests(csv, scalaricProduct);
+        case 5: {
+            // Parse once, run every operation over the loaded suite
+            const TestOperation ops[] = {
+                test_volume_operation(volumeParallelepiped, "Parallelepiped", 1.0),
+                test_volume_operation(volumeParallelepiped, "Pyramid", 6.0),
+                test_cross_operation(crossProduct),
+                test_scalar_operation(scalaricProduct)
+            };
+            TestSuite *suite = test_suite_load(filename);
+            run_all_tests(suite, ops, sizeof(ops) / sizeof(ops[0]), 0);
+            test_suite_free(suite);
             break;
+        }
+        case 6:
+            if (csv_cache_convert(filename, NULL, NULL, CSV_COL_F64)) printf("Cache written to %s%s\n", filename, CSV_CACHE_SUFFIX);
+            else printf("Error: Could not write the cache.\n");
+            break;
+        case 7: {
+            // Only rows appended since the previous run; the offset lives in <file>.tail
+            char *state = csv_tail_default_state_path(filename);
+            CsvTail *tail = state ? csv_tail_open(filename, state, true) : NULL;
+            PipelineStats stats = {0, 0, 0, 0};
+            long rows = tail ? csv_tail_pipeline(tail, stdout, NULL, &stats) : -1;
+            if (rows < 0) printf("Error: Could not read the new rows.\n");
+            else printf("\n%ld new rows (%zu skipped). Offset saved to %s\n", rows, stats.rows_bad, state);
+            csv_tail_close(tail);
+            free(state);
+            break;
+        }
         default: printf("Invalid choice.\n");
     }
     
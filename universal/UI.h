@@ -8,8 +8,11 @@
 #include <math.h>
 
 // --- Custom Library Dependencies ---
+#include "universal.h"
 #include "vectorOps.h"
 #include "csvHandler.h"
+#include "csvCache.h"
+#include "csvTail.h"
 #include "testerFile.h"
 #include "modular.h"      // Assumed existing module
 
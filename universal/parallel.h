@@ -0,0 +1,31 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stddef.h>
+
+/**
+ * @brief Work function run by parallel_for on one contiguous range.
+ * @param begin First index of the range (inclusive).
+ * @param end Last index of the range (exclusive).
+ * @param worker Index of the range, 0 .. threads-1. Useful for per-thread accumulators.
+ * @param ctx User data passed through untouched.
+ */
+typedef void (*ParallelBody)(size_t begin, size_t end, unsigned int worker, void *ctx);
+
+/**
+ * @brief Resolves a requested thread count.
+ * 0 means "use the default": the CALC_THREADS environment variable if set,
+ * otherwise the number of online CPUs.
+ * @return A thread count >= 1.
+ */
+unsigned int parallel_resolve_threads(unsigned int threads);
+
+/**
+ * @brief Splits [0, n) into 'threads' contiguous ranges and runs 'body' on each.
+ * Range k always covers the same indices for a given (n, threads), and worker 0
+ * runs on the calling thread. Empty ranges are skipped.
+ * @param threads Requested thread count (0 = default, see parallel_resolve_threads).
+ */
+void parallel_for(size_t n, unsigned int threads, ParallelBody body, void *ctx);
+
+#endif // PARALLEL_H
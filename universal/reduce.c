@@ -0,0 +1,76 @@
+#include "reduce.h"
+#include "parallel.h"
+#include <stdlib.h>
+
+typedef struct {
+    size_t n;
+    ReduceTerm term;
+    const double *vals;
+    void *ctx;
+    double *partial;
+} ReduceJob;
+
+// Fixed-shape pairwise sum: the tree depends only on n
+static double pairwise_sum(const double *v, size_t n) {
+    if (n == 0) return 0.0;
+    if (n == 1) return v[0];
+    if (n == 2) return v[0] + v[1];
+    size_t half = n / 2;
+    return pairwise_sum(v, half) + pairwise_sum(v + half, n - half);
+}
+
+static double block_sum(const ReduceJob *job, size_t b) {
+    size_t first = b * REDUCE_BLOCK;
+    size_t count = job->n - first;
+    if (count > REDUCE_BLOCK) count = REDUCE_BLOCK;
+
+    if (job->vals) return pairwise_sum(job->vals + first, count);
+
+    double terms[REDUCE_BLOCK];
+    for (size_t i = 0; i < count; i++) terms[i] = job->term(first + i, job->ctx);
+    return pairwise_sum(terms, count);
+}
+
+static void block_range(size_t begin, size_t end, unsigned int worker, void *arg) {
+    (void)worker;
+    ReduceJob *job = (ReduceJob *)arg;
+    for (size_t b = begin; b < end; b++) job->partial[b] = block_sum(job, b);
+}
+
+// Same tree as pairwise_sum over the block partials, computing each block on demand
+static double block_tree(const ReduceJob *job, size_t lo, size_t hi) {
+    if (hi - lo == 1) return block_sum(job, lo);
+    size_t half = (hi - lo) / 2;
+    return block_tree(job, lo, lo + half) + block_tree(job, lo + half, hi);
+}
+
+static double run_reduce(ReduceJob *job, unsigned int threads) {
+    if (job->n == 0) return 0.0;
+
+    size_t blocks = (job->n + REDUCE_BLOCK - 1) / REDUCE_BLOCK;
+    job->partial = malloc(sizeof(double) * blocks);
+    if (!job->partial) {
+        // Out of memory: serial, but still the identical tree
+        return block_tree(job, 0, blocks);
+    }
+
+    threads = parallel_resolve_threads(threads);
+    if (threads > blocks) threads = (unsigned int)blocks;
+    parallel_for(blocks, threads, block_range, job);
+
+    double total = pairwise_sum(job->partial, blocks);
+    free(job->partial);
+    return total;
+}
+
+double reproducible_reduce(size_t n, ReduceTerm term, void *ctx, unsigned int threads) {
+    if (!term) return 0.0;
+    ReduceJob job = {n, term, NULL, ctx, NULL};
+    return run_reduce(&job, threads);
+}
+
+double reproducible_sum(const double *vals, size_t n, unsigned int threads) {
+    if (!vals) return 0.0;
+    ReduceJob job = {n, NULL, vals, NULL, NULL};
+    return run_reduce(&job, threads);
+}
@@ -0,0 +1,32 @@
+#ifndef REDUCE_H
+#define REDUCE_H
+
+#include <stddef.h>
+
+/**
+ * @brief Number of consecutive terms summed into one partial.
+ * The block layout depends only on n, never on the thread count, so every
+ * reduction below returns bitwise identical results at any number of threads.
+ */
+#define REDUCE_BLOCK 1024
+
+/**
+ * @brief Produces term i of a reduction (called once per index, from any thread).
+ */
+typedef double (*ReduceTerm)(size_t i, void *ctx);
+
+/**
+ * @brief Reproducible sum of term(0) .. term(n-1).
+ * Terms are summed pairwise inside fixed blocks of REDUCE_BLOCK, blocks are
+ * distributed over threads, and block partials are combined with a fixed
+ * pairwise tree.
+ * @param threads 0 = default thread count. The result does not depend on it.
+ */
+double reproducible_reduce(size_t n, ReduceTerm term, void *ctx, unsigned int threads);
+
+/**
+ * @brief Reproducible sum of an array (same scheme as reproducible_reduce).
+ */
+double reproducible_sum(const double *vals, size_t n, unsigned int threads);
+
+#endif // REDUCE_H
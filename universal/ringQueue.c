@@ -0,0 +1,111 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "ringQueue.h"
+#include <stdlib.h>
+
+#define SPIN_BEFORE_PARK 64
+
+bool ring_init(RingQueue *q, size_t capacity) {
+    size_t cap = 2;
+    while (cap < capacity) cap <<= 1;
+
+    q->slots = malloc(sizeof(void *) * cap);
+    if (!q->slots) return false;
+    if (pthread_mutex_init(&q->lock, NULL) != 0) {
+        free(q->slots);
+        q->slots = NULL;
+        return false;
+    }
+    pthread_cond_init(&q->not_empty, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+    q->mask = cap - 1;
+    q->head = 0;
+    q->tail = 0;
+    q->parked_pop = 0;
+    q->parked_push = 0;
+    return true;
+}
+
+void ring_destroy(RingQueue *q) {
+    if (!q || !q->slots) return;
+    free(q->slots);
+    q->slots = NULL;
+    pthread_cond_destroy(&q->not_empty);
+    pthread_cond_destroy(&q->not_full);
+    pthread_mutex_destroy(&q->lock);
+}
+
+// Called after publishing head or tail. The full fence pairs with the one in
+// park(): either the parked side sees the new index, or we see it parked.
+static void wake(RingQueue *q, int *parked, pthread_cond_t *cond) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(parked, __ATOMIC_RELAXED) == 0) return;
+    pthread_mutex_lock(&q->lock);
+    pthread_cond_signal(cond);
+    pthread_mutex_unlock(&q->lock);
+}
+
+// Publishing without waking: used by the parked paths, which hold the lock
+static bool push_quiet(RingQueue *q, void *item) {
+    size_t tail = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    size_t head = __atomic_load_n(&q->head, __ATOMIC_ACQUIRE);
+    if (tail - head > q->mask) return false;
+
+    q->slots[tail & q->mask] = item;
+    __atomic_store_n(&q->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static bool pop_quiet(RingQueue *q, void **item) {
+    size_t head = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+    size_t tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+    if (head == tail) return false;
+
+    *item = q->slots[head & q->mask];
+    __atomic_store_n(&q->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+// Announces a parked side, then rechecks the queue under the lock
+static void park(int *parked) {
+    __atomic_fetch_add(parked, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+bool ring_try_push(RingQueue *q, void *item) {
+    if (!push_quiet(q, item)) return false;
+    wake(q, &q->parked_pop, &q->not_empty);
+    return true;
+}
+
+bool ring_try_pop(RingQueue *q, void **item) {
+    if (!pop_quiet(q, item)) return false;
+    wake(q, &q->parked_push, &q->not_full);
+    return true;
+}
+
+void ring_push(RingQueue *q, void *item) {
+    for (unsigned int spin = 0; spin < SPIN_BEFORE_PARK; spin++) {
+        if (ring_try_push(q, item)) return;
+    }
+    pthread_mutex_lock(&q->lock);
+    park(&q->parked_push);
+    while (!push_quiet(q, item)) pthread_cond_wait(&q->not_full, &q->lock);
+    __atomic_fetch_sub(&q->parked_push, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&q->lock);
+    wake(q, &q->parked_pop, &q->not_empty);
+}
+
+void *ring_pop(RingQueue *q) {
+    void *item;
+    for (unsigned int spin = 0; spin < SPIN_BEFORE_PARK; spin++) {
+        if (ring_try_pop(q, &item)) return item;
+    }
+    pthread_mutex_lock(&q->lock);
+    park(&q->parked_pop);
+    while (!pop_quiet(q, &item)) pthread_cond_wait(&q->not_empty, &q->lock);
+    __atomic_fetch_sub(&q->parked_pop, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&q->lock);
+    wake(q, &q->parked_push, &q->not_full);
+    return item;
+}
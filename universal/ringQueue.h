@@ -0,0 +1,51 @@
+#ifndef RING_QUEUE_H
+#define RING_QUEUE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <pthread.h>
+
+#define RING_CACHE_LINE 64
+
+/**
+ * @brief Bounded lock-free single-producer / single-consumer queue of pointers.
+ * Exactly one thread may push and exactly one thread may pop. head and tail
+ * live on separate cache lines so producer and consumer do not false-share.
+ * The blocking calls spin briefly, then park on a condition variable until the
+ * other side makes progress, so a stalled queue costs no CPU.
+ */
+typedef struct {
+    size_t head;                            // Next slot to pop (written by the consumer)
+    char pad_head[RING_CACHE_LINE - sizeof(size_t)];
+    size_t tail;                            // Next slot to push (written by the producer)
+    char pad_tail[RING_CACHE_LINE - sizeof(size_t)];
+    void **slots;
+    size_t mask;                            // capacity - 1 (capacity is a power of two)
+    pthread_mutex_t lock;                   // Only taken to park or wake a blocked side
+    pthread_cond_t not_empty;
+    pthread_cond_t not_full;
+    int parked_pop;                         // Consumer parked in ring_pop
+    int parked_push;                        // Producer parked in ring_push
+} RingQueue;
+
+/**
+ * @brief Allocates the slots. Capacity is rounded up to a power of two.
+ * @return false if out of memory (or the lock cannot be created)
+ */
+bool ring_init(RingQueue *q, size_t capacity);
+
+void ring_destroy(RingQueue *q);
+
+/** @brief Non-blocking push. @return false if the queue is full */
+bool ring_try_push(RingQueue *q, void *item);
+
+/** @brief Non-blocking pop. @return false if the queue is empty */
+bool ring_try_pop(RingQueue *q, void **item);
+
+/** @brief Blocking push: spins, then sleeps, until there is room. */
+void ring_push(RingQueue *q, void *item);
+
+/** @brief Blocking pop: spins, then sleeps, until an item arrives. */
+void *ring_pop(RingQueue *q);
+
+#endif // RING_QUEUE_H
@@ -3,6 +3,9 @@
 
 #include <stdlib.h> // Needed for pointers/NULL
 
+// Library version; part of every result cache key, so a new version never reuses old results
+#define CALC_LIB_VERSION "2.0"
+
 /**
  * @brief Macro to check if a pointer is NULL.
  * Usage: vector v = malloc(...); Cmalloc(v);
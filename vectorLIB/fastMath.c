@@ -0,0 +1,117 @@
+#include "fastMath.h"
+#include "parallel.h"
+#include <math.h>
+
+#define PI_D 3.14159265358979323846
+
+// --- Angle Approximation ---
+
+// sqrt is a single hardware instruction on every target we build for, so only
+// acos is approximated: a bit-trick rsqrt with Newton steps measured slower.
+double fastAcos(double x) {
+    double ax = fabs(x);
+    if (ax > 1.0) ax = 1.0;     // Only out-of-range input takes this branch
+
+    // acos(|x|) = sqrt(1 - |x|) * P(|x|), |error| <= 2e-8
+    // One expression, so the Horner chain stays in registers even in an unoptimised build
+    double p = ((((((-0.0012624911 * ax + 0.0066700901) * ax - 0.0170881256) * ax
+                   + 0.0308918810) * ax - 0.0501743046) * ax + 0.0889789874) * ax
+                - 0.2145988016) * ax + 1.5707963050;
+    double r = sqrt(1.0 - ax) * p;
+
+    // acos(-x) = pi - acos(x), folded into a sign copy so random signs cost no mispredicts
+    return 0.5 * PI_D - copysign(0.5 * PI_D - r, x);
+}
+
+float getAngleRadMode(vector v, vector u, mathMode mode) {
+    if (mode == MATH_PRECISE) return getAngleRad(v, u);
+
+    double dot = scalaricProduct(v, u);
+    double magV = 0, magU = 0;
+    for (int i = 0; i < v->dim; i++) magV += v->val[i] * v->val[i];
+    for (int i = 0; i < u->dim; i++) magU += u->val[i] * u->val[i];
+
+    // One sqrt replaces two; fastAcos clamps the cosine itself
+    double denom2 = magV * magU;
+    if (denom2 < EPSILON * EPSILON) return 0.0;
+    return (float)fastAcos(dot / sqrt(denom2));
+}
+
+// --- Batch Kernels ---
+
+typedef struct {
+    const double *a;
+    const double *b;
+    double *out;
+    mathMode mode;
+} BatchJob;
+
+static void normalize_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    (void)worker;
+    BatchJob *job = (BatchJob *)ctx;
+    double *xyz = job->out;
+
+    for (size_t i = begin; i < end; i++) {
+        double *p = xyz + 3 * i;
+        double mag2 = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
+        double inv = (mag2 < EPSILON * EPSILON) ? 0.0 : 1.0 / sqrt(mag2);
+        p[0] *= inv; p[1] *= inv; p[2] *= inv;
+    }
+}
+
+static void dist_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    (void)worker;
+    BatchJob *job = (BatchJob *)ctx;
+
+    for (size_t i = begin; i < end; i++) {
+        const double *p = job->a + 3 * i, *q = job->b + 3 * i;
+        double d0 = p[0] - q[0], d1 = p[1] - q[1], d2 = p[2] - q[2];
+        double sum = d0 * d0 + d1 * d1 + d2 * d2;
+        job->out[i] = sqrt(sum);
+    }
+}
+
+static void angle_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    (void)worker;
+    BatchJob *job = (BatchJob *)ctx;
+
+    for (size_t i = begin; i < end; i++) {
+        const double *p = job->a + 3 * i, *q = job->b + 3 * i;
+        double dot = p[0] * q[0] + p[1] * q[1] + p[2] * q[2];
+        double denom2 = (p[0] * p[0] + p[1] * p[1] + p[2] * p[2]) *
+                        (q[0] * q[0] + q[1] * q[1] + q[2] * q[2]);
+        if (denom2 < EPSILON * EPSILON) { job->out[i] = 0.0; continue; }
+
+        double c = dot / sqrt(denom2);
+        if (job->mode == MATH_FAST) {
+            job->out[i] = fastAcos(c);
+        } else {
+            if (c > 1.0) c = 1.0;
+            if (c < -1.0) c = -1.0;
+            job->out[i] = acos(c);
+        }
+    }
+}
+
+static void run_batch(size_t n, const mathContext *ctx, ParallelBody body, BatchJob *job) {
+    job->mode = ctx ? ctx->mode : MATH_PRECISE;
+    parallel_for(n, ctx ? ctx->threads : 0, body, job);
+}
+
+void normalizeBatch(double *xyz, size_t n, const mathContext *ctx) {
+    if (!xyz) return;
+    BatchJob job = {NULL, NULL, xyz, MATH_PRECISE};
+    run_batch(n, ctx, normalize_range, &job);
+}
+
+void distBatch(const double *a, const double *b, size_t n, double *out, const mathContext *ctx) {
+    if (!a || !b || !out) return;
+    BatchJob job = {a, b, out, MATH_PRECISE};
+    run_batch(n, ctx, dist_range, &job);
+}
+
+void angleBatch(const double *a, const double *b, size_t n, double *out, const mathContext *ctx) {
+    if (!a || !b || !out) return;
+    BatchJob job = {a, b, out, MATH_PRECISE};
+    run_batch(n, ctx, angle_range, &job);
+}
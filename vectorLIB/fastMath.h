@@ -0,0 +1,51 @@
+#ifndef FASTMATH_H
+#define FASTMATH_H
+
+#include <stddef.h>
+#include "vectorOps.h"
+
+// --- Precision Selection ---
+
+/**
+ * @brief Precision mode for the angle kernels.
+ * MATH_PRECISE uses libm acos (the behaviour of getAngleRad).
+ * MATH_FAST uses fastAcos (absolute error < 3e-8 rad on [-1, 1]), so angles
+ * stay well inside 1e-6 relative error. Square roots are hardware sqrt in both
+ * modes: normalizeBatch and distBatch only take the context for its thread count.
+ */
+typedef enum { MATH_PRECISE = 0, MATH_FAST = 1 } mathMode;
+
+/**
+ * @brief Per-job settings for the batch kernels.
+ * A NULL context means { MATH_PRECISE, 0 }.
+ */
+typedef struct mathContext {
+    mathMode mode;
+    unsigned int threads;   // 0 = default thread count
+} mathContext;
+
+// --- Angle Approximation ---
+
+/** * @brief Polynomial arc cosine (Abramowitz & Stegun 4.4.46). Input is clamped to [-1, 1].
+ */
+double fastAcos(double x);
+
+/** * @brief getAngleRad, with fastAcos when mode is MATH_FAST.
+ */
+float getAngleRadMode(vector v, vector u, mathMode mode);
+
+// --- Batch Kernels (flat x,y,z arrays, as produced by vectorSetToPoints) ---
+
+/** * @brief Normalises n 3D vectors in place. Near-zero vectors become 0.
+ */
+void normalizeBatch(double *xyz, size_t n, const mathContext *ctx);
+
+/** * @brief out[i] = |a_i - b_i| for n pairs of 3D points.
+ */
+void distBatch(const double *a, const double *b, size_t n, double *out, const mathContext *ctx);
+
+/** * @brief out[i] = angle between a_i and b_i in radians (0 if either is near zero).
+ */
+void angleBatch(const double *a, const double *b, size_t n, double *out, const mathContext *ctx);
+
+#endif // FASTMATH_H
@@ -0,0 +1,390 @@
+#include "halfspace.h"
+#include "parallel.h"
+#include <float.h>
+#include <string.h>
+
+#define LP_VARS 7       // x+ (3), x- (3), t
+#define LP_EPS 1e-12
+#define HULL_EPS 1e-10  // Relative to the coordinate scale
+
+// --- Small Helpers ---
+
+static void sub3(const double a[3], const double b[3], double out[3]) {
+    out[0] = a[0] - b[0]; out[1] = a[1] - b[1]; out[2] = a[2] - b[2];
+}
+
+static double dot3(const double a[3], const double b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+static void cross3(const double a[3], const double b[3], double out[3]) {
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+// --- Chebyshev Centre (dense simplex, Bland's rule) ---
+
+// Maximises t subject to n_i . x + t <= d_i (unit normals), x free.
+// Variables are shifted so the origin is feasible: x = x+ - x-, t = t' - shift.
+// Returns false when the LP is unbounded (the intersection is unbounded).
+static bool chebyshev_centre(const double *n, const double *d, int m, double x[3], double *t_out) {
+    double shift = 0.0;
+    for (int i = 0; i < m; i++) if (-d[i] > shift) shift = -d[i];
+    shift += 1.0;
+
+    int cols = LP_VARS + m + 1; // + slacks + rhs
+    double *T = calloc((size_t)(m + 1) * cols, sizeof(double));
+    int *basis = malloc(sizeof(int) * m);
+    if (!T || !basis) { free(T); free(basis); return false; }
+
+    for (int i = 0; i < m; i++) {
+        double *row = T + (size_t)i * cols;
+        for (int k = 0; k < 3; k++) {
+            row[k] = n[3 * i + k];
+            row[3 + k] = -n[3 * i + k];
+        }
+        row[6] = 1.0;
+        row[LP_VARS + i] = 1.0;
+        row[cols - 1] = d[i] + shift;
+        basis[i] = LP_VARS + i;
+    }
+    double *obj = T + (size_t)m * cols;
+    obj[6] = -1.0; // maximise t'
+
+    bool bounded = true;
+    int max_iter = 50 * (m + LP_VARS);
+    for (int iter = 0; iter < max_iter; iter++) {
+        int enter = -1;
+        for (int j = 0; j < cols - 1; j++) {
+            if (obj[j] < -LP_EPS) { enter = j; break; }
+        }
+        if (enter < 0) break;
+
+        int leave = -1;
+        double best = DBL_MAX;
+        for (int i = 0; i < m; i++) {
+            double a = T[(size_t)i * cols + enter];
+            if (a <= LP_EPS) continue;
+            double ratio = T[(size_t)i * cols + cols - 1] / a;
+            if (ratio < best - LP_EPS || (ratio <= best + LP_EPS && leave >= 0 && basis[i] < basis[leave])) {
+                best = ratio;
+                leave = i;
+            }
+        }
+        if (leave < 0) { bounded = false; break; }
+
+        double *prow = T + (size_t)leave * cols;
+        double piv = prow[enter];
+        for (int j = 0; j < cols; j++) prow[j] /= piv;
+        for (int i = 0; i <= m; i++) {
+            if (i == leave) continue;
+            double *row = T + (size_t)i * cols;
+            double f = row[enter];
+            if (f == 0.0) continue;
+            for (int j = 0; j < cols; j++) row[j] -= f * prow[j];
+        }
+        basis[leave] = enter;
+    }
+
+    if (bounded) {
+        double z[LP_VARS] = {0};
+        for (int i = 0; i < m; i++) {
+            if (basis[i] < LP_VARS) z[basis[i]] = T[(size_t)i * cols + cols - 1];
+        }
+        for (int k = 0; k < 3; k++) x[k] = z[k] - z[3 + k];
+        *t_out = z[6] - shift;
+    }
+
+    free(T);
+    free(basis);
+    return bounded;
+}
+
+// --- 3D Convex Hull (incremental, for small point sets) ---
+
+typedef struct {
+    int v[3];
+    double n[3];    // Outward unit normal
+    double off;     // n . p <= off for points inside
+    bool alive;
+} hullFace;
+
+typedef struct {
+    hullFace *faces;
+    int count;
+    int cap;
+} hullFaces;
+
+static bool set_face(hullFace *f, const double *pts, int a, int b, int c) {
+    double e1[3], e2[3];
+    sub3(pts + 3 * b, pts + 3 * a, e1);
+    sub3(pts + 3 * c, pts + 3 * a, e2);
+    cross3(e1, e2, f->n);
+    double len = sqrt(dot3(f->n, f->n));
+    if (len < DBL_MIN) return false;
+    for (int k = 0; k < 3; k++) f->n[k] /= len;
+    f->v[0] = a; f->v[1] = b; f->v[2] = c;
+    f->off = dot3(f->n, pts + 3 * a);
+    f->alive = true;
+    return true;
+}
+
+static bool add_face(hullFaces *h, const double *pts, int a, int b, int c) {
+    if (h->count == h->cap) {
+        int cap = h->cap ? h->cap * 2 : 32;
+        hullFace *grown = realloc(h->faces, sizeof(hullFace) * cap);
+        if (!grown) return false;
+        h->faces = grown;
+        h->cap = cap;
+    }
+    if (!set_face(&h->faces[h->count], pts, a, b, c)) return true; // Sliver: drop it
+    h->count++;
+    return true;
+}
+
+// Builds the hull of n points; returns false when the points are (nearly) coplanar
+static bool convex_hull(const double *pts, int n, double eps, hullFaces *h) {
+    memset(h, 0, sizeof(*h));
+    if (n < 4) return false;
+
+    // Initial tetrahedron from extreme points
+    int i0 = 0, i1 = -1, i2 = -1, i3 = -1;
+    double best = -1.0, d[3], c[3];
+    for (int i = 1; i < n; i++) {
+        sub3(pts + 3 * i, pts, d);
+        double len = dot3(d, d);
+        if (len > best) { best = len; i1 = i; }
+    }
+    if (best <= eps * eps) return false;
+
+    double e1[3];
+    sub3(pts + 3 * i1, pts, e1);
+    best = -1.0;
+    for (int i = 1; i < n; i++) {
+        sub3(pts + 3 * i, pts, d);
+        cross3(e1, d, c);
+        double area = dot3(c, c);
+        if (area > best) { best = area; i2 = i; }
+    }
+    if (best <= eps * eps * dot3(e1, e1)) return false;
+
+    double e2[3], nrm[3];
+    sub3(pts + 3 * i2, pts, e2);
+    cross3(e1, e2, nrm);
+    double nlen = sqrt(dot3(nrm, nrm));
+    best = 0.0;
+    for (int i = 1; i < n; i++) {
+        sub3(pts + 3 * i, pts, d);
+        double h_dist = fabs(dot3(nrm, d)) / nlen;
+        if (h_dist > best) { best = h_dist; i3 = i; }
+    }
+    if (best <= eps) return false;
+
+    double centre[3];
+    for (int k = 0; k < 3; k++) {
+        centre[k] = (pts[3 * i0 + k] + pts[3 * i1 + k] + pts[3 * i2 + k] + pts[3 * i3 + k]) / 4.0;
+    }
+
+    const int tet[4][3] = {{i0, i1, i2}, {i0, i1, i3}, {i0, i2, i3}, {i1, i2, i3}};
+    for (int f = 0; f < 4; f++) {
+        if (!add_face(h, pts, tet[f][0], tet[f][1], tet[f][2])) return false;
+        hullFace *face = &h->faces[h->count - 1];
+        if (dot3(face->n, centre) > face->off) {
+            set_face(face, pts, tet[f][0], tet[f][2], tet[f][1]);
+        }
+    }
+
+    int *edges = NULL;
+    int edge_cap = 0;
+
+    for (int p = 0; p < n; p++) {
+        if (p == i0 || p == i1 || p == i2 || p == i3) continue;
+        const double *q = pts + 3 * p;
+
+        // Mark visible faces and collect their directed edges
+        int edge_count = 0;
+        for (int f = 0; f < h->count; f++) {
+            hullFace *face = &h->faces[f];
+            if (!face->alive || dot3(face->n, q) - face->off <= eps) continue;
+            face->alive = false;
+            if (edge_count + 3 > edge_cap) {
+                int cap = edge_cap ? edge_cap * 2 : 96;
+                int *grown = realloc(edges, sizeof(int) * 2 * cap);
+                if (!grown) { free(edges); return false; }
+                edges = grown;
+                edge_cap = cap;
+            }
+            for (int k = 0; k < 3; k++) {
+                edges[2 * edge_count] = face->v[k];
+                edges[2 * edge_count + 1] = face->v[(k + 1) % 3];
+                edge_count++;
+            }
+        }
+
+        // Horizon = visible edges whose reverse is not also visible
+        for (int e = 0; e < edge_count; e++) {
+            int a = edges[2 * e], b = edges[2 * e + 1];
+            bool shared = false;
+            for (int o = 0; o < edge_count && !shared; o++) {
+                shared = (edges[2 * o] == b && edges[2 * o + 1] == a);
+            }
+            if (!shared && !add_face(h, pts, a, b, p)) { free(edges); return false; }
+        }
+    }
+
+    free(edges);
+    return true;
+}
+
+// --- Intersection ---
+
+static polytope empty_polytope(polytopeStatus status) {
+    polytope p;
+    memset(&p, 0, sizeof(p));
+    p.status = status;
+    return p;
+}
+
+polytope intersectHalfspaces(plain *planes[], int count) {
+    if (!planes || count < 4) return empty_polytope(planes ? POLY_UNBOUNDED : POLY_ERROR);
+
+    double *n = malloc(sizeof(double) * 3 * count);
+    double *d = malloc(sizeof(double) * count);
+    double *dual = malloc(sizeof(double) * 3 * count);
+    if (!n || !d || !dual) {
+        free(n); free(d); free(dual);
+        return empty_polytope(POLY_ERROR);
+    }
+
+    // Work relative to the mean plane point for better conditioning
+    double origin[3] = {0, 0, 0};
+    int m = 0;
+    for (int i = 0; i < count; i++) {
+        if (!planes[i] || !planes[i]->point || planes[i]->point->dim != 3) continue;
+        for (int k = 0; k < 3; k++) origin[k] += planes[i]->point->val[k];
+        m++;
+    }
+    if (m > 0) for (int k = 0; k < 3; k++) origin[k] /= m;
+
+    m = 0;
+    for (int i = 0; i < count; i++) {
+        plain *pl = planes[i];
+        if (!pl || !pl->normal || !pl->point || pl->normal->dim != 3 || pl->point->dim != 3) continue;
+        double len = sqrt(scalaricProduct(pl->normal, pl->normal));
+        if (len < EPSILON) continue; // Degenerate plane constrains nothing
+        double rel[3];
+        for (int k = 0; k < 3; k++) {
+            n[3 * m + k] = pl->normal->val[k] / len;
+            rel[k] = pl->point->val[k] - origin[k];
+        }
+        d[m] = dot3(n + 3 * m, rel);
+        m++;
+    }
+
+    polytope result = empty_polytope(POLY_OK);
+    double x[3], t = 0.0, scale = 0.0;
+    for (int i = 0; i < m; i++) if (fabs(d[i]) > scale) scale = fabs(d[i]);
+    if (scale < 1.0) scale = 1.0;
+
+    if (m < 4 || !chebyshev_centre(n, d, m, x, &t)) {
+        result.status = POLY_UNBOUNDED;
+    } else if (t <= HULL_EPS * scale) {
+        result.status = POLY_EMPTY;
+    } else {
+        // Dual points n_i / h_i, h_i = distance from the centre to plane i (>= t)
+        double dual_scale = 0.0;
+        for (int i = 0; i < m; i++) {
+            double h = d[i] - dot3(n + 3 * i, x);
+            for (int k = 0; k < 3; k++) dual[3 * i + k] = n[3 * i + k] / h;
+            if (1.0 / h > dual_scale) dual_scale = 1.0 / h;
+        }
+
+        hullFaces dual_hull;
+        if (!convex_hull(dual, m, HULL_EPS * dual_scale, &dual_hull)) {
+            result.status = POLY_UNBOUNDED; // Dual points flat: normals do not span space
+        } else {
+            // Every dual facet a . y = 1 is a primal vertex a (relative to the centre)
+            double *verts = malloc(sizeof(double) * 3 * (dual_hull.count ? dual_hull.count : 1));
+            size_t nv = 0;
+            double merge = HULL_EPS * scale;
+            for (int f = 0; f < dual_hull.count && verts; f++) {
+                hullFace *face = &dual_hull.faces[f];
+                if (!face->alive) continue;
+                if (face->off <= HULL_EPS * dual_scale) { result.status = POLY_UNBOUNDED; break; }
+                double v[3] = {face->n[0] / face->off, face->n[1] / face->off, face->n[2] / face->off};
+
+                // Coplanar dual facets are split into triangles: merge repeated vertices
+                bool dup = false;
+                for (size_t j = 0; j < nv && !dup; j++) {
+                    double diff[3];
+                    sub3(verts + 3 * j, v, diff);
+                    dup = (dot3(diff, diff) <= merge * merge);
+                }
+                if (!dup) { memcpy(verts + 3 * nv, v, sizeof(v)); nv++; }
+            }
+            if (!verts) result.status = POLY_ERROR;
+
+            if (result.status == POLY_OK) {
+                // Volume: fan of tetrahedra from the centre over the primal hull
+                hullFaces primal;
+                double volume = 0.0;
+                if (convex_hull(verts, (int)nv, merge, &primal)) {
+                    for (int f = 0; f < primal.count; f++) {
+                        hullFace *face = &primal.faces[f];
+                        if (!face->alive) continue;
+                        double c[3];
+                        cross3(verts + 3 * face->v[1], verts + 3 * face->v[2], c);
+                        volume += dot3(verts + 3 * face->v[0], c) / 6.0;
+                    }
+                }
+                free(primal.faces);
+
+                for (size_t j = 0; j < nv; j++) {
+                    for (int k = 0; k < 3; k++) verts[3 * j + k] += x[k] + origin[k];
+                }
+                result.vertices = verts;
+                result.vertexCount = nv;
+                result.volume = volume;
+                verts = NULL;
+            }
+            free(verts);
+        }
+        free(dual_hull.faces);
+    }
+
+    if (result.status == POLY_OK || result.status == POLY_EMPTY) {
+        for (int k = 0; k < 3; k++) result.interior[k] = x[k] + origin[k];
+    }
+
+    free(n);
+    free(d);
+    free(dual);
+    return result;
+}
+
+typedef struct {
+    halfspaceProblem *problems;
+} BatchJob;
+
+static void batch_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    (void)worker;
+    BatchJob *job = (BatchJob *)ctx;
+    for (size_t i = begin; i < end; i++) {
+        halfspaceProblem *p = &job->problems[i];
+        p->result = intersectHalfspaces(p->planes, p->count);
+    }
+}
+
+void intersectHalfspacesBatch(halfspaceProblem *problems, size_t count, unsigned int threads) {
+    if (!problems) return;
+    BatchJob job = {problems};
+    parallel_for(count, threads, batch_range, &job);
+}
+
+void freePolytope(polytope *p) {
+    if (!p) return;
+    free(p->vertices);
+    p->vertices = NULL;
+    p->vertexCount = 0;
+}
@@ -0,0 +1,51 @@
+#ifndef HALFSPACE_H
+#define HALFSPACE_H
+
+#include <stddef.h>
+#include "vectorOps.h"
+
+// --- Data Structures ---
+
+typedef enum {
+    POLY_OK = 0,        // Bounded polytope with non-empty interior
+    POLY_EMPTY,         // Intersection is empty or flat (zero volume)
+    POLY_UNBOUNDED,     // Intersection is unbounded
+    POLY_ERROR          // Bad input or out of memory
+} polytopeStatus;
+
+/**
+ * @brief Convex polytope produced by intersectHalfspaces.
+ */
+typedef struct polytope {
+    polytopeStatus status;
+    double *vertices;       // Flat x,y,z array (owned, free with freePolytope)
+    size_t vertexCount;
+    double interior[3];     // Chebyshev centre (deepest interior point)
+    double volume;
+} polytope;
+
+/**
+ * @brief One independent problem for intersectHalfspacesBatch.
+ */
+typedef struct halfspaceProblem {
+    plain **planes;
+    int count;
+    polytope result;        // Filled by the batch call
+} halfspaceProblem;
+
+// --- Intersection ---
+
+/** * @brief Intersects the half-spaces { x : normal . (x - point) <= 0 } of 3D planes.
+ * Each plain keeps the side opposite its normal (as built by getPlain/getPlain3point).
+ * The interior point comes from a small LP (Chebyshev centre); the vertices come
+ * from the convex hull of the dual points normal_i / (d_i - normal_i . interior).
+ */
+polytope intersectHalfspaces(plain *planes[], int count);
+
+/** * @brief Solves many small problems across threads (0 = default thread count).
+ */
+void intersectHalfspacesBatch(halfspaceProblem *problems, size_t count, unsigned int threads);
+
+void freePolytope(polytope *p);
+
+#endif // HALFSPACE_H
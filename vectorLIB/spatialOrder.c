@@ -0,0 +1,301 @@
+#include "spatialOrder.h"
+#include "parallel.h"
+#include <float.h>
+#include <string.h>
+
+#define RADIX 256
+#define MIN_ITEMS_PER_THREAD 16384
+
+// --- Space-Filling Curves ---
+
+// Spreads the low 21 bits of v so that there are two zero bits between each
+static uint64_t spread_bits_3(uint32_t v) {
+    uint64_t x = v & 0x1FFFFF;
+    x = (x | (x << 32)) & 0x001F00000000FFFFULL;
+    x = (x | (x << 16)) & 0x001F0000FF0000FFULL;
+    x = (x | (x << 8))  & 0x100F00F00F00F00FULL;
+    x = (x | (x << 4))  & 0x10C30C30C30C30C3ULL;
+    x = (x | (x << 2))  & 0x1249249249249249ULL;
+    return x;
+}
+
+uint64_t mortonKey3(uint32_t x, uint32_t y, uint32_t z) {
+    return (spread_bits_3(x) << 2) | (spread_bits_3(y) << 1) | spread_bits_3(z);
+}
+
+uint64_t hilbertKey3(uint32_t x, uint32_t y, uint32_t z) {
+    uint32_t X[3] = {x & 0x1FFFFF, y & 0x1FFFFF, z & 0x1FFFFF};
+    uint32_t M = 1u << (CURVE_BITS - 1), P, Q, t;
+
+    // Skilling, "Programming the Hilbert curve" (2004): axes -> transposed index
+    for (Q = M; Q > 1; Q >>= 1) {
+        P = Q - 1;
+        for (int i = 0; i < 3; i++) {
+            if (X[i] & Q) {
+                X[0] ^= P;
+            } else {
+                t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    t = 0;
+    for (Q = M; Q > 1; Q >>= 1) {
+        if (X[2] & Q) t ^= Q - 1;
+    }
+    for (int i = 0; i < 3; i++) X[i] ^= t;
+
+    // The transposed form interleaves exactly like a Morton key
+    return mortonKey3(X[0], X[1], X[2]);
+}
+
+typedef struct {
+    const double *xyz;
+    double (*lo)[3];
+    double (*hi)[3];
+    double origin[3];
+    double scale;
+    curveType curve;
+    uint64_t *keys;
+} KeyJob;
+
+static void bounds_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    KeyJob *job = (KeyJob *)ctx;
+    double lo[3] = {DBL_MAX, DBL_MAX, DBL_MAX};
+    double hi[3] = {-DBL_MAX, -DBL_MAX, -DBL_MAX};
+
+    for (size_t i = begin; i < end; i++) {
+        const double *p = job->xyz + 3 * i;
+        for (int k = 0; k < 3; k++) {
+            if (p[k] < lo[k]) lo[k] = p[k];
+            if (p[k] > hi[k]) hi[k] = p[k];
+        }
+    }
+    memcpy(job->lo[worker], lo, sizeof(lo));
+    memcpy(job->hi[worker], hi, sizeof(hi));
+}
+
+static void keys_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    (void)worker;
+    KeyJob *job = (KeyJob *)ctx;
+    const double cell_max = (double)((1u << CURVE_BITS) - 1);
+
+    for (size_t i = begin; i < end; i++) {
+        const double *p = job->xyz + 3 * i;
+        uint32_t c[3];
+        for (int k = 0; k < 3; k++) {
+            double q = (p[k] - job->origin[k]) * job->scale;
+            if (!(q > 0.0)) q = 0.0; // Also catches NaN
+            if (q > cell_max) q = cell_max;
+            c[k] = (uint32_t)q;
+        }
+        job->keys[i] = (job->curve == CURVE_HILBERT) ? hilbertKey3(c[0], c[1], c[2])
+                                                     : mortonKey3(c[0], c[1], c[2]);
+    }
+}
+
+bool computeCurveKeys(const double *xyz, size_t n, curveType curve, uint64_t *keys, unsigned int threads) {
+    if (!xyz || !keys) return false;
+    if (n == 0) return true;
+
+    threads = parallel_resolve_threads(threads);
+    if (threads > n) threads = (unsigned int)n;
+
+    KeyJob job;
+    memset(&job, 0, sizeof(job));
+    job.xyz = xyz;
+    job.curve = curve;
+    job.keys = keys;
+    job.lo = malloc(sizeof(double[3]) * threads);
+    job.hi = malloc(sizeof(double[3]) * threads);
+    if (!job.lo || !job.hi) {
+        free(job.lo); free(job.hi);
+        return false;
+    }
+    for (unsigned int w = 0; w < threads; w++) {
+        for (int k = 0; k < 3; k++) { job.lo[w][k] = DBL_MAX; job.hi[w][k] = -DBL_MAX; }
+    }
+
+    parallel_for(n, threads, bounds_range, &job);
+
+    // Uniform scale over the largest extent keeps cells cubic
+    double extent = 0.0;
+    for (int k = 0; k < 3; k++) {
+        double lo = DBL_MAX, hi = -DBL_MAX;
+        for (unsigned int w = 0; w < threads; w++) {
+            if (job.lo[w][k] < lo) lo = job.lo[w][k];
+            if (job.hi[w][k] > hi) hi = job.hi[w][k];
+        }
+        job.origin[k] = lo;
+        if (hi - lo > extent) extent = hi - lo;
+    }
+    free(job.lo);
+    free(job.hi);
+
+    job.scale = (extent > 0.0) ? (double)((1u << CURVE_BITS) - 1) / extent : 0.0;
+    parallel_for(n, threads, keys_range, &job);
+    return true;
+}
+
+// --- Sorting & Reordering ---
+
+typedef struct {
+    const uint64_t *src_keys;
+    const size_t *src_perm;
+    uint64_t *dst_keys;
+    size_t *dst_perm;
+    size_t (*count)[RADIX];     // Per worker: histogram, then scatter offsets
+    unsigned int shift;
+} RadixJob;
+
+static void histogram_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    RadixJob *job = (RadixJob *)ctx;
+    size_t *count = job->count[worker];
+    memset(count, 0, sizeof(size_t) * RADIX);
+    for (size_t i = begin; i < end; i++) {
+        count[(job->src_keys[i] >> job->shift) & (RADIX - 1)]++;
+    }
+}
+
+static void scatter_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    RadixJob *job = (RadixJob *)ctx;
+    size_t *offset = job->count[worker];
+    for (size_t i = begin; i < end; i++) {
+        size_t dst = offset[(job->src_keys[i] >> job->shift) & (RADIX - 1)]++;
+        job->dst_keys[dst] = job->src_keys[i];
+        if (job->dst_perm) job->dst_perm[dst] = job->src_perm[i];
+    }
+}
+
+bool radixSortKeys(uint64_t *keys, size_t *perm, size_t n, unsigned int threads) {
+    if (!keys) return false;
+    if (n < 2) return true;
+
+    threads = parallel_resolve_threads(threads);
+    size_t useful = n / MIN_ITEMS_PER_THREAD;
+    if (useful < 1) useful = 1;
+    if (threads > useful) threads = (unsigned int)useful;
+
+    uint64_t *tmp_keys = malloc(sizeof(uint64_t) * n);
+    size_t *tmp_perm = perm ? malloc(sizeof(size_t) * n) : NULL;
+    size_t (*count)[RADIX] = malloc(sizeof(size_t[RADIX]) * threads);
+    if (!tmp_keys || (perm && !tmp_perm) || !count) {
+        free(tmp_keys); free(tmp_perm); free(count);
+        return false;
+    }
+
+    RadixJob job = {keys, perm, tmp_keys, tmp_perm, count, 0};
+
+    for (unsigned int shift = 0; shift < 64; shift += 8) {
+        job.shift = shift;
+        parallel_for(n, threads, histogram_range, &job);
+
+        // Skip the pass when every key lands in one bucket
+        bool trivial = false;
+        for (unsigned int b = 0; b < RADIX && !trivial; b++) {
+            size_t total = 0;
+            for (unsigned int w = 0; w < threads; w++) total += count[w][b];
+            if (total == n) trivial = true;
+        }
+        if (trivial) continue;
+
+        // Bucket-major, worker-minor offsets keep the sort stable
+        size_t running = 0;
+        for (unsigned int b = 0; b < RADIX; b++) {
+            for (unsigned int w = 0; w < threads; w++) {
+                size_t c = count[w][b];
+                count[w][b] = running;
+                running += c;
+            }
+        }
+        parallel_for(n, threads, scatter_range, &job);
+
+        // Swap source and destination
+        uint64_t *k = (uint64_t *)job.src_keys;
+        size_t *p = (size_t *)job.src_perm;
+        job.src_keys = job.dst_keys;
+        job.src_perm = job.dst_perm;
+        job.dst_keys = k;
+        job.dst_perm = p;
+    }
+
+    if (job.src_keys != keys) {
+        memcpy(keys, job.src_keys, sizeof(uint64_t) * n);
+        if (perm) memcpy(perm, job.src_perm, sizeof(size_t) * n);
+    }
+
+    free(tmp_keys);
+    free(tmp_perm);
+    free(count);
+    return true;
+}
+
+size_t *spatialOrder(const double *xyz, size_t n, curveType curve, unsigned int threads) {
+    if (!xyz) return NULL;
+
+    size_t *perm = malloc(sizeof(size_t) * (n ? n : 1));
+    uint64_t *keys = malloc(sizeof(uint64_t) * (n ? n : 1));
+    if (!perm || !keys) {
+        free(perm); free(keys);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < n; i++) perm[i] = i;
+    bool ok = computeCurveKeys(xyz, n, curve, keys, threads) && radixSortKeys(keys, perm, n, threads);
+
+    free(keys);
+    if (!ok) {
+        free(perm);
+        return NULL;
+    }
+    return perm;
+}
+
+bool applyPermutation(double *xyz, size_t n, const size_t *perm) {
+    if (!xyz || !perm) return false;
+    if (n == 0) return true;
+
+    double *tmp = malloc(sizeof(double) * 3 * n);
+    if (!tmp) return false;
+
+    for (size_t i = 0; i < n; i++) {
+        memcpy(tmp + 3 * i, xyz + 3 * perm[i], sizeof(double) * 3);
+    }
+    memcpy(xyz, tmp, sizeof(double) * 3 * n);
+    free(tmp);
+    return true;
+}
+
+void sortVectorSetSpatial(vectorSet set, curveType curve, unsigned int threads) {
+    if (!set || set->count < 2) return;
+
+    // Flatten once, remembering the node of every point
+    size_t n = 0;
+    vector *nodes = malloc(sizeof(vector) * set->count);
+    double *xyz = malloc(sizeof(double) * 3 * set->count);
+    if (!nodes || !xyz) {
+        free(nodes); free(xyz);
+        return;
+    }
+
+    for (vector v = set->head; v && n < set->count; v = v->next, n++) {
+        nodes[n] = v;
+        for (unsigned int k = 0; k < 3; k++) xyz[3 * n + k] = (k < v->dim) ? v->val[k] : 0.0;
+    }
+
+    size_t *perm = (n > 1) ? spatialOrder(xyz, n, curve, threads) : NULL;
+    if (perm) {
+        for (size_t i = 0; i + 1 < n; i++) nodes[perm[i]]->next = nodes[perm[i + 1]];
+        nodes[perm[n - 1]]->next = NULL;
+        set->head = nodes[perm[0]];
+        free(perm);
+    }
+
+    free(nodes);
+    free(xyz);
+}
@@ -0,0 +1,53 @@
+#ifndef SPATIALORDER_H
+#define SPATIALORDER_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "vectorOps.h"
+
+// --- Space-Filling Curves ---
+
+#define CURVE_BITS 21   // Bits per axis; 3 * 21 = 63-bit keys
+
+typedef enum { CURVE_MORTON = 0, CURVE_HILBERT = 1 } curveType;
+
+/** * @brief Z-order key: bits of x, y, z interleaved (x highest). Inputs use the low 21 bits.
+ */
+uint64_t mortonKey3(uint32_t x, uint32_t y, uint32_t z);
+
+/** * @brief Hilbert curve index of a cell on the 2^21 grid (Skilling's transform).
+ */
+uint64_t hilbertKey3(uint32_t x, uint32_t y, uint32_t z);
+
+/** * @brief Quantises n points (flat x,y,z) onto the 2^21 grid over their bounding
+ * box (uniform scale) and writes one curve key per point.
+ * @return false if the scratch buffers could not be allocated (keys are not written)
+ */
+bool computeCurveKeys(const double *xyz, size_t n, curveType curve, uint64_t *keys, unsigned int threads);
+
+// --- Sorting & Reordering ---
+
+/** * @brief Stable parallel LSD radix sort of keys (8 bits per pass), carrying 'perm' along.
+ * Passes where every key has the same byte are skipped. 'perm' may be NULL.
+ * @return false if the scratch buffers could not be allocated (keys and perm unchanged)
+ */
+bool radixSortKeys(uint64_t *keys, size_t *perm, size_t n, unsigned int threads);
+
+/** * @brief Curve order of a point batch.
+ * @return perm (caller frees) where perm[i] is the source index of the i-th point
+ * along the curve, or NULL on failure.
+ */
+size_t *spatialOrder(const double *xyz, size_t n, curveType curve, unsigned int threads);
+
+/** * @brief Reorders a flat x,y,z batch so that point i becomes old point perm[i].
+ * @return false if the temporary buffer could not be allocated.
+ */
+bool applyPermutation(double *xyz, size_t n, const size_t *perm);
+
+/** * @brief Relinks the nodes of a set along the curve (no vector data is copied).
+ * Useful after csv_read_vector_set, whose addToSet order is the reverse of the file.
+ */
+void sortVectorSetSpatial(vectorSet set, curveType curve, unsigned int threads);
+
+#endif // SPATIALORDER_H
@@ -1,4 +1,5 @@
 #include "vectorOps.h"
+#include "reduce.h"
 
 // --- Constructors & Destructors ---
 
@@ -179,6 +180,36 @@ double volumeParallelepiped(vector vectors[], double k) {
     return fabs(vol) / (k > EPSILON ? k : 1.0);
 }
 
+// --- Batch Totals ---
+
+typedef struct {
+    vector *a;
+    vector *b;
+    double k;
+} BatchTerms;
+
+static double volume_term(size_t i, void *ctx) {
+    BatchTerms *t = (BatchTerms *)ctx;
+    return volumeParallelepiped(t->a + 3 * i, t->k);
+}
+
+static double product_term(size_t i, void *ctx) {
+    BatchTerms *t = (BatchTerms *)ctx;
+    return scalaricProduct(t->a[i], t->b[i]);
+}
+
+double totalVolumeParallelepiped(vector vectors[], size_t n, double k, unsigned int threads) {
+    if (!vectors) return 0.0;
+    BatchTerms t = {vectors, NULL, k};
+    return reproducible_reduce(n, volume_term, &t, threads);
+}
+
+double totalScalaricProduct(vector v1[], vector v2[], size_t n, unsigned int threads) {
+    if (!v1 || !v2) return 0.0;
+    BatchTerms t = {v1, v2, 0.0};
+    return reproducible_reduce(n, product_term, &t, threads);
+}
+
 // --- Geometry: Lines ---
 
 line_equation *getLine(vector V, vector p) {
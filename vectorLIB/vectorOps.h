@@ -5,6 +5,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #define EPSILON 1e-6
 #define PI 3.1415
@@ -96,6 +97,18 @@ double volumeParallelepiped(vector vectors[], double k);
  */
 double determinant(vector *matrix, int n);
 
+// --- Batch Totals (bitwise identical at any thread count, see reduce.h) ---
+
+/** * @brief Sum of volumeParallelepiped over n triples.
+ * @param vectors 3*n vectors: triple i is vectors[3i], vectors[3i+1], vectors[3i+2].
+ * @param threads 0 = default thread count.
+ */
+double totalVolumeParallelepiped(vector vectors[], size_t n, double k, unsigned int threads);
+
+/** * @brief Sum of scalaricProduct(v1[i], v2[i]) over n pairs.
+ */
+double totalScalaricProduct(vector v1[], vector v2[], size_t n, unsigned int threads);
+
 // --- Geometry Generation (Lines) ---
 
 line_equation *getLine(vector V, vector p);
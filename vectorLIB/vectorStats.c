@@ -0,0 +1,325 @@
+#include "vectorStats.h"
+#include "parallel.h"
+#include <float.h>
+#include <string.h>
+
+#define TWO_THIRDS_PI 2.0943951023931954923
+
+// --- Accumulator ---
+
+void initVecStats(vecStats *s) {
+    if (!s) return;
+    memset(s, 0, sizeof(*s));
+    for (int i = 0; i < 3; i++) {
+        s->min[i] = DBL_MAX;
+        s->max[i] = -DBL_MAX;
+    }
+}
+
+void pushVecStats(vecStats *s, const double p[3]) {
+    double d[3];
+    s->count++;
+    double n = (double)s->count;
+
+    for (int i = 0; i < 3; i++) {
+        d[i] = p[i] - s->mean[i];
+        s->mean[i] += d[i] / n;
+        if (p[i] < s->min[i]) s->min[i] = p[i];
+        if (p[i] > s->max[i]) s->max[i] = p[i];
+    }
+
+    // M2 += (n-1)/n * d d^T  (same as (p - old_mean)(p - new_mean)^T, but symmetric)
+    double w = (n - 1.0) / n;
+    for (int i = 0; i < 3; i++)
+        for (int j = i; j < 3; j++)
+            s->m2[i][j] += w * d[i] * d[j];
+    s->m2[1][0] = s->m2[0][1];
+    s->m2[2][0] = s->m2[0][2];
+    s->m2[2][1] = s->m2[1][2];
+}
+
+void mergeVecStats(vecStats *dst, const vecStats *src) {
+    if (!dst || !src || src->count == 0) return;
+    if (dst->count == 0) {
+        *dst = *src;
+        return;
+    }
+
+    double na = (double)dst->count, nb = (double)src->count;
+    double n = na + nb;
+    double d[3];
+
+    for (int i = 0; i < 3; i++) {
+        d[i] = src->mean[i] - dst->mean[i];
+        dst->mean[i] += d[i] * nb / n;
+        if (src->min[i] < dst->min[i]) dst->min[i] = src->min[i];
+        if (src->max[i] > dst->max[i]) dst->max[i] = src->max[i];
+    }
+
+    double w = na * nb / n;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            dst->m2[i][j] += src->m2[i][j] + w * d[i] * d[j];
+
+    dst->count += src->count;
+}
+
+void getCovariance(const vecStats *s, double cov[3][3]) {
+    double div = (s && s->count > 1) ? (double)(s->count - 1) : 0.0;
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            cov[i][j] = (div > 0.0) ? s->m2[i][j] / div : 0.0;
+}
+
+// --- Eigen Decomposition ---
+
+static void cross3(const double a[3], const double b[3], double out[3]) {
+    out[0] = a[1] * b[2] - a[2] * b[1];
+    out[1] = a[2] * b[0] - a[0] * b[2];
+    out[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static double norm3(const double a[3]) {
+    return sqrt(a[0] * a[0] + a[1] * a[1] + a[2] * a[2]);
+}
+
+static void scale3(double a[3], double k) {
+    a[0] *= k; a[1] *= k; a[2] *= k;
+}
+
+// Any unit vector orthogonal to unit vector 'a'
+static void any_orthogonal(const double a[3], double out[3]) {
+    double helper[3] = {0.0, 0.0, 0.0};
+    // Pick the axis least aligned with 'a'
+    int k = 0;
+    if (fabs(a[1]) < fabs(a[k])) k = 1;
+    if (fabs(a[2]) < fabs(a[k])) k = 2;
+    helper[k] = 1.0;
+    cross3(a, helper, out);
+    scale3(out, 1.0 / norm3(out));
+}
+
+// Unit eigenvector of a simple eigenvalue: largest cross product of two rows of (A - l*I)
+static void eigenvector_of(double A[3][3], double l, double out[3]) {
+    double r[3][3], c[3];
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            r[i][j] = A[i][j] - (i == j ? l : 0.0);
+
+    double best = -1.0;
+    const int pairs[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+    for (int k = 0; k < 3; k++) {
+        cross3(r[pairs[k][0]], r[pairs[k][1]], c);
+        double n = norm3(c);
+        if (n > best) {
+            best = n;
+            memcpy(out, c, sizeof(c));
+        }
+    }
+
+    if (best > 0.0) scale3(out, 1.0 / best);
+    else { out[0] = 1.0; out[1] = 0.0; out[2] = 0.0; }
+}
+
+void eigenSym3(double A[3][3], double eval[3], double evec[3][3]) {
+    double p1 = A[0][1] * A[0][1] + A[0][2] * A[0][2] + A[1][2] * A[1][2];
+    double q = (A[0][0] + A[1][1] + A[2][2]) / 3.0;
+    double d0 = A[0][0] - q, d1 = A[1][1] - q, d2 = A[2][2] - q;
+    double p2 = d0 * d0 + d1 * d1 + d2 * d2 + 2.0 * p1;
+    double p = sqrt(p2 / 6.0);
+
+    if (p < DBL_MIN) {
+        // Multiple of the identity: every direction is an eigenvector
+        memset(evec, 0, sizeof(double) * 9);
+        for (int i = 0; i < 3; i++) {
+            eval[i] = A[i][i];
+            evec[i][i] = 1.0;
+        }
+        return;
+    }
+
+    // Trigonometric solution of the characteristic cubic (B = (A - qI) / p)
+    double B[3][3];
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            B[i][j] = (A[i][j] - (i == j ? q : 0.0)) / p;
+
+    double r = (B[0][0] * (B[1][1] * B[2][2] - B[1][2] * B[2][1]) -
+                B[0][1] * (B[1][0] * B[2][2] - B[1][2] * B[2][0]) +
+                B[0][2] * (B[1][0] * B[2][1] - B[1][1] * B[2][0])) / 2.0;
+    if (r > 1.0) r = 1.0;
+    if (r < -1.0) r = -1.0;
+
+    double phi = acos(r) / 3.0;
+    eval[0] = q + 2.0 * p * cos(phi);
+    eval[2] = q + 2.0 * p * cos(phi + TWO_THIRDS_PI);
+    eval[1] = 3.0 * q - eval[0] - eval[2];
+
+    // Eigenvalues closer than this (relative to the spread) are treated as repeated
+    double tol = 1e-9 * p;
+
+    if (eval[0] - eval[1] > tol) {
+        eigenvector_of(A, eval[0], evec[0]);
+        if (eval[1] - eval[2] > tol) {
+            eigenvector_of(A, eval[2], evec[2]);
+            // Re-orthogonalise against evec[0] to absorb rounding
+            double dot = evec[2][0] * evec[0][0] + evec[2][1] * evec[0][1] + evec[2][2] * evec[0][2];
+            for (int i = 0; i < 3; i++) evec[2][i] -= dot * evec[0][i];
+            scale3(evec[2], 1.0 / norm3(evec[2]));
+        } else {
+            any_orthogonal(evec[0], evec[2]);
+        }
+        cross3(evec[2], evec[0], evec[1]);
+    } else {
+        // eval[0] == eval[1]: only the smallest eigenvalue has a unique direction
+        eigenvector_of(A, eval[2], evec[2]);
+        any_orthogonal(evec[2], evec[0]);
+        cross3(evec[2], evec[0], evec[1]);
+    }
+}
+
+void getPrincipalAxes(const vecStats *s, double variance[3], double axes[3][3]) {
+    double cov[3][3];
+    getCovariance(s, cov);
+    eigenSym3(cov, variance, axes);
+}
+
+// --- Batch Helpers ---
+
+double *vectorSetToPoints(vectorSet set, size_t *n_out) {
+    if (n_out) *n_out = 0;
+    if (!set) return NULL;
+
+    double *xyz = (double *)malloc(sizeof(double) * 3 * (set->count ? set->count : 1));
+    if (!xyz) return NULL;
+
+    size_t n = 0;
+    for (vector v = set->head; v && n < set->count; v = v->next, n++) {
+        for (unsigned int i = 0; i < 3; i++) {
+            xyz[3 * n + i] = (i < v->dim) ? v->val[i] : 0.0;
+        }
+    }
+
+    if (n_out) *n_out = n;
+    return xyz;
+}
+
+typedef struct {
+    const double *xyz;
+    vecStats *partial;
+} StatsJob;
+
+static void stats_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    StatsJob *job = (StatsJob *)ctx;
+    vecStats local;
+    initVecStats(&local);
+    for (size_t i = begin; i < end; i++) pushVecStats(&local, job->xyz + 3 * i);
+    job->partial[worker] = local;
+}
+
+vecStats statsPoints(const double *xyz, size_t n, unsigned int threads) {
+    vecStats total;
+    initVecStats(&total);
+    if (!xyz || n == 0) return total;
+
+    threads = parallel_resolve_threads(threads);
+    if (threads > n) threads = (unsigned int)n;
+
+    vecStats *partial = (vecStats *)malloc(sizeof(vecStats) * threads);
+    if (!partial) {
+        for (size_t i = 0; i < n; i++) pushVecStats(&total, xyz + 3 * i);
+        return total;
+    }
+    for (unsigned int w = 0; w < threads; w++) initVecStats(&partial[w]);
+
+    StatsJob job = {xyz, partial};
+    parallel_for(n, threads, stats_range, &job);
+
+    // Merge in worker order so the result does not depend on scheduling
+    for (unsigned int w = 0; w < threads; w++) mergeVecStats(&total, &partial[w]);
+    free(partial);
+    return total;
+}
+
+vecStats statsVectorSet(vectorSet set, unsigned int threads) {
+    size_t n = 0;
+    double *xyz = vectorSetToPoints(set, &n);
+    vecStats s = statsPoints(xyz, n, threads);
+    free(xyz);
+    return s;
+}
+
+typedef struct {
+    const double *xyz;
+    const double *origin;
+    double (*axes)[3];
+    double (*lo)[3];
+    double (*hi)[3];
+} BoxJob;
+
+static void box_range(size_t begin, size_t end, unsigned int worker, void *ctx) {
+    BoxJob *job = (BoxJob *)ctx;
+    double lo[3] = {DBL_MAX, DBL_MAX, DBL_MAX};
+    double hi[3] = {-DBL_MAX, -DBL_MAX, -DBL_MAX};
+
+    for (size_t i = begin; i < end; i++) {
+        const double *p = job->xyz + 3 * i;
+        double d[3] = {p[0] - job->origin[0], p[1] - job->origin[1], p[2] - job->origin[2]};
+        for (int k = 0; k < 3; k++) {
+            double t = d[0] * job->axes[k][0] + d[1] * job->axes[k][1] + d[2] * job->axes[k][2];
+            if (t < lo[k]) lo[k] = t;
+            if (t > hi[k]) hi[k] = t;
+        }
+    }
+
+    memcpy(job->lo[worker], lo, sizeof(lo));
+    memcpy(job->hi[worker], hi, sizeof(hi));
+}
+
+orientedBox getOrientedBox(const double *xyz, size_t n, const vecStats *s, unsigned int threads) {
+    orientedBox box;
+    memset(&box, 0, sizeof(box));
+    if (!s) return box;
+
+    double variance[3];
+    getPrincipalAxes(s, variance, box.axes);
+    memcpy(box.center, s->mean, sizeof(box.center));
+    if (!xyz || n == 0) return box;
+
+    threads = parallel_resolve_threads(threads);
+    if (threads > n) threads = (unsigned int)n;
+
+    double (*lo)[3] = malloc(sizeof(double[3]) * threads);
+    double (*hi)[3] = malloc(sizeof(double[3]) * threads);
+    if (!lo || !hi) {
+        free(lo); free(hi);
+        threads = 1;
+        lo = malloc(sizeof(double[3]));
+        hi = malloc(sizeof(double[3]));
+        if (!lo || !hi) { free(lo); free(hi); return box; }
+    }
+    for (unsigned int w = 0; w < threads; w++) {
+        for (int k = 0; k < 3; k++) { lo[w][k] = DBL_MAX; hi[w][k] = -DBL_MAX; }
+    }
+
+    BoxJob job = {xyz, s->mean, box.axes, lo, hi};
+    parallel_for(n, threads, box_range, &job);
+
+    double mn[3] = {DBL_MAX, DBL_MAX, DBL_MAX};
+    double mx[3] = {-DBL_MAX, -DBL_MAX, -DBL_MAX};
+    for (unsigned int w = 0; w < threads; w++) {
+        for (int k = 0; k < 3; k++) {
+            if (lo[w][k] < mn[k]) mn[k] = lo[w][k];
+            if (hi[w][k] > mx[k]) mx[k] = hi[w][k];
+        }
+    }
+    free(lo);
+    free(hi);
+
+    for (int k = 0; k < 3; k++) {
+        double mid = 0.5 * (mn[k] + mx[k]);
+        box.halfExtent[k] = 0.5 * (mx[k] - mn[k]);
+        for (int i = 0; i < 3; i++) box.center[i] += mid * box.axes[k][i];
+    }
+    return box;
+}
@@ -0,0 +1,77 @@
+#ifndef VECTORSTATS_H
+#define VECTORSTATS_H
+
+#include <stddef.h>
+#include "vectorOps.h"
+
+// --- Data Structures ---
+
+/**
+ * @brief Single-pass (Welford) statistics over 3D points.
+ * Accumulators can be filled independently (e.g. one per thread) and merged.
+ */
+typedef struct vecStats {
+    unsigned long count;
+    double mean[3];
+    double m2[3][3];    // Co-moment sums: sum of (p - mean)(p - mean)^T
+    double min[3];      // Axis-aligned bounding box
+    double max[3];
+} vecStats;
+
+/**
+ * @brief Oriented bounding box aligned with the principal axes.
+ */
+typedef struct orientedBox {
+    double center[3];
+    double axes[3][3];      // axes[k] is a unit vector, sorted by descending variance
+    double halfExtent[3];   // Half size along axes[k]
+} orientedBox;
+
+// --- Accumulator ---
+
+void initVecStats(vecStats *s);
+
+/** * @brief Adds one point (x, y, z) to the accumulator.
+ */
+void pushVecStats(vecStats *s, const double p[3]);
+
+/** * @brief Merges 'src' into 'dst' (Chan et al. pairwise update).
+ */
+void mergeVecStats(vecStats *dst, const vecStats *src);
+
+/** * @brief Sample covariance (divides by n - 1). Zero matrix if count < 2.
+ */
+void getCovariance(const vecStats *s, double cov[3][3]);
+
+// --- Eigen Decomposition ---
+
+/** * @brief Closed-form eigen decomposition of a symmetric 3x3 matrix.
+ * @param eval Eigenvalues, descending.
+ * @param evec evec[k] is the unit eigenvector of eval[k]; rows form a right-handed basis.
+ */
+void eigenSym3(double A[3][3], double eval[3], double evec[3][3]);
+
+/** * @brief Principal axes of the accumulated points (eigenvectors of the covariance).
+ */
+void getPrincipalAxes(const vecStats *s, double variance[3], double axes[3][3]);
+
+// --- Batch Helpers ---
+
+/** * @brief Copies the first 3 components of every vector in the set into a flat
+ * x,y,z array (in list order). Caller frees. Missing components are 0.
+ */
+double *vectorSetToPoints(vectorSet set, size_t *n_out);
+
+/** * @brief Statistics over a flat x,y,z array, one accumulator per thread.
+ * @param threads 0 = default thread count.
+ */
+vecStats statsPoints(const double *xyz, size_t n, unsigned int threads);
+
+vecStats statsVectorSet(vectorSet set, unsigned int threads);
+
+/** * @brief Oriented bounding box of a flat x,y,z array.
+ * @param s Statistics of the same points (from statsPoints).
+ */
+orientedBox getOrientedBox(const double *xyz, size_t n, const vecStats *s, unsigned int threads);
+
+#endif // VECTORSTATS_H